@@ -45,6 +45,18 @@ inline void battery_disable(void)
     adc_disable();
 }
 
+/**
+ * @brief Read the battery voltage.
+ *
+ * @return ADC result of the battery channel.
+ *
+ * @note The battery measurement must be initialized with `battery_init()`.
+ */
+unsigned int battery_value(void)
+{
+    return adc_read();
+}
+
 /**
  * @brief Check the current battery status.
  *
@@ -55,7 +67,7 @@ inline void battery_disable(void)
  */
 BATTERY_Status battery_status(void)
 {
-    if(adc_read() < BATTERY_EMPTY_VALUE)
+    if(battery_value() < BATTERY_EMPTY_VALUE)
     {
         return BATTERY_Fault;
     }
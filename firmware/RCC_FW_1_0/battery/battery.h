@@ -73,6 +73,7 @@
 
     void battery_init(void);
     void battery_disable(void);
+    unsigned int battery_value(void);
     BATTERY_Status battery_status(void);
 
 #endif /* BATTERY_H_ */
\ No newline at end of file
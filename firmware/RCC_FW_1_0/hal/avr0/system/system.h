@@ -94,6 +94,29 @@
     #define SYSTEM_PER_CLOCK_PRESCALER CLKCTRL_PDIV_2X_gc
 #endif
 
+#ifndef SYSTEM_PER_CLOCK
+    /**
+     * @def SYSTEM_PER_CLOCK
+     * @brief Peripheral clock (`CLK_PER`) in Hertz that results from `F_CPU` and `SYSTEM_PER_CLOCK_PRESCALER`.
+     *
+     * @details
+     * The CPU is clocked with `CLK_PER` as well, so the busy-wait delays of `<util/delay.h>` (calculated for `F_CPU`) take `F_CPU / SYSTEM_PER_CLOCK` times their nominal time.
+     *
+     * @note The prescaler values are enumerators of the device header, the macro is a constant expression that can not be used in `#if`.
+     */
+    #define SYSTEM_PER_CLOCK (F_CPU / ( \
+        (SYSTEM_PER_CLOCK_PRESCALER == CLKCTRL_PDIV_2X_gc)  ? 2UL  : \
+        (SYSTEM_PER_CLOCK_PRESCALER == CLKCTRL_PDIV_4X_gc)  ? 4UL  : \
+        (SYSTEM_PER_CLOCK_PRESCALER == CLKCTRL_PDIV_8X_gc)  ? 8UL  : \
+        (SYSTEM_PER_CLOCK_PRESCALER == CLKCTRL_PDIV_16X_gc) ? 16UL : \
+        (SYSTEM_PER_CLOCK_PRESCALER == CLKCTRL_PDIV_32X_gc) ? 32UL : \
+        (SYSTEM_PER_CLOCK_PRESCALER == CLKCTRL_PDIV_64X_gc) ? 64UL : \
+        (SYSTEM_PER_CLOCK_PRESCALER == CLKCTRL_PDIV_6X_gc)  ? 6UL  : \
+        (SYSTEM_PER_CLOCK_PRESCALER == CLKCTRL_PDIV_10X_gc) ? 10UL : \
+        (SYSTEM_PER_CLOCK_PRESCALER == CLKCTRL_PDIV_12X_gc) ? 12UL : \
+        (SYSTEM_PER_CLOCK_PRESCALER == CLKCTRL_PDIV_24X_gc) ? 24UL : 48UL))
+#endif
+
 #include <avr/io.h>
 
 void system_init(void);
@@ -0,0 +1,135 @@
+/**
+ * @file adc.c
+ * @brief Host implementation of the ADC driver.
+ *
+ * This file implements the functions declared in `hal/avr0/adc/adc.h` on top of the virtual `ADC0` register block. Conversion results are taken from the analog inputs of the host environment (`host->analog`), selected by `ADC0.MUXPOS`, and the conversion time is accounted on the virtual clock.
+ *
+ * @author g.raf
+ * @date 2026-10-17
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger embedded systems project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/rcc "RCC - RGB LED Color Cube"
+ */
+
+#include "../../avr0/adc/adc.h"
+#include "../host.h"
+
+/**
+ * @brief Initialize the virtual ADC with pre-configured settings.
+ *
+ * @details
+ * Writes the same register configuration as the AVR0 implementation.
+ */
+void adc_init(void)
+{
+    ADC0.CTRLC = (ADC_CAPACITANCE<<ADC_SAMPCAP_bp) | ADC_REFERENCE | ADC_PRESCALER;
+    ADC0.CTRLD = ADC_SAMPLE_DELAY_VARIATION | ADC_INITDLY_DLY0_gc | (ADC_SAMPLE_DELAY<<ADC_SAMPDLY_gp);
+    ADC0.SAMPCTRL = ADC_SAMPLE_LENGTH;
+    ADC0.CTRLA = ADC_RESOLUTION | ADC_ENABLE_bm;
+
+    #ifdef ADC_ADIE
+        ADC0.INTCTRL = ADC_RESRDY_bm;
+    #endif
+
+    #if ADC_REFERENCE == ADC_REFSEL_INTREF_gc
+        VREF.CTRLA = VREF_REFSEL | (VREF.CTRLA & 0x0F);
+    #endif
+}
+
+/**
+ * @brief Disable the virtual ADC.
+ */
+void adc_disable(void)
+{
+    ADC0.CTRLA &= ~(ADC_RUNSTBY_bm | ADC_ENABLE_bm);
+}
+
+/**
+ * @brief Select the virtual ADC input channel.
+ *
+ * @param channel ADC channel to select from the `ADC_Channel` enumeration.
+ */
+void adc_channel(ADC_Channel channel)
+{
+    ADC0.MUXPOS = ((0x1F & channel)<<ADC_MUXPOS_gp);
+}
+
+/**
+ * @brief Set the virtual ADC sample accumulation mode.
+ *
+ * @param samples The ADC_Accumulation enum value specifying how many samples are accumulated.
+ */
+void adc_accumulation(ADC_Accumulation samples)
+{
+    ADC0.CTRLB = samples;
+}
+
+/**
+ * @brief Calculate the duration of one conversion with the current ADC configuration.
+ *
+ * @return Conversion time in nanoseconds (`2 + SAMPLEN + SAMPDLY + resolution` ADC clock cycles per accumulated sample).
+ */
+static unsigned long long adc_conversion_time_ns(void)
+{
+    unsigned long divider = 2UL<<(ADC0.CTRLC & ADC_PRESC_gm);
+    unsigned long cycles = 2UL + (ADC0.SAMPCTRL & 0x1F) + (ADC0.CTRLD & ADC_SAMPDLY_gm) + ((ADC0.CTRLA & ADC_RESSEL_8BIT_gc) ? 8UL : 10UL);
+
+    return (((unsigned long long)cycles * divider * 1000000000ULL) / host_per_clock())<<(ADC0.CTRLB & 0x07);
+}
+
+#ifndef ADC_ADIE
+
+    /**
+     * @brief Perform a single conversion of the selected virtual analog input.
+     *
+     * @return The conversion result (accumulated according to `ADC0.CTRLB`), or `0` when the ADC is disabled.
+     */
+    unsigned int adc_read(void)
+    {
+        unsigned int result = 0;
+
+        if(ADC0.CTRLA & ADC_ENABLE_bm)
+        {
+            host_delay_ns(adc_conversion_time_ns());
+
+            result = host->analog[ADC0.MUXPOS & ADC_MUXPOS_gm];
+
+            if(ADC0.CTRLA & ADC_RESSEL_8BIT_gc)
+            {
+                result >>= 2;
+            }
+            result <<= (ADC0.CTRLB & 0x07);
+        }
+        ADC0.RES = (uint16_t)result;
+        ADC0.INTFLAGS |= ADC_RESRDY_bm;
+
+        return ADC0.RES;
+    }
+
+    /**
+     * @brief Perform multiple conversions and return the average result (calculated in software).
+     *
+     * @param samples Number of ADC samples to average.
+     *
+     * @return The averaged conversion result.
+     */
+    unsigned int adc_average(unsigned char samples)
+    {
+        unsigned long average = 0;
+
+        for(unsigned char i=0; i < samples; i++)
+        {
+            average += adc_read();
+        }
+
+        average /= samples;
+
+        return (unsigned int)(average);
+    }
+
+#endif
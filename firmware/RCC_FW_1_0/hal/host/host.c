@@ -0,0 +1,1013 @@
+/**
+ * @file host.c
+ * @brief Host backend implementation of the virtual register file, clock and EEPROM.
+ *
+ * This source file instantiates the virtual peripheral registers declared in the host `<avr/io.h>`, keeps the virtual device environment (time, pins, analog inputs, EEPROM) and implements the avr-libc EEPROM access functions on top of it.
+ *
+ * The virtual time engine advances the clock on behalf of the firmware, models the `TCA0` overflow and the `PORTA` pin change interrupts (including the `TCB0` timestamp of the overflow) and applies scheduled environment events. A software reset restarts the firmware in a fresh process (`host_run()`), so all static variables of the firmware are initialized exactly like after a reset of the microcontroller, while the environment survives in shared memory.
+ *
+ * @note Interrupt flags are cleared by the backend when the corresponding interrupt service routine returns. Firmware writes to `INTFLAGS` registers are therefore ignored.
+ *
+ * @author g.raf
+ * @date 2026-10-17
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger embedded systems project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/rcc "RCC - RGB LED Color Cube"
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+#include <avr/interrupt.h>
+#include <avr/eeprom.h>
+
+#include "host.h"
+
+#ifndef HOST_SHARED_SIZE
+    /**
+     * @def HOST_SHARED_SIZE
+     * @brief Size of the memory shared between all firmware runs (host state and tool allocations).
+     */
+    #define HOST_SHARED_SIZE (64UL<<20)
+#endif
+
+register8_t CCP;
+register8_t SREG;
+
+PORT_t host_porta;
+PORTMUX_t PORTMUX;
+CLKCTRL_t CLKCTRL;
+RSTCTRL_t RSTCTRL;
+SLPCTRL_t SLPCTRL;
+SPI_t SPI0;
+ADC_t ADC0;
+VREF_t VREF;
+TCA_t TCA0;
+TCB_t TCB0;
+EVSYS_t EVSYS;
+
+static HOST_State host_state;
+HOST_State *host = &host_state;
+
+void (*host_spi_observer)(unsigned char data);
+void (*host_event_observer)(const HOST_Event *event);
+
+// Provided by the linker when at least one EEMEM variable exists
+extern unsigned char __start_host_eeprom[] __attribute__((weak));
+extern unsigned char __stop_host_eeprom[] __attribute__((weak));
+
+// Provided by the linker when at least one variable is placed into host_noinit
+extern unsigned char __start_host_noinit[] __attribute__((weak));
+extern unsigned char __stop_host_noinit[] __attribute__((weak));
+
+// Interrupt service routines of the firmware (if linked)
+extern void PORTA_PORT_vect(void) __attribute__((weak));
+extern void TCA0_OVF_vect(void) __attribute__((weak));
+
+static unsigned char *host_shared;
+static size_t host_shared_used;
+static unsigned char *host_noinit;
+
+static HOST_Event *host_events;
+static unsigned int host_event_count;
+static unsigned int host_event_capacity;
+
+static unsigned long long host_horizon;
+static unsigned char host_running;
+static unsigned char host_busy;
+
+static unsigned char porta_flags;
+static unsigned char tca_flags;
+static unsigned char tca_halted;
+static unsigned long long tca_next_ns;
+static unsigned long long tca_period;
+static unsigned long long tca_tick;
+static unsigned long sleep_ticks;
+static unsigned long long tcb_event_ns;
+static unsigned long long tcb_start_ns;
+static unsigned char tcb_running;
+
+static unsigned long poll_hash;
+static unsigned long poll_last_hash;
+static unsigned char poll_last_pins;
+static unsigned int poll_stable;
+
+/**
+ * @brief Reset the virtual register file.
+ *
+ * @param flags Reset cause written to `RSTCTRL.RSTFR` (e.g. `RSTCTRL_PORF_bm`, `RSTCTRL_SWRF_bm`).
+ *
+ * @details
+ * All peripheral registers are cleared to their reset values. Time, pins, analog inputs and EEPROM contents are not affected, because they belong to the environment of the device and not to the microcontroller core.
+ */
+void host_reset(unsigned char flags)
+{
+    CCP = 0;
+    SREG = 0;
+
+    memset((void *)&host_porta, 0, sizeof(host_porta));
+    memset((void *)&PORTMUX, 0, sizeof(PORTMUX));
+    memset((void *)&CLKCTRL, 0, sizeof(CLKCTRL));
+    memset((void *)&RSTCTRL, 0, sizeof(RSTCTRL));
+    memset((void *)&SLPCTRL, 0, sizeof(SLPCTRL));
+    memset((void *)&SPI0, 0, sizeof(SPI0));
+    memset((void *)&ADC0, 0, sizeof(ADC0));
+    memset((void *)&VREF, 0, sizeof(VREF));
+    memset((void *)&TCA0, 0, sizeof(TCA0));
+    memset((void *)&TCB0, 0, sizeof(TCB0));
+    memset((void *)&EVSYS, 0, sizeof(EVSYS));
+
+    // Device defaults: 20 MHz oscillator with /6 peripheral prescaler
+    CLKCTRL.MCLKCTRLB = CLKCTRL_PDIV_6X_gc | CLKCTRL_PEN_bm;
+    CLKCTRL.MCLKSTATUS = CLKCTRL_OSC20MS_bm;
+    TCA0.SINGLE.PER = 0xFFFF;
+    host_porta.IN = host->pins;
+
+    RSTCTRL.RSTFR = flags;
+
+    host_horizon = 0;
+    porta_flags = 0;
+    tca_flags = 0;
+    tca_halted = 0;
+    tca_next_ns = 0;
+    tcb_event_ns = 0;
+    tcb_running = 0;
+    poll_hash = 0;
+    poll_last_hash = 0;
+    poll_last_pins = host->pins;
+    poll_stable = 0;
+}
+
+/**
+ * @brief Power-on the virtual device.
+ *
+ * @details
+ * Creates the shared memory for the device environment, clears the virtual time, loads the EEPROM image built from all `EEMEM` variables (equivalent to programming the `.eep` file, the remaining cells are erased) and resets the register file with the power-on reset flag set. Variables in the `host_noinit` section (`.noinit` of the target) are zeroed at power-on and keep their contents over software resets.
+ */
+void host_init(void)
+{
+    if(!host_shared)
+    {
+        host_shared = mmap(NULL, HOST_SHARED_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+
+        if(host_shared == MAP_FAILED)
+        {
+            perror("host: mmap");
+            exit(EXIT_FAILURE);
+        }
+        host = (HOST_State *)host_shared;
+    }
+    host_shared_used = (sizeof(HOST_State) + 15UL) & ~15UL;
+
+    memset(host, 0, sizeof(*host));
+    memset(host->eeprom, 0xFF, sizeof(host->eeprom));
+    host->stride_ns = HOST_STRIDE_NS;
+    host->reset_flags = RSTCTRL_PORF_bm;
+
+    if(__start_host_eeprom)
+    {
+        size_t size = (size_t)(__stop_host_eeprom - __start_host_eeprom);
+
+        if(size > HOST_EEPROM_SIZE)
+        {
+            fprintf(stderr, "host: EEPROM image (%zu bytes) exceeds HOST_EEPROM_SIZE\n", size);
+            exit(EXIT_FAILURE);
+        }
+        memcpy(host->eeprom, __start_host_eeprom, size);
+        host->eeprom_size = (unsigned int)size;
+    }
+
+    if(__start_host_noinit)
+    {
+        host_noinit = host_alloc((size_t)(__stop_host_noinit - __start_host_noinit));
+    }
+    host_event_count = 0;
+    host_reset(host->reset_flags);
+}
+
+/**
+ * @brief Allocate zeroed memory that is shared between all firmware runs.
+ *
+ * @param size Number of bytes to allocate.
+ *
+ * @return Pointer to the allocated memory.
+ *
+ * @details
+ * Tools observing the firmware over several resets (e.g. energy or latency statistics) allocate their state with this function after `host_init()` and before `host_run()`.
+ */
+void *host_alloc(size_t size)
+{
+    void *memory;
+
+    if(!host_shared || ((host_shared_used + size) > HOST_SHARED_SIZE))
+    {
+        fprintf(stderr, "host: shared memory exhausted\n");
+        exit(EXIT_FAILURE);
+    }
+    memory = &host_shared[host_shared_used];
+    host_shared_used = (host_shared_used + size + 15UL) & ~15UL;
+
+    return memory;
+}
+
+/**
+ * @brief Schedule an environment event.
+ *
+ * @param time_ns Absolute virtual time of the event.
+ * @param type Event type.
+ * @param channel Pin number (`HOST_Event_Pin`) or analog input (`HOST_Event_Analog`).
+ * @param value Pin level or ADC result.
+ *
+ * @return `0` on success, `-1` if no memory is available.
+ *
+ * @details
+ * Events are kept sorted by time; events with identical time are applied in the order they were added.
+ */
+int host_event_add(unsigned long long time_ns, HOST_Event_Type type, unsigned char channel, unsigned int value)
+{
+    unsigned int i;
+
+    if(host_event_count == host_event_capacity)
+    {
+        unsigned int capacity = host_event_capacity ? (host_event_capacity<<1) : 256U;
+        HOST_Event *events = realloc(host_events, capacity * sizeof(HOST_Event));
+
+        if(!events)
+        {
+            return -1;
+        }
+        host_events = events;
+        host_event_capacity = capacity;
+    }
+
+    for(i = host_event_count; (i > 0) && (host_events[i - 1].time_ns > time_ns); i--)
+    {
+        host_events[i] = host_events[i - 1];
+    }
+    host_events[i].time_ns = time_ns;
+    host_events[i].type = type;
+    host_events[i].channel = channel;
+    host_events[i].value = value;
+    host_event_count++;
+    host_horizon = 0;
+
+    return 0;
+}
+
+/**
+ * @brief Get the next pending environment event.
+ *
+ * @return Pointer to the next event or `NULL` if all events have been applied.
+ */
+const HOST_Event *host_event_next(void)
+{
+    if(host->event_index < host_event_count)
+    {
+        return &host_events[host->event_index];
+    }
+    return NULL;
+}
+
+/**
+ * @brief Leave the current firmware run.
+ *
+ * @param reason Reason for leaving (end of scenario, software reset, error).
+ *
+ * @details
+ * Inside `host_run()` the process executing the firmware terminates and the reason is reported to the supervising process. Outside of `host_run()` the program exits.
+ */
+void host_exit(HOST_Exit reason)
+{
+    fflush(NULL);
+
+    if(host_running)
+    {
+        // The SRAM at the end of the scenario stays readable for the tools (like over UPDI)
+        if(host_noinit && (reason == HOST_Exit_End))
+        {
+            memcpy(host_noinit, __start_host_noinit, (size_t)(__stop_host_noinit - __start_host_noinit));
+        }
+        _exit((int)reason);
+    }
+    exit((reason == HOST_Exit_End) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+/**
+ * @brief Run the firmware until the scenario ends.
+ *
+ * @param entry Firmware entry point (`rcc_main` in the host build).
+ *
+ * @return `HOST_Exit_End` when the scenario finished, otherwise `HOST_Exit_Error`.
+ *
+ * @details
+ * Every start of the firmware (power-on and each software reset) is executed in a new child process. This reproduces the zero/initial values of all firmware variables after a reset, while the host state and memory from `host_alloc()` are shared between the runs. When the scenario ended, the `host_noinit` variables of the last run are copied into the calling process.
+ */
+int host_run(int (*entry)(void))
+{
+    while(1)
+    {
+        int status;
+        pid_t pid;
+
+        fflush(NULL);
+        pid = fork();
+
+        if(pid < 0)
+        {
+            perror("host: fork");
+            return HOST_Exit_Error;
+        }
+
+        if(pid == 0)
+        {
+            host_running = 1;
+            host_reset(host->reset_flags);
+            host->boots++;
+            host->waiting = 0;
+            host->quiet = 0;
+
+            if(host_noinit)
+            {
+                memcpy(__start_host_noinit, host_noinit, (size_t)(__stop_host_noinit - __start_host_noinit));
+            }
+            entry();
+            host_exit(HOST_Exit_Error);
+        }
+
+        if((waitpid(pid, &status, 0) < 0) || !WIFEXITED(status))
+        {
+            return HOST_Exit_Error;
+        }
+
+        switch(WEXITSTATUS(status))
+        {
+            case HOST_Exit_Reset:
+                break;
+            case HOST_Exit_End:
+                if(host_noinit)
+                {
+                    memcpy(__start_host_noinit, host_noinit, (size_t)(__stop_host_noinit - __start_host_noinit));
+                }
+                return HOST_Exit_End;
+            default:
+                return HOST_Exit_Error;
+        }
+    }
+}
+
+/**
+ * @brief Calculate the current peripheral clock frequency.
+ *
+ * @return Peripheral clock (`CLK_PER`) in Hertz derived from `CLKCTRL.MCLKCTRLA` and `CLKCTRL.MCLKCTRLB`.
+ */
+unsigned long host_per_clock(void)
+{
+    static const unsigned char divider[16] = { 2, 4, 8, 16, 32, 64, 1, 1, 6, 10, 12, 24, 48, 1, 1, 1 };
+    static unsigned int control = 0xFFFF;
+    static unsigned long clock;
+
+    // Recalculate only if the clock configuration changed
+    if(control == (((unsigned int)CLKCTRL.MCLKCTRLA<<8) | CLKCTRL.MCLKCTRLB))
+    {
+        return clock;
+    }
+    control = ((unsigned int)CLKCTRL.MCLKCTRLA<<8) | CLKCTRL.MCLKCTRLB;
+    clock = F_CPU;
+
+    if((CLKCTRL.MCLKCTRLA & CLKCTRL_CLKSEL_gm) == CLKCTRL_CLKSEL_OSCULP32K_gc)
+    {
+        clock = 32768UL;
+    }
+
+    if(CLKCTRL.MCLKCTRLB & CLKCTRL_PEN_bm)
+    {
+        clock /= divider[(CLKCTRL.MCLKCTRLB & CLKCTRL_PDIV_gm)>>1];
+    }
+    return clock;
+}
+
+static void host_check_reset(void)
+{
+    if(RSTCTRL.SWRR & RSTCTRL_SWRE_bm)
+    {
+        host->reset_flags = RSTCTRL_SWRF_bm;
+
+        // The SRAM keeps its contents over a software reset
+        if(host_noinit)
+        {
+            memcpy(host_noinit, __start_host_noinit, (size_t)(__stop_host_noinit - __start_host_noinit));
+        }
+        host_exit(HOST_Exit_Reset);
+    }
+}
+
+/**
+ * @brief Start or stop the virtual `TCA0` according to its control register.
+ *
+ * @details
+ * Tick and period duration (in nanoseconds scaled by 2^16) are latched when the timer starts counting.
+ */
+static void tca_update(void)
+{
+    static const unsigned int prescaler[8] = { 1, 2, 4, 8, 16, 64, 256, 1024 };
+
+    if((TCA0.SINGLE.CTRLA & TCA_SINGLE_ENABLE_bm) && !tca_halted)
+    {
+        if(!tca_next_ns)
+        {
+            tca_tick = ((unsigned long long)prescaler[(TCA0.SINGLE.CTRLA & TCA_SINGLE_CLKSEL_gm)>>TCA_SINGLE_CLKSEL_gp] * (1000000000ULL<<16)) / host_per_clock();
+            tca_period = (((unsigned long long)TCA0.SINGLE.PER + 1ULL) * tca_tick)>>16;
+            tca_next_ns = host->time_ns + tca_period;
+        }
+    }
+    else
+    {
+        tca_next_ns = 0;
+    }
+}
+
+static void tca_count(void)
+{
+    if(tca_next_ns)
+    {
+        TCA0.SINGLE.CNT = (uint16_t)(((tca_period - (tca_next_ns - host->time_ns))<<16) / tca_tick);
+    }
+}
+
+/**
+ * @brief Check whether `TCB0` measures the `TCA0` overflow period.
+ *
+ * @details
+ * The frequency measurement mode with the `TCA0` overflow routed over the synchronous event channel 0 is modeled with `tcb_capture()`, the periodic interrupt mode as free running counter with `tcb_free()`. `TCB0` does not count in any other configuration.
+ */
+static unsigned char tcb_routed(void)
+{
+    return (TCB0.CTRLA & TCB_ENABLE_bm) &&
+           ((TCB0.CTRLB & TCB_CNTMODE_gm) == TCB_CNTMODE_FRQ_gc) &&
+           (TCB0.EVCTRL & TCB_CAPTEI_bm) &&
+           (EVSYS.SYNCCH0 == EVSYS_SYNCCH0_TCA0_OVF_LUNF_gc) &&
+           (EVSYS.ASYNCUSER0 == EVSYS_ASYNCUSER0_SYNCCH0_gc);
+}
+
+/**
+ * @brief Calculate the `TCB0` counts since `start` (the last `TCA0` overflow or the enable of the counter).
+ */
+static unsigned long long tcb_counts(unsigned long long start)
+{
+    unsigned long long elapsed = host->time_ns - start;
+
+    switch(TCB0.CTRLA & TCB_CLKSEL_gm)
+    {
+        case TCB_CLKSEL_CLKDIV2_gc:
+            return (elapsed * (host_per_clock() / 2UL)) / 1000000000ULL;
+        case TCB_CLKSEL_CLKTCA_gc:
+            return (elapsed<<16) / tca_tick;
+        default:
+            return (elapsed * host_per_clock()) / 1000000000ULL;
+    }
+}
+
+/**
+ * @brief Check whether `TCB0` counts in the periodic interrupt mode.
+ *
+ * @details
+ * Register writes take no virtual time, so the counter starts at the first time advance after it was enabled. The counter wraps at `CCMP`.
+ */
+static unsigned char tcb_free(void)
+{
+    if(!(TCB0.CTRLA & TCB_ENABLE_bm) || ((TCB0.CTRLB & TCB_CNTMODE_gm) != TCB_CNTMODE_INT_gc))
+    {
+        tcb_running = 0;
+        return 0;
+    }
+
+    if(!tcb_running)
+    {
+        tcb_running = 1;
+        tcb_start_ns = host->time_ns;
+    }
+
+    return 1;
+}
+
+static void tcb_count(void)
+{
+    if(tcb_event_ns && tcb_routed())
+    {
+        TCB0.CNT = (uint16_t)tcb_counts(tcb_event_ns);
+    }
+    else if(tcb_free())
+    {
+        TCB0.CNT = (uint16_t)(tcb_counts(tcb_start_ns) % ((unsigned long long)TCB0.CCMP + 1ULL));
+    }
+}
+
+/**
+ * @brief Capture and restart `TCB0` on a `TCA0` overflow event.
+ */
+static void tcb_capture(void)
+{
+    if(!tcb_routed())
+    {
+        tcb_event_ns = 0;
+        return;
+    }
+
+    if(tcb_event_ns)
+    {
+        TCB0.CCMP = (uint16_t)tcb_counts(tcb_event_ns);
+    }
+    tcb_event_ns = host->time_ns;
+    TCB0.CNT = 0;
+    TCB0.INTFLAGS |= TCB_CAPT_bm;
+}
+
+static unsigned char host_pending(void)
+{
+    return (porta_flags != 0) || ((tca_flags & TCA0.SINGLE.INTCTRL & TCA_SINGLE_OVF_bm) != 0);
+}
+
+static void host_isr(void (*vector)(void))
+{
+    SREG &= (unsigned char)~CPU_I_bm;
+
+    if(vector)
+    {
+        tcb_count();
+        vector();
+    }
+    host->interrupts++;
+    SREG |= CPU_I_bm;
+}
+
+static void host_interrupts(void)
+{
+    host_porta.INTFLAGS = porta_flags;
+    TCA0.SINGLE.INTFLAGS = tca_flags;
+
+    if(!(SREG & CPU_I_bm))
+    {
+        return;
+    }
+
+    // Lower vector numbers have higher priority
+    if(porta_flags)
+    {
+        host_isr(PORTA_PORT_vect);
+        porta_flags = 0;
+    }
+
+    if(tca_flags & TCA0.SINGLE.INTCTRL & TCA_SINGLE_OVF_bm)
+    {
+        host_isr(TCA0_OVF_vect);
+        tca_flags &= ~TCA_SINGLE_OVF_bm;
+    }
+    host_porta.INTFLAGS = porta_flags;
+    TCA0.SINGLE.INTFLAGS = tca_flags;
+}
+
+static void host_pin(unsigned char pin, unsigned char level)
+{
+    unsigned char mask = (unsigned char)(1U<<pin);
+    unsigned char old = host->pins & mask;
+    unsigned char isc = (&host_porta.PIN0CTRL)[pin] & PORT_ISC_gm;
+
+    if(level)
+    {
+        host->pins |= mask;
+    }
+    else
+    {
+        host->pins &= ~mask;
+    }
+
+    if(old == (host->pins & mask))
+    {
+        return;
+    }
+
+    if((isc == PORT_ISC_BOTHEDGES_gc) ||
+       ((isc == PORT_ISC_RISING_gc) && level) ||
+       (((isc == PORT_ISC_FALLING_gc) || (isc == PORT_ISC_LEVEL_gc)) && !level))
+    {
+        porta_flags |= mask;
+    }
+}
+
+static void host_apply(const HOST_Event *event)
+{
+    switch(event->type)
+    {
+        case HOST_Event_Pin:
+            host_pin(event->channel & 0x07, (unsigned char)event->value);
+            break;
+        case HOST_Event_Analog:
+            if(event->channel < HOST_ANALOG_CHANNELS)
+            {
+                host->analog[event->channel] = event->value;
+            }
+            break;
+        default:
+            break;
+    }
+
+    if(host_event_observer)
+    {
+        host_event_observer(event);
+    }
+
+    if(event->type == HOST_Event_End)
+    {
+        host_exit(HOST_Exit_End);
+    }
+}
+
+/**
+ * @brief Advance the virtual clock.
+ *
+ * @param ns Time to advance in nanoseconds.
+ *
+ * @details
+ * Applies all environment events and `TCA0` overflows that occur within the interval at their exact time and executes the corresponding interrupt service routines if interrupts are enabled.
+ */
+static void host_advance(unsigned long long ns)
+{
+    unsigned long long target = host->time_ns + ns;
+    const HOST_Event *event;
+
+    if(host_busy)
+    {
+        host->time_ns = target;
+        return;
+    }
+    host_check_reset();
+    tca_update();
+
+    // Nothing happens within the interval
+    if((target < host_horizon) && (!tca_next_ns || (target < tca_next_ns)))
+    {
+        host->time_ns = target;
+        tcb_count();
+        return;
+    }
+    host_busy++;
+    host_interrupts();
+
+    while(1)
+    {
+        unsigned long long next = target;
+
+        event = host_event_next();
+
+        if(event && (event->time_ns < next))
+        {
+            next = (event->time_ns > host->time_ns) ? event->time_ns : host->time_ns;
+        }
+        tca_update();
+
+        // Systick overflows up to the next event are executed back to back
+        while(tca_next_ns && (tca_next_ns <= next))
+        {
+            host->time_ns = tca_next_ns;
+            tca_next_ns += tca_period;
+            tca_flags |= TCA_SINGLE_OVF_bm;
+            tcb_capture();
+            host_interrupts();
+            tca_update();
+        }
+        host->time_ns = next;
+
+        while((event = host_event_next()) && (event->time_ns <= host->time_ns))
+        {
+            host->event_index++;
+            host_apply(event);
+        }
+        host_interrupts();
+
+        if(host->time_ns >= target)
+        {
+            break;
+        }
+    }
+    tca_count();
+    tcb_count();
+    host_busy--;
+
+    host_horizon = 0;
+
+    if(!porta_flags && !tca_flags)
+    {
+        event = host_event_next();
+        host_horizon = event ? event->time_ns : ~0ULL;
+
+        if(tca_next_ns && (tca_next_ns < host_horizon))
+        {
+            host_horizon = tca_next_ns;
+        }
+    }
+}
+
+/**
+ * @brief Account a busy-wait delay on the virtual clock.
+ *
+ * @param ns Delay duration in nanoseconds.
+ */
+void host_delay_ns(unsigned long long ns)
+{
+    host->waiting = 1;
+    host_advance(ns);
+    host->waiting = 0;
+}
+
+/**
+ * @brief Notify the backend about a byte shifted out by the SPI.
+ *
+ * @param data Transmitted byte.
+ */
+void host_spi_sent(unsigned char data)
+{
+    poll_hash = ((poll_hash ^ data) * 16777619UL) + 1UL;
+
+    if(host_spi_observer)
+    {
+        host_spi_observer(data);
+    }
+}
+
+/**
+ * @brief Access the virtual `PORTA` register block.
+ *
+ * @return Pointer to the virtual `PORTA` registers.
+ *
+ * @details
+ * Applies pending strobe register writes (`DIRSET`, `OUTCLR`, ...), accounts `HOST_POLL_CYCLES` on the virtual clock and refreshes `IN` with the external pin levels. If the firmware polls repeatedly without sending SPI data and without input changes, it is considered idle and the clock is advanced by the configured stride (limited to the next environment event).
+ */
+PORT_t *host_port(void)
+{
+    if(!host_busy)
+    {
+        unsigned long long ns = ((unsigned long long)HOST_POLL_CYCLES * 1000000000ULL) / F_CPU;
+
+        if((poll_hash == poll_last_hash) && (host->pins == poll_last_pins))
+        {
+            if(poll_stable < HOST_STEADY_POLLS)
+            {
+                poll_stable++;
+            }
+        }
+        else
+        {
+            poll_stable = 0;
+        }
+        poll_last_hash = poll_hash;
+        poll_last_pins = host->pins;
+        poll_hash = 0;
+
+        if((poll_stable >= HOST_STEADY_POLLS) && host->stride_ns)
+        {
+            const HOST_Event *event = host_event_next();
+            unsigned long long stride = host->stride_ns;
+
+            if(event && ((host->time_ns + ns + stride) > event->time_ns))
+            {
+                stride = (event->time_ns > (host->time_ns + ns)) ? (event->time_ns - host->time_ns - ns) : 0;
+            }
+            ns += stride;
+        }
+        host_advance(ns);
+    }
+
+    host_porta.DIR = (host_porta.DIR | host_porta.DIRSET) & ~host_porta.DIRCLR;
+    host_porta.DIR ^= host_porta.DIRTGL;
+    host_porta.OUT = (host_porta.OUT | host_porta.OUTSET) & ~host_porta.OUTCLR;
+    host_porta.OUT ^= host_porta.OUTTGL;
+    host_porta.DIRSET = host_porta.DIRCLR = host_porta.DIRTGL = 0;
+    host_porta.OUTSET = host_porta.OUTCLR = host_porta.OUTTGL = 0;
+    host_porta.IN = (host->pins & ~host_porta.DIR) | (host_porta.OUT & host_porta.DIR);
+    host_porta.INTFLAGS = porta_flags;
+
+    return &host_porta;
+}
+
+/**
+ * @brief Announce the systicks of the next idle sleep that have no work for the firmware.
+ *
+ * @param ticks Number of `TCA0` overflows until the firmware has to run again (`0` or `1` wakes on the next overflow).
+ *
+ * @details
+ * Called by the firmware through `sleep_hint()` right before `sleep_cpu()`, the announcement stays visible to the tools in `host->quiet` until the next one. The next idle sleep executes the first `ticks - 1` overflow interrupts back to back without returning to the main loop, an environment event (e.g. a button press) ends it early. The device wakes on every overflow, the hint only saves host time.
+ */
+void host_sleep_hint(unsigned long ticks)
+{
+    sleep_ticks = ticks;
+    host->quiet = ticks;
+}
+
+/**
+ * @brief Execute the `SLEEP` instruction.
+ *
+ * @details
+ * If sleep is enabled, the virtual clock is fast-forwarded from event to event until an enabled interrupt wakes the device. `TCA0` keeps running in idle mode and is halted in standby and power-down. When no further event can wake the device, the scenario ends. A firmware that sleeps between its polls is not busy waiting, so the idle stride of `host_port()` is restarted.
+ */
+void host_sleep(void)
+{
+    unsigned char mode = SLPCTRL.CTRLA & SLPCTRL_SMODE_gm;
+    unsigned long interrupts = host->interrupts;
+    unsigned long ticks = sleep_ticks;
+    unsigned long long remaining = 0;
+
+    sleep_ticks = 0;
+
+    if(!(SLPCTRL.CTRLA & SLPCTRL_SEN_bm))
+    {
+        return;
+    }
+    host_check_reset();
+    poll_stable = 0;
+
+    tca_halted = (mode == SLPCTRL_SMODE_PDOWN_gc) || (mode == SLPCTRL_SMODE_STDBY_gc);
+    tca_update();
+
+    // Systicks without work for the firmware are executed back to back up to the next event
+    if(!tca_halted && (ticks > 1) && tca_next_ns && !host_pending() && (SREG & CPU_I_bm))
+    {
+        const HOST_Event *event = host_event_next();
+        unsigned long long target = tca_next_ns + ((unsigned long long)(ticks - 2) * tca_period);
+        unsigned int events = host->event_index;
+
+        if(event && (event->time_ns < target))
+        {
+            target = (event->time_ns > host->time_ns) ? event->time_ns : host->time_ns;
+        }
+        host->sleep_ns += target - host->time_ns;
+        host_advance(target - host->time_ns);
+
+        // Woken by the environment
+        if((host->event_index != events) || host_pending())
+        {
+            return;
+        }
+        interrupts = host->interrupts;
+    }
+
+    if(tca_halted && tca_next_ns)
+    {
+        remaining = tca_next_ns - host->time_ns;
+        tca_next_ns = 0;
+    }
+
+    while((host->interrupts == interrupts) && !host_pending())
+    {
+        const HOST_Event *event = host_event_next();
+        unsigned long long next;
+
+        tca_update();
+
+        if(!event && !tca_next_ns)
+        {
+            host_exit(HOST_Exit_End);
+        }
+        next = event ? event->time_ns : tca_next_ns;
+
+        if(tca_next_ns && (tca_next_ns < next))
+        {
+            next = tca_next_ns;
+        }
+        next = (next > host->time_ns) ? (next - host->time_ns) : 0;
+        host->sleep_ns += next;
+        host_advance(next);
+    }
+
+    if(tca_halted)
+    {
+        tca_halted = 0;
+
+        if(remaining && (TCA0.SINGLE.CTRLA & TCA_SINGLE_ENABLE_bm))
+        {
+            tca_next_ns = host->time_ns + remaining;
+        }
+    }
+}
+
+/**
+ * @brief Translate a pointer to an `EEMEM` variable into an EEPROM address.
+ *
+ * @param p Pointer into the `host_eeprom` section or fixed EEPROM address.
+ * @param n Number of bytes accessed from `p`, which must fit into `HOST_EEPROM_SIZE`.
+ *
+ * @return EEPROM address (offset from the start of the EEPROM).
+ */
+unsigned int host_eeprom_address(const void *p, size_t n)
+{
+    const unsigned char *address = (const unsigned char *)p;
+    uintptr_t offset;
+
+    if((uintptr_t)p < HOST_EEPROM_SIZE)
+    {
+        offset = (uintptr_t)p;
+    }
+    else if(__start_host_eeprom && (address >= __start_host_eeprom) && (address < __stop_host_eeprom))
+    {
+        offset = (uintptr_t)(address - __start_host_eeprom);
+    }
+    else
+    {
+        fprintf(stderr, "host: %p is not an EEPROM address\n", p);
+        abort();
+    }
+
+    if((offset + n) > HOST_EEPROM_SIZE)
+    {
+        fprintf(stderr, "host: EEPROM access of %zu bytes at 0x%04lx exceeds HOST_EEPROM_SIZE\n", n, (unsigned long)offset);
+        abort();
+    }
+    return (unsigned int)offset;
+}
+
+void eeprom_read_block(void *dst, const void *src, size_t n)
+{
+    memcpy(dst, &host->eeprom[host_eeprom_address(src, n)], n);
+}
+
+/**
+ * @brief Program an EEPROM cell and account its erase/write cycle.
+ *
+ * @details
+ * The EEPROM of the ATtiny402 erases and writes only the bytes loaded into the page buffer, so every programmed byte costs one cycle of its own cell.
+ */
+static void host_eeprom_program(unsigned int address, uint8_t value)
+{
+    if(address < HOST_EEPROM_SIZE)
+    {
+        host->eeprom[address] = value;
+        host->eeprom_writes[address]++;
+    }
+}
+
+void eeprom_write_block(const void *src, void *dst, size_t n)
+{
+    unsigned int address = host_eeprom_address(dst, n);
+
+    for(size_t i=0; i < n; i++)
+    {
+        host_eeprom_program(address + i, ((const uint8_t *)src)[i]);
+    }
+
+    if(n)
+    {
+        host->eeprom_operations++;
+        host->eeprom_commits[address]++;
+    }
+}
+
+void eeprom_update_block(const void *src, void *dst, size_t n)
+{
+    unsigned int address = host_eeprom_address(dst, n);
+    unsigned char programmed = 0;
+
+    // Like avr-libc only cells with a different value are programmed
+    for(size_t i=0; i < n; i++)
+    {
+        if(host->eeprom[address + i] != ((const uint8_t *)src)[i])
+        {
+            host_eeprom_program(address + i, ((const uint8_t *)src)[i]);
+            programmed = 1;
+        }
+    }
+    if(programmed)
+    {
+        host->eeprom_operations++;
+        host->eeprom_commits[address]++;
+    }
+}
+
+uint8_t eeprom_read_byte(const uint8_t *p)
+{
+    return host->eeprom[host_eeprom_address(p, 1)];
+}
+
+void eeprom_write_byte(uint8_t *p, uint8_t value)
+{
+    unsigned int address = host_eeprom_address(p, 1);
+
+    host_eeprom_program(address, value);
+    host->eeprom_operations++;
+    host->eeprom_commits[address]++;
+}
+
+void eeprom_update_byte(uint8_t *p, uint8_t value)
+{
+    if(host->eeprom[host_eeprom_address(p, 1)] != value)
+    {
+        eeprom_write_byte(p, value);
+    }
+}
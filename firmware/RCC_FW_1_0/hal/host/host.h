@@ -0,0 +1,204 @@
+/**
+ * @file host.h
+ * @brief Host backend interface for running RCC firmware modules natively.
+ *
+ * This header declares the virtual device state used when the firmware is compiled with a native compiler instead of avr-gcc. It provides the virtual clock, the analog inputs sampled by the ADC, the EEPROM contents and observer hooks that allow tools to capture peripheral activity (e.g. the SPI byte stream sent to the LEDs).
+ *
+ * The virtual clock only advances when the firmware consumes time: busy-wait delays, SPI and ADC transfers and polling of `PORTA`. While advancing, the backend raises the `TCA0` overflow interrupt (`systick`) and applies the scheduled environment events (button levels, battery voltage). Sleep modes fast-forward to the next wake-up event, so long scenarios replay in a fraction of real time.
+ *
+ * @author g.raf
+ * @date 2026-10-17
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger embedded systems project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/rcc "RCC - RGB LED Color Cube"
+ */
+
+#ifndef HOST_H_
+#define HOST_H_
+
+    #ifndef F_CPU
+        /**
+         * @def F_CPU
+         * @brief System clock frequency definition.
+         *
+         * @details
+         * This macro defines the operating frequency of the virtual microcontroller in Hertz. It must match the value the firmware modules are compiled with, because peripheral timing (SPI byte time, ADC conversion time) is derived from it.
+         */
+        #define F_CPU 20000000UL
+    #endif
+
+    #ifndef HOST_EEPROM_SIZE
+        /**
+         * @def HOST_EEPROM_SIZE
+         * @brief Capacity of the virtual EEPROM in bytes.
+         *
+         * @details
+         * Defaults to the `EEPROM_SIZE` of the target device, so an `EEMEM` image or an access that would not fit the EEPROM of the ATtiny402 stops the host run instead of passing silently. Addresses below `HOST_EEPROM_SIZE` are accepted as raw EEPROM offsets (e.g. records at a fixed address).
+         */
+        #define HOST_EEPROM_SIZE EEPROM_SIZE
+    #endif
+
+    #ifndef HOST_ANALOG_CHANNELS
+        /**
+         * @def HOST_ANALOG_CHANNELS
+         * @brief Number of virtual analog inputs selectable by `ADC0.MUXPOS`.
+         */
+        #define HOST_ANALOG_CHANNELS 32
+    #endif
+
+    #ifndef HOST_POLL_CYCLES
+        /**
+         * @def HOST_POLL_CYCLES
+         * @brief CPU cycles accounted for every access to `PORTA`.
+         *
+         * @details
+         * Approximates the cost of one iteration of a polling loop (load, test, branch and loop condition), so the virtual clock advances while the firmware busy-waits on an input.
+         */
+        #define HOST_POLL_CYCLES 20UL
+    #endif
+
+    #ifndef HOST_STEADY_POLLS
+        /**
+         * @def HOST_STEADY_POLLS
+         * @brief Number of identical polling iterations after which the firmware is considered idle.
+         *
+         * @details
+         * A polling iteration is identical to the previous one if the input levels and the SPI bytes sent since the last access to `PORTA` did not change. In this steady state the virtual clock is advanced by the configured stride (`HOST_State.stride_ns`) per iteration.
+         */
+        #define HOST_STEADY_POLLS 16U
+    #endif
+
+    #ifndef HOST_STRIDE_NS
+        /**
+         * @def HOST_STRIDE_NS
+         * @brief Default time skipped per polling iteration in steady state (nanoseconds).
+         *
+         * @details
+         * Input events are never skipped (the stride ends at the next scheduled event), but time based conditions of the firmware (e.g. `systick` timeouts) may be detected up to one stride late. A stride of `0` disables the acceleration.
+         */
+        #define HOST_STRIDE_NS 10000000ULL
+    #endif
+
+    #include <stddef.h>
+    #include <avr/io.h>
+
+    /**
+     * @enum HOST_Event_Type_t
+     * @brief Types of scheduled environment events.
+     */
+    enum HOST_Event_Type_t
+    {
+        HOST_Event_Pin=0,       /**< Set the external level of a `PORTA` pin */
+        HOST_Event_Analog,      /**< Set the voltage (ADC result) of an analog input */
+        HOST_Event_End          /**< End of the scenario */
+    };
+
+    /**
+     * @typedef HOST_Event_Type
+     * @brief Alias for enum HOST_Event_Type_t.
+     */
+    typedef enum HOST_Event_Type_t HOST_Event_Type;
+
+    /**
+     * @struct HOST_Event_t
+     * @brief Environment event scheduled at an absolute virtual time.
+     */
+    struct HOST_Event_t
+    {
+        unsigned long long time_ns;     /**< Virtual time of the event */
+        HOST_Event_Type type;           /**< Event type */
+        unsigned char channel;          /**< Pin number or analog input */
+        unsigned int value;             /**< Pin level or ADC result */
+    };
+
+    /**
+     * @typedef HOST_Event
+     * @brief Alias for struct HOST_Event_t.
+     */
+    typedef struct HOST_Event_t HOST_Event;
+
+    /**
+     * @enum HOST_Exit_t
+     * @brief Reasons for leaving a firmware run.
+     */
+    enum HOST_Exit_t
+    {
+        HOST_Exit_End=0,        /**< Scenario finished */
+        HOST_Exit_Reset,        /**< Software reset requested through `RSTCTRL.SWRR` */
+        HOST_Exit_Error         /**< Firmware returned or crashed */
+    };
+
+    /**
+     * @typedef HOST_Exit
+     * @brief Alias for enum HOST_Exit_t.
+     */
+    typedef enum HOST_Exit_t HOST_Exit;
+
+    /**
+     * @struct HOST_State_t
+     * @brief Virtual device state that survives a reset of the firmware.
+     *
+     * @details
+     * The register file (PORTA, TCA0, SPI0, ...) is reset together with the firmware, whereas time, environment and the EEPROM contents belong to the environment of the device. This structure lives in memory shared between all runs started by `host_run()`.
+     */
+    struct HOST_State_t
+    {
+        unsigned long long time_ns;                         /**< Virtual time since power-on in nanoseconds */
+        unsigned long long stride_ns;                       /**< Time skipped per idle polling iteration */
+        unsigned long long sleep_ns;                        /**< Accumulated time spent in sleep modes */
+        unsigned long boots;                                /**< Number of firmware starts */
+        unsigned long interrupts;                           /**< Number of executed interrupt service routines */
+        unsigned int event_index;                           /**< Next scheduled event */
+        unsigned char reset_flags;                          /**< `RSTCTRL.RSTFR` value for the next start */
+        unsigned char pins;                                 /**< External levels of the `PORTA` pins */
+        unsigned char waiting;                              /**< Firmware executes a busy-wait delay (`_delay_ms`, `_delay_us`) */
+        unsigned long quiet;                                /**< Systicks without work announced by the last `sleep_hint()` (`0` while the firmware has work) */
+        unsigned int analog[HOST_ANALOG_CHANNELS];          /**< ADC result per `MUXPOS` input */
+        unsigned int eeprom_size;                           /**< Size of the EEPROM image in bytes */
+        unsigned char eeprom[HOST_EEPROM_SIZE];             /**< EEPROM contents */
+        unsigned long eeprom_writes[HOST_EEPROM_SIZE];      /**< Erase/write cycles per EEPROM cell */
+        unsigned long eeprom_operations;                    /**< EEPROM write calls that programmed at least one cell */
+        unsigned long eeprom_commits[HOST_EEPROM_SIZE];     /**< EEPROM write calls that programmed at least one cell, per start address */
+    };
+
+    /**
+     * @typedef HOST_State
+     * @brief Alias for struct HOST_State_t representing the virtual device environment.
+     */
+    typedef struct HOST_State_t HOST_State;
+
+    extern HOST_State *host;
+
+    /**
+     * @brief Observer called for every byte shifted out by `spi_transfer()`.
+     */
+    extern void (*host_spi_observer)(unsigned char data);
+
+    /**
+     * @brief Observer called after every applied environment event.
+     */
+    extern void (*host_event_observer)(const HOST_Event *event);
+
+    void host_init(void);
+    void host_reset(unsigned char flags);
+    void *host_alloc(size_t size);
+
+    int host_event_add(unsigned long long time_ns, HOST_Event_Type type, unsigned char channel, unsigned int value);
+    const HOST_Event *host_event_next(void);
+
+    int host_run(int (*entry)(void));
+    void host_exit(HOST_Exit reason);
+
+    unsigned long host_per_clock(void);
+    void host_delay_ns(unsigned long long ns);
+    void host_spi_sent(unsigned char data);
+    void host_sleep(void);
+    void host_sleep_hint(unsigned long ticks);
+    unsigned int host_eeprom_address(const void *p, size_t n);
+
+#endif /* HOST_H_ */
@@ -0,0 +1,41 @@
+/**
+ * @file eeprom.h
+ * @brief Host replacement for `<avr/eeprom.h>`.
+ *
+ * Variables declared with `EEMEM` are collected in the `host_eeprom` linker section, which forms the initial EEPROM image (equivalent to the `.eep` file of the target build). The variables are byte aligned like on the target, so the image has the same layout. Access functions translate pointers into that section to EEPROM addresses and operate on the virtual EEPROM of the host backend. Fixed EEPROM addresses (e.g. `(void *)0x60`) are accepted as well.
+ *
+ * @author g.raf
+ * @date 2026-10-17
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger embedded systems project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/rcc "RCC - RGB LED Color Cube"
+ */
+
+#ifndef HOST_AVR_EEPROM_H_
+#define HOST_AVR_EEPROM_H_
+
+    #include <stddef.h>
+    #include <stdint.h>
+
+    /**
+     * @def EEMEM
+     * @brief Places a variable into the virtual EEPROM image.
+     */
+    #define EEMEM __attribute__((section("host_eeprom"), used, aligned(1)))
+
+    void eeprom_read_block(void *dst, const void *src, size_t n);
+    void eeprom_write_block(const void *src, void *dst, size_t n);
+    void eeprom_update_block(const void *src, void *dst, size_t n);
+    uint8_t eeprom_read_byte(const uint8_t *p);
+    void eeprom_write_byte(uint8_t *p, uint8_t value);
+    void eeprom_update_byte(uint8_t *p, uint8_t value);
+
+    #define eeprom_is_ready() 1
+    #define eeprom_busy_wait() do {} while(0)
+
+#endif /* HOST_AVR_EEPROM_H_ */
@@ -0,0 +1,53 @@
+/**
+ * @file interrupt.h
+ * @brief Host replacement for `<avr/interrupt.h>`.
+ *
+ * Interrupt service routines are compiled as ordinary functions named like the avr-libc vector symbols (`__vector_N`). The host backend invokes them when the corresponding virtual peripheral raises its interrupt flag and the global interrupt flag in `SREG` is set.
+ *
+ * @author g.raf
+ * @date 2026-10-17
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger embedded systems project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/rcc "RCC - RGB LED Color Cube"
+ */
+
+#ifndef HOST_AVR_INTERRUPT_H_
+#define HOST_AVR_INTERRUPT_H_
+
+    #include <avr/io.h>
+
+    /**
+     * @def _VECTOR
+     * @brief Builds the symbol name of interrupt vector `N`.
+     */
+    #define _VECTOR(N) __vector_ ## N
+
+    #define PORTA_PORT_vect_num 3
+    #define PORTA_PORT_vect _VECTOR(3)
+    #define TCA0_OVF_vect_num 8
+    #define TCA0_OVF_vect _VECTOR(8)
+
+    /**
+     * @def ISR
+     * @brief Defines an interrupt service routine as a plain host function.
+     */
+    #define ISR(vector, ...) void vector(void); void vector(void)
+
+    /**
+     * @def sei
+     * @brief Sets the global interrupt flag in the virtual status register.
+     */
+    #define sei() do { SREG |= CPU_I_bm; } while(0)
+
+    /**
+     * @def cli
+     * @brief Clears the global interrupt flag in the virtual status register.
+     */
+    #define cli() do { SREG &= (unsigned char)~CPU_I_bm; } while(0)
+
+#endif /* HOST_AVR_INTERRUPT_H_ */
@@ -0,0 +1,508 @@
+/**
+ * @file io.h
+ * @brief Host replacement for `<avr/io.h>` providing a virtual ATtiny402 register file.
+ *
+ * This header mirrors the subset of the device header (`iotn402.h`) that is used by the RCC firmware. Peripheral modules are declared as plain C structures with the same member names as the AVR device header, so firmware sources can be compiled unchanged with a native compiler. Bit masks and group configurations are copied from the device header to keep register values identical to the target.
+ *
+ * @author g.raf
+ * @date 2026-10-17
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger embedded systems project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/rcc "RCC - RGB LED Color Cube"
+ */
+
+#ifndef HOST_AVR_IO_H_
+#define HOST_AVR_IO_H_
+
+    #include <stdint.h>
+
+    /**
+     * @typedef register8_t
+     * @brief 8-bit virtual hardware register.
+     */
+    typedef volatile uint8_t register8_t;
+
+    /**
+     * @typedef register16_t
+     * @brief 16-bit virtual hardware register.
+     */
+    typedef volatile uint16_t register16_t;
+
+    /**
+     * @def _BV
+     * @brief Converts a bit number into a bit mask.
+     */
+    #define _BV(bit) (1 << (bit))
+
+    /* Pin bit masks */
+    #define PIN0_bm 0x01
+    #define PIN0_bp 0
+    #define PIN1_bm 0x02
+    #define PIN1_bp 1
+    #define PIN2_bm 0x04
+    #define PIN2_bp 2
+    #define PIN3_bm 0x08
+    #define PIN3_bp 3
+    #define PIN4_bm 0x10
+    #define PIN4_bp 4
+    #define PIN5_bm 0x20
+    #define PIN5_bp 5
+    #define PIN6_bm 0x40
+    #define PIN6_bp 6
+    #define PIN7_bm 0x80
+    #define PIN7_bp 7
+
+    /**
+     * @struct PORT_struct
+     * @brief Virtual I/O port register block.
+     */
+    typedef struct PORT_struct
+    {
+        register8_t DIR;
+        register8_t DIRSET;
+        register8_t DIRCLR;
+        register8_t DIRTGL;
+        register8_t OUT;
+        register8_t OUTSET;
+        register8_t OUTCLR;
+        register8_t OUTTGL;
+        register8_t IN;
+        register8_t INTFLAGS;
+        register8_t PORTCTRL;
+        register8_t reserved_1[5];
+        register8_t PIN0CTRL;
+        register8_t PIN1CTRL;
+        register8_t PIN2CTRL;
+        register8_t PIN3CTRL;
+        register8_t PIN4CTRL;
+        register8_t PIN5CTRL;
+        register8_t PIN6CTRL;
+        register8_t PIN7CTRL;
+    } PORT_t;
+
+    #define PORT_INT_0_bm 0x01
+    #define PORT_INT_1_bm 0x02
+    #define PORT_INT_2_bm 0x04
+    #define PORT_INT_3_bm 0x08
+    #define PORT_INT_4_bm 0x10
+    #define PORT_INT_5_bm 0x20
+    #define PORT_INT_6_bm 0x40
+    #define PORT_INT_7_bm 0x80
+
+    #define PORT_ISC_gm 0x07
+    #define PORT_ISC_INTDISABLE_gc (0x00<<0)
+    #define PORT_ISC_BOTHEDGES_gc (0x01<<0)
+    #define PORT_ISC_RISING_gc (0x02<<0)
+    #define PORT_ISC_FALLING_gc (0x03<<0)
+    #define PORT_ISC_INPUT_DISABLE_gc (0x04<<0)
+    #define PORT_ISC_LEVEL_gc (0x05<<0)
+    #define PORT_PULLUPEN_bm 0x08
+    #define PORT_INVEN_bm 0x80
+
+    /**
+     * @struct PORTMUX_struct
+     * @brief Virtual port multiplexer register block.
+     */
+    typedef struct PORTMUX_struct
+    {
+        register8_t CTRLA;
+        register8_t CTRLB;
+        register8_t CTRLC;
+        register8_t CTRLD;
+    } PORTMUX_t;
+
+    #define PORTMUX_SPI0_bm 0x04
+    #define PORTMUX_SPI0_DEFAULT_gc (0x00<<2)
+    #define PORTMUX_SPI0_ALTERNATE_gc (0x01<<2)
+
+    /**
+     * @struct CLKCTRL_struct
+     * @brief Virtual clock controller register block.
+     */
+    typedef struct CLKCTRL_struct
+    {
+        register8_t MCLKCTRLA;
+        register8_t MCLKCTRLB;
+        register8_t MCLKLOCK;
+        register8_t MCLKSTATUS;
+        register8_t OSC20MCTRLA;
+        register8_t OSC20MCALIBA;
+        register8_t OSC20MCALIBB;
+        register8_t OSC32KCTRLA;
+    } CLKCTRL_t;
+
+    #define CLKCTRL_CLKSEL_gm 0x03
+    #define CLKCTRL_CLKSEL_OSC20M_gc (0x00<<0)
+    #define CLKCTRL_CLKSEL_OSCULP32K_gc (0x01<<0)
+    #define CLKCTRL_CLKSEL_XOSC32K_gc (0x02<<0)
+    #define CLKCTRL_CLKSEL_EXTCLK_gc (0x03<<0)
+    #define CLKCTRL_PEN_bm 0x01
+    #define CLKCTRL_PDIV_gm 0x1E
+    #define CLKCTRL_PDIV_2X_gc (0x00<<1)
+    #define CLKCTRL_PDIV_4X_gc (0x01<<1)
+    #define CLKCTRL_PDIV_8X_gc (0x02<<1)
+    #define CLKCTRL_PDIV_16X_gc (0x03<<1)
+    #define CLKCTRL_PDIV_32X_gc (0x04<<1)
+    #define CLKCTRL_PDIV_64X_gc (0x05<<1)
+    #define CLKCTRL_PDIV_6X_gc (0x08<<1)
+    #define CLKCTRL_PDIV_10X_gc (0x09<<1)
+    #define CLKCTRL_PDIV_12X_gc (0x0A<<1)
+    #define CLKCTRL_PDIV_24X_gc (0x0B<<1)
+    #define CLKCTRL_PDIV_48X_gc (0x0C<<1)
+    #define CLKCTRL_SOSC_bm 0x01
+    #define CLKCTRL_OSC20MS_bm 0x10
+    #define CLKCTRL_OSC32KS_bm 0x20
+    #define CLKCTRL_XOSC32KS_bm 0x40
+    #define CLKCTRL_EXTS_bm 0x80
+    #define CLKCTRL_RUNSTDBY_bm 0x02
+
+    /**
+     * @struct RSTCTRL_struct
+     * @brief Virtual reset controller register block.
+     */
+    typedef struct RSTCTRL_struct
+    {
+        register8_t RSTFR;
+        register8_t SWRR;
+    } RSTCTRL_t;
+
+    #define RSTCTRL_PORF_bm 0x01
+    #define RSTCTRL_BORF_bm 0x02
+    #define RSTCTRL_EXTRF_bm 0x04
+    #define RSTCTRL_WDRF_bm 0x08
+    #define RSTCTRL_SWRF_bm 0x10
+    #define RSTCTRL_UPDIRF_bm 0x20
+    #define RSTCTRL_SWRE_bm 0x01
+
+    /**
+     * @struct SLPCTRL_struct
+     * @brief Virtual sleep controller register block.
+     */
+    typedef struct SLPCTRL_struct
+    {
+        register8_t CTRLA;
+    } SLPCTRL_t;
+
+    #define SLPCTRL_SEN_bm 0x01
+    #define SLPCTRL_SMODE_gm 0x06
+    #define SLPCTRL_SMODE_IDLE_gc (0x00<<1)
+    #define SLPCTRL_SMODE_STDBY_gc (0x01<<1)
+    #define SLPCTRL_SMODE_PDOWN_gc (0x02<<1)
+
+    /**
+     * @struct SPI_struct
+     * @brief Virtual serial peripheral interface register block.
+     */
+    typedef struct SPI_struct
+    {
+        register8_t CTRLA;
+        register8_t CTRLB;
+        register8_t INTCTRL;
+        register8_t INTFLAGS;
+        register8_t DATA;
+    } SPI_t;
+
+    #define SPI_ENABLE_bm 0x01
+    #define SPI_PRESC_gm 0x06
+    #define SPI_PRESC_DIV4_gc (0x00<<1)
+    #define SPI_PRESC_DIV16_gc (0x01<<1)
+    #define SPI_PRESC_DIV64_gc (0x02<<1)
+    #define SPI_PRESC_DIV128_gc (0x03<<1)
+    #define SPI_CLK2X_bm 0x10
+    #define SPI_MASTER_bm 0x20
+    #define SPI_DORD_bm 0x40
+    #define SPI_DORD_bp 6
+    #define SPI_MODE_gm 0x03
+    #define SPI_MODE_0_bm 0x01
+    #define SPI_MODE_0_bp 0
+    #define SPI_MODE_1_bm 0x02
+    #define SPI_MODE_1_bp 1
+    #define SPI_SSD_bm 0x04
+    #define SPI_BUFWR_bm 0x40
+    #define SPI_BUFEN_bm 0x80
+    #define SPI_IE_bm 0x01
+    #define SPI_IF_bm 0x80
+    #define SPI_WRCOL_bm 0x40
+
+    /**
+     * @struct ADC_struct
+     * @brief Virtual analog to digital converter register block.
+     */
+    typedef struct ADC_struct
+    {
+        register8_t CTRLA;
+        register8_t CTRLB;
+        register8_t CTRLC;
+        register8_t CTRLD;
+        register8_t CTRLE;
+        register8_t SAMPCTRL;
+        register8_t MUXPOS;
+        register8_t reserved_1[1];
+        register8_t COMMAND;
+        register8_t EVCTRL;
+        register8_t INTCTRL;
+        register8_t INTFLAGS;
+        register8_t DBGCTRL;
+        register8_t TEMP;
+        register8_t reserved_2[2];
+        register16_t RES;
+        register16_t WINLT;
+        register16_t WINHT;
+        register8_t CALIB;
+    } ADC_t;
+
+    #define ADC_ENABLE_bm 0x01
+    #define ADC_FREERUN_bm 0x02
+    #define ADC_RESSEL_10BIT_gc (0x00<<2)
+    #define ADC_RESSEL_8BIT_gc (0x01<<2)
+    #define ADC_RUNSTBY_bm 0x80
+    #define ADC_SAMPNUM_ACC1_gc (0x00<<0)
+    #define ADC_SAMPNUM_ACC2_gc (0x01<<0)
+    #define ADC_SAMPNUM_ACC4_gc (0x02<<0)
+    #define ADC_SAMPNUM_ACC8_gc (0x03<<0)
+    #define ADC_SAMPNUM_ACC16_gc (0x04<<0)
+    #define ADC_SAMPNUM_ACC32_gc (0x05<<0)
+    #define ADC_SAMPNUM_ACC64_gc (0x06<<0)
+    #define ADC_PRESC_gm 0x07
+    #define ADC_PRESC_DIV2_gc (0x00<<0)
+    #define ADC_PRESC_DIV4_gc (0x01<<0)
+    #define ADC_PRESC_DIV8_gc (0x02<<0)
+    #define ADC_PRESC_DIV16_gc (0x03<<0)
+    #define ADC_PRESC_DIV32_gc (0x04<<0)
+    #define ADC_PRESC_DIV64_gc (0x05<<0)
+    #define ADC_PRESC_DIV128_gc (0x06<<0)
+    #define ADC_PRESC_DIV256_gc (0x07<<0)
+    #define ADC_REFSEL_INTREF_gc (0x00<<4)
+    #define ADC_REFSEL_VDDREF_gc (0x01<<4)
+    #define ADC_SAMPCAP_bm 0x40
+    #define ADC_SAMPCAP_bp 6
+    #define ADC_SAMPDLY_gm 0x0F
+    #define ADC_SAMPDLY_gp 0
+    #define ADC_ASDV_ASVOFF_gc (0x00<<4)
+    #define ADC_ASDV_ASVON_gc (0x01<<4)
+    #define ADC_INITDLY_DLY0_gc (0x00<<5)
+    #define ADC_INITDLY_DLY16_gc (0x01<<5)
+    #define ADC_INITDLY_DLY32_gc (0x02<<5)
+    #define ADC_INITDLY_DLY64_gc (0x03<<5)
+    #define ADC_INITDLY_DLY128_gc (0x04<<5)
+    #define ADC_INITDLY_DLY256_gc (0x05<<5)
+    #define ADC_MUXPOS_gm 0x1F
+    #define ADC_MUXPOS_gp 0
+    #define ADC_MUXPOS_AIN0_gc (0x00<<0)
+    #define ADC_MUXPOS_AIN1_gc (0x01<<0)
+    #define ADC_MUXPOS_AIN2_gc (0x02<<0)
+    #define ADC_MUXPOS_AIN3_gc (0x03<<0)
+    #define ADC_MUXPOS_AIN4_gc (0x04<<0)
+    #define ADC_MUXPOS_AIN5_gc (0x05<<0)
+    #define ADC_MUXPOS_AIN6_gc (0x06<<0)
+    #define ADC_MUXPOS_AIN7_gc (0x07<<0)
+    #define ADC_MUXPOS_AIN8_gc (0x08<<0)
+    #define ADC_MUXPOS_AIN9_gc (0x09<<0)
+    #define ADC_MUXPOS_AIN10_gc (0x0A<<0)
+    #define ADC_MUXPOS_AIN11_gc (0x0B<<0)
+    #define ADC_MUXPOS_DAC0_gc (0x1C<<0)
+    #define ADC_MUXPOS_INTREF_gc (0x1D<<0)
+    #define ADC_MUXPOS_TEMPSENSE_gc (0x1E<<0)
+    #define ADC_MUXPOS_GND_gc (0x1F<<0)
+    #define ADC_STCONV_bm 0x01
+    #define ADC_STARTEI_bm 0x01
+    #define ADC_RESRDY_bm 0x01
+    #define ADC_WCMP_bm 0x02
+
+    /**
+     * @struct VREF_struct
+     * @brief Virtual voltage reference register block.
+     */
+    typedef struct VREF_struct
+    {
+        register8_t CTRLA;
+        register8_t CTRLB;
+    } VREF_t;
+
+    #define VREF_ADC0REFSEL_gm 0x70
+    #define VREF_ADC0REFSEL_0V55_gc (0x00<<4)
+    #define VREF_ADC0REFSEL_1V1_gc (0x01<<4)
+    #define VREF_ADC0REFSEL_2V5_gc (0x02<<4)
+    #define VREF_ADC0REFSEL_4V34_gc (0x03<<4)
+    #define VREF_ADC0REFSEL_1V5_gc (0x04<<4)
+
+    /**
+     * @struct TCA_SINGLE_struct
+     * @brief Virtual 16-bit timer/counter type A register block (single mode).
+     */
+    typedef struct TCA_SINGLE_struct
+    {
+        register8_t CTRLA;
+        register8_t CTRLB;
+        register8_t CTRLC;
+        register8_t CTRLD;
+        register8_t CTRLECLR;
+        register8_t CTRLESET;
+        register8_t CTRLFCLR;
+        register8_t CTRLFSET;
+        register8_t EVCTRL;
+        register8_t INTCTRL;
+        register8_t INTFLAGS;
+        register8_t reserved_1[2];
+        register8_t DBGCTRL;
+        register8_t TEMP;
+        register8_t reserved_2[17];
+        register16_t CNT;
+        register8_t reserved_3[4];
+        register16_t PER;
+        register16_t CMP0;
+        register16_t CMP1;
+        register16_t CMP2;
+    } TCA_SINGLE_t;
+
+    /**
+     * @union TCA_union
+     * @brief Virtual timer/counter type A (single and split mode views).
+     */
+    typedef union TCA_union
+    {
+        TCA_SINGLE_t SINGLE;
+    } TCA_t;
+
+    #define TCA_SINGLE_ENABLE_bm 0x01
+    #define TCA_SINGLE_CLKSEL_gm 0x0E
+    #define TCA_SINGLE_CLKSEL_gp 1
+    #define TCA_SINGLE_CLKSEL_DIV1_gc (0x00<<1)
+    #define TCA_SINGLE_CLKSEL_DIV2_gc (0x01<<1)
+    #define TCA_SINGLE_CLKSEL_DIV4_gc (0x02<<1)
+    #define TCA_SINGLE_CLKSEL_DIV8_gc (0x03<<1)
+    #define TCA_SINGLE_CLKSEL_DIV16_gc (0x04<<1)
+    #define TCA_SINGLE_CLKSEL_DIV64_gc (0x05<<1)
+    #define TCA_SINGLE_CLKSEL_DIV256_gc (0x06<<1)
+    #define TCA_SINGLE_CLKSEL_DIV1024_gc (0x07<<1)
+    #define TCA_SINGLE_OVF_bm 0x01
+    #define TCA_SINGLE_CMP0_bm 0x10
+    #define TCA_SINGLE_CMP1_bm 0x20
+    #define TCA_SINGLE_CMP2_bm 0x40
+
+    /**
+     * @struct TCB_struct
+     * @brief Virtual 16-bit timer/counter type B register block.
+     */
+    typedef struct TCB_struct
+    {
+        register8_t CTRLA;
+        register8_t CTRLB;
+        register8_t reserved_1[2];
+        register8_t EVCTRL;
+        register8_t INTCTRL;
+        register8_t INTFLAGS;
+        register8_t STATUS;
+        register8_t DBGCTRL;
+        register8_t TEMP;
+        register16_t CNT;
+        register16_t CCMP;
+    } TCB_t;
+
+    #define TCB_ENABLE_bm 0x01
+    #define TCB_CLKSEL_gm 0x06
+    #define TCB_CLKSEL_gp 1
+    #define TCB_CLKSEL_CLKDIV1_gc (0x00<<1)
+    #define TCB_CLKSEL_CLKDIV2_gc (0x01<<1)
+    #define TCB_CLKSEL_CLKTCA_gc (0x02<<1)
+    #define TCB_CNTMODE_gm 0x07
+    #define TCB_CNTMODE_INT_gc (0x00<<0)
+    #define TCB_CNTMODE_TIMEOUT_gc (0x01<<0)
+    #define TCB_CNTMODE_CAPT_gc (0x02<<0)
+    #define TCB_CNTMODE_FRQ_gc (0x03<<0)
+    #define TCB_CNTMODE_PW_gc (0x04<<0)
+    #define TCB_CNTMODE_FRQPW_gc (0x05<<0)
+    #define TCB_CNTMODE_SINGLE_gc (0x06<<0)
+    #define TCB_CNTMODE_PWM8_gc (0x07<<0)
+    #define TCB_CAPTEI_bm 0x01
+    #define TCB_CAPT_bm 0x01
+
+    /**
+     * @struct EVSYS_struct
+     * @brief Virtual event system register block.
+     */
+    typedef struct EVSYS_struct
+    {
+        register8_t ASYNCSTROBE;
+        register8_t SYNCSTROBE;
+        register8_t ASYNCCH0;
+        register8_t ASYNCCH1;
+        register8_t ASYNCCH2;
+        register8_t ASYNCCH3;
+        register8_t reserved_1[4];
+        register8_t SYNCCH0;
+        register8_t SYNCCH1;
+        register8_t reserved_2[6];
+        register8_t ASYNCUSER0;
+        register8_t ASYNCUSER1;
+        register8_t ASYNCUSER2;
+        register8_t ASYNCUSER3;
+        register8_t ASYNCUSER4;
+        register8_t ASYNCUSER5;
+        register8_t ASYNCUSER6;
+        register8_t ASYNCUSER7;
+        register8_t ASYNCUSER8;
+        register8_t ASYNCUSER9;
+        register8_t ASYNCUSER10;
+        register8_t reserved_3[5];
+        register8_t SYNCUSER0;
+        register8_t SYNCUSER1;
+    } EVSYS_t;
+
+    #define EVSYS_SYNCCH0_OFF_gc (0x00<<0)
+    #define EVSYS_SYNCCH0_TCB0_gc (0x01<<0)
+    #define EVSYS_SYNCCH0_TCA0_OVF_LUNF_gc (0x02<<0)
+    #define EVSYS_ASYNCUSER0_OFF_gc (0x00<<0)
+    #define EVSYS_ASYNCUSER0_SYNCCH0_gc (0x01<<0)
+
+    /* Configuration change protection */
+    #define CCP_SPM_gc (0x9D<<0)
+    #define CCP_IOREG_gc (0xD8<<0)
+
+    /* Status register */
+    #define CPU_I_bm 0x80
+    #define CPU_I_bp 7
+
+    /* EEPROM geometry (ATtiny402) */
+    #define EEPROM_START (0x1400)
+    #define EEPROM_SIZE (128)
+    #define EEPROM_PAGE_SIZE (32)
+
+    extern register8_t CCP;
+    extern register8_t SREG;
+
+    extern PORT_t host_porta;
+    extern PORTMUX_t PORTMUX;
+    extern CLKCTRL_t CLKCTRL;
+    extern RSTCTRL_t RSTCTRL;
+    extern SLPCTRL_t SLPCTRL;
+    extern SPI_t SPI0;
+    extern ADC_t ADC0;
+    extern VREF_t VREF;
+    extern TCA_t TCA0;
+    extern TCB_t TCB0;
+    extern EVSYS_t EVSYS;
+
+    PORT_t *host_port(void);
+
+    /**
+     * @def PORTA
+     * @brief Virtual I/O port A.
+     *
+     * @details
+     * Every access is routed through `host_port()`, which synchronizes the input register with the pin levels of the environment and accounts the polling time on the virtual clock. This allows busy polling loops like `while(PORTA.IN & SWITCH)` to make progress in virtual time.
+     */
+    #define PORTA (*host_port())
+
+    #define SPI0_CTRLA SPI0.CTRLA
+    #define SPI0_CTRLB SPI0.CTRLB
+    #define SPI0_INTCTRL SPI0.INTCTRL
+    #define SPI0_INTFLAGS SPI0.INTFLAGS
+    #define SPI0_DATA SPI0.DATA
+
+#endif /* HOST_AVR_IO_H_ */
@@ -0,0 +1,42 @@
+/**
+ * @file sleep.h
+ * @brief Host replacement for `<avr/sleep.h>`.
+ *
+ * The sleep mode is stored in the virtual `SLPCTRL` register. Executing `sleep_cpu()` hands control to the host backend which decides how long the virtual device stays asleep.
+ *
+ * @author g.raf
+ * @date 2026-10-17
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger embedded systems project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/rcc "RCC - RGB LED Color Cube"
+ */
+
+#ifndef HOST_AVR_SLEEP_H_
+#define HOST_AVR_SLEEP_H_
+
+    #include <avr/io.h>
+
+    #define SLEEP_MODE_IDLE SLPCTRL_SMODE_IDLE_gc
+    #define SLEEP_MODE_STANDBY SLPCTRL_SMODE_STDBY_gc
+    #define SLEEP_MODE_PWR_DOWN SLPCTRL_SMODE_PDOWN_gc
+
+    void host_sleep(void);
+    void host_sleep_hint(unsigned long ticks);
+
+    #define set_sleep_mode(mode) do { SLPCTRL.CTRLA = (SLPCTRL.CTRLA & ~SLPCTRL_SMODE_gm) | (mode); } while(0)
+    #define sleep_enable() do { SLPCTRL.CTRLA |= SLPCTRL_SEN_bm; } while(0)
+    #define sleep_disable() do { SLPCTRL.CTRLA &= ~SLPCTRL_SEN_bm; } while(0)
+    #define sleep_cpu() host_sleep()
+
+    /**
+     * @def sleep_hint
+     * @brief Host extension: the next `ticks` systicks have no work for the firmware (see `host_sleep_hint()`).
+     */
+    #define sleep_hint(ticks) host_sleep_hint(ticks)
+
+#endif /* HOST_AVR_SLEEP_H_ */
@@ -0,0 +1,35 @@
+/**
+ * @file delay.h
+ * @brief Host replacement for `<util/delay.h>`.
+ *
+ * Busy-wait delays are forwarded to the host backend, which accounts the time on the virtual clock instead of spinning. Like on the target, the busy loops are calculated for `F_CPU` but executed with the current peripheral clock (`CLK_PER`), so the delay is scaled by `F_CPU / CLK_PER` (twice the nominal time with the default `CLKCTRL_PDIV_2X_gc` prescaler).
+ *
+ * @author g.raf
+ * @date 2026-10-17
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger embedded systems project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/rcc "RCC - RGB LED Color Cube"
+ */
+
+#ifndef HOST_UTIL_DELAY_H_
+#define HOST_UTIL_DELAY_H_
+
+    unsigned long host_per_clock(void);
+    void host_delay_ns(unsigned long long ns);
+
+    static inline void _delay_us(double us)
+    {
+        host_delay_ns((unsigned long long)(us * 1000.0 * ((double)F_CPU / (double)host_per_clock())));
+    }
+
+    static inline void _delay_ms(double ms)
+    {
+        host_delay_ns((unsigned long long)(ms * 1000000.0 * ((double)F_CPU / (double)host_per_clock())));
+    }
+
+#endif /* HOST_UTIL_DELAY_H_ */
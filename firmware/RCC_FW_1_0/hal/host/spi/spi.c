@@ -0,0 +1,153 @@
+/**
+ * @file spi.c
+ * @brief Host implementation of the hardware SPI interface.
+ *
+ * This file implements the functions declared in `hal/avr0/spi/spi.h` on top of the virtual `SPI0` register block. Transmitted bytes are forwarded to the host SPI observer and the transfer time derived from the configured SPI clock is accounted on the virtual clock.
+ *
+ * @author g.raf
+ * @date 2026-10-17
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see spi.h for declarations and related information.
+ * @see https://github.com/0x007e/rcc "RCC - RGB LED Color Cube"
+ */
+
+#include "../../avr0/spi/spi.h"
+#include "../host.h"
+
+/**
+ * @brief Initialize the virtual SPI interface in master mode with specified configuration.
+ *
+ * @param direction Specifies the bit order for SPI data transmission (MSB or LSB first).
+ * @param setup Specifies the clock polarity (SPI_Polarity) to configure the clock idle state.
+ * @param sample Specifies the clock phase (SPI_Phase) to configure the clock sampling edge.
+ *
+ * @return Always `SPI_None`, because the virtual `SS` pin can not be pulled low by another master.
+ *
+ * @details
+ * The register values written are identical to the AVR0 implementation, so tools inspecting the virtual register file see the same configuration as the target.
+ */
+SPI_Status spi_init(SPI_Direction direction, SPI_Polarity setup, SPI_Phase sample)
+{
+    PORTMUX.CTRLB &= ~PORTMUX_SPI0_bm;
+    PORTMUX.CTRLB |= SPI_PORTMUX;
+
+    SPI0.CTRLA = SPI_MASTER_bm
+    #ifdef SPI2X_ENABLE
+        | SPI_CLK2X_bm
+    #endif
+
+    #ifdef SPI_CLOCK
+        | SPI_CLOCK
+    #endif
+        | (SPI_DORD_bm & (direction<<SPI_DORD_bp));
+
+    SPI0.CTRLB &= ~SPI_MODE_gm;
+    SPI0.CTRLB |= ((SPI_MODE_1_bm & (setup<<SPI_MODE_1_bp)) | (SPI_MODE_0_bm & (sample<<SPI_MODE_0_bp)));
+
+    #ifdef SPI_SPIE
+        SPI0.INTCTRL |= SPI_IE_bm;
+    #endif
+
+    SPI0.CTRLA |= SPI_ENABLE_bm;
+    SPI_PORT.DIR |= SPI_MOSI | SPI_MISO | SPI_SCK | SPI_SS;
+
+    return SPI_None;
+}
+
+/**
+ * @brief Disable the virtual SPI interface and reset related pins.
+ */
+void spi_disable(void)
+{
+    SPI0.CTRLA &= ~(SPI_MASTER_bm | SPI_ENABLE_bm);
+    SPI0.CTRLB &= ~SPI_MODE_gm;
+
+    SPI_PORT.DIR &= ~(SPI_MOSI | SPI_MISO | SPI_SCK | SPI_SS);
+    SPI_PORT.OUT &= ~(SPI_MOSI | SPI_MISO | SPI_SCK | SPI_SS);
+
+    #ifdef SPI_SPIE
+        SPI0.INTCTRL &= ~SPI_IE_bm;
+    #endif
+
+    PORTMUX.CTRLB &= ~PORTMUX_SPI0_bm;
+    SPI0.INTFLAGS = 0;
+}
+
+/**
+ * @brief Calculate the duration of one byte transfer with the current SPI configuration.
+ *
+ * @return Transfer time of eight SPI clock periods in nanoseconds.
+ */
+static unsigned long long spi_byte_time_ns(void)
+{
+    static const unsigned char prescaler[4] = { 4, 16, 64, 128 };
+    static unsigned long clock;
+    static unsigned char control;
+    static unsigned long long time;
+    unsigned long divider = prescaler[(SPI0.CTRLA & SPI_PRESC_gm)>>1];
+
+    // Recalculate only if the configuration changed
+    if((SPI0.CTRLA == control) && (host_per_clock() == clock) && time)
+    {
+        return time;
+    }
+    control = SPI0.CTRLA;
+    clock = host_per_clock();
+
+    if(control & SPI_CLK2X_bm)
+    {
+        divider >>= 1;
+    }
+    time = (8ULL * divider * 1000000000ULL) / clock;
+
+    return time;
+}
+
+#ifndef SPI_SPIE
+
+    /**
+     * @brief Control the virtual Slave Select (SS) pin.
+     *
+     * @param mode Specifies the SPI select state, either SPI_Enable or SPI_Disable.
+     */
+    void spi_select(SPI_Select mode)
+    {
+        switch(mode)
+        {
+            case SPI_Enable : SPI_PORT.OUT &= ~SPI_SS; break;
+            default         : SPI_PORT.OUT |= SPI_SS;  break;
+        }
+    }
+
+    /**
+     * @brief Transfer a single byte of data over the virtual SPI bus.
+     *
+     * @param data The byte value to be sent via SPI.
+     *
+     * @return `0xFF`, the level of the pulled-up `MISO` line (the LED chain does not drive it).
+     *
+     * @details
+     * The byte is handed to the host backend (and its SPI observer) when the SPI is enabled. The virtual clock advances by the time the hardware would need to shift out eight bits.
+     */
+    unsigned char spi_transfer(unsigned char data)
+    {
+        SPI0.DATA = data;
+
+        if(SPI0.CTRLA & SPI_ENABLE_bm)
+        {
+            host_delay_ns(spi_byte_time_ns());
+            host_spi_sent(data);
+        }
+        SPI0.DATA = 0xFF;
+        SPI0.INTFLAGS |= SPI_IF_bm;
+
+        return SPI0.DATA;
+    }
+
+#endif
@@ -0,0 +1,47 @@
+/**
+ * @file system.c
+ * @brief Host implementation of the system clock initialization.
+ *
+ * This file implements `system_init()` declared in `hal/avr0/system/system.h` on top of the virtual `CLKCTRL` register block. The selected clock source is reported as stable immediately, so the peripheral clock derived by the host backend follows the configuration of the firmware.
+ *
+ * @author g.raf
+ * @date 2026-10-17
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger embedded systems project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/rcc "RCC - RGB LED Color Cube"
+ */
+
+#include "../../avr0/system/system.h"
+#include "../host.h"
+
+/**
+ * @brief Initializes the virtual system clock configuration.
+ *
+ * @details
+ * Writes the same `CLKCTRL` configuration as the AVR0 implementation, including the configuration change protection signature.
+ */
+void system_init(void)
+{
+    CCP = CCP_IOREG_gc;
+    CLKCTRL.MCLKCTRLA = SYSTEM_CLOCK;
+    CLKCTRL.MCLKSTATUS = SYSTEM_CLOCK_BIT;
+
+    #ifdef SYSTEM_PER_CLOCK_PRESCALER
+        CCP = CCP_IOREG_gc;
+        CLKCTRL.MCLKCTRLB = SYSTEM_PER_CLOCK_PRESCALER | CLKCTRL_PEN_bm;
+    #endif
+
+    CCP = CCP_IOREG_gc;
+    #if SYSTEM_CLOCK == CLKCTRL_CLKSEL_OSC20M_gc
+        CLKCTRL.OSC20MCTRLA = CLKCTRL_RUNSTDBY_bm;
+    #elif SYSTEM_CLOCK == CLKCTRL_CLKSEL_OSCULP32K_gc
+        CLKCTRL.OSC32KCTRLA = CLKCTRL_RUNSTDBY_bm;
+    #else
+        #error "No system clock defined"
+    #endif
+}
@@ -0,0 +1,138 @@
+/**
+ * @file jitter.c
+ * @brief Interrupt latency and systick jitter instrumentation for the RCC firmware.
+ *
+ * This source file configures `TCB0` and the event system to timestamp the `TCA0` overflow, accumulates the latency of the systick interrupt and the windows with disabled interrupts.
+ *
+ * @author g.raf
+ * @date 2026-10-17
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger embedded systems project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/rcc "RCC - RGB LED Color Cube"
+ */
+
+#include "jitter.h"
+
+volatile JITTER_Data jitter;
+
+/**
+ * @brief Start the latency measurement.
+ *
+ * @details
+ * Routes the `TCA0` overflow over the synchronous event channel 0 to the capture input of `TCB0`. In frequency measurement mode every overflow copies the counter to `TCB0.CCMP` and restarts it, so `TCB0.CNT` counts the time since the last overflow. The statistics are cleared. Must be called before `TCA0` is started.
+ */
+void jitter_init(void)
+{
+    EVSYS.SYNCCH0 = EVSYS_SYNCCH0_TCA0_OVF_LUNF_gc;
+    EVSYS.ASYNCUSER0 = EVSYS_ASYNCUSER0_SYNCCH0_gc;
+
+    TCB0.CTRLB = TCB_CNTMODE_FRQ_gc;
+    TCB0.EVCTRL = TCB_CAPTEI_bm;
+    TCB0.CTRLA = JITTER_CLOCK | TCB_ENABLE_bm;
+
+    jitter.min = 0xFFFF;
+    jitter.max = 0;
+    jitter.holdoff = 0;
+    jitter.period = 0;
+    jitter.samples = 0;
+    jitter.max_tick = 0;
+
+    for(unsigned char i=0; i < JITTER_Window_Count; i++)
+    {
+        jitter.window[i] = 0;
+    }
+
+    for(unsigned char i=0; i < JITTER_BINS; i++)
+    {
+        jitter.histogram[i] = 0;
+    }
+}
+
+/**
+ * @brief Record the latency of a systick interrupt.
+ *
+ * @param count Value of `TCB0.CNT` read at the entry of the interrupt service routine.
+ * @param tick Current `systick`.
+ *
+ * @details
+ * Must be called from the `TCA0` overflow interrupt. Histogram bins saturate at `0xFFFF`.
+ */
+void jitter_record(unsigned int count, unsigned long tick)
+{
+    unsigned int bin = count >> JITTER_BIN_SHIFT;
+
+    if(bin >= JITTER_BINS)
+    {
+        bin = JITTER_BINS - 1;
+    }
+
+    if(jitter.histogram[bin] != 0xFFFF)
+    {
+        jitter.histogram[bin]++;
+    }
+
+    if(count < jitter.min)
+    {
+        jitter.min = count;
+    }
+
+    if(count > jitter.max)
+    {
+        jitter.max = count;
+        jitter.max_tick = tick;
+    }
+    jitter.holdoff = jitter.max - jitter.min;
+    jitter.period = TCB0.CCMP;
+    jitter.samples++;
+}
+
+/**
+ * @brief Timestamp the start of a window with disabled interrupts.
+ *
+ * @return Value of `TCB0.CNT`, to be passed to `jitter_window_end()`.
+ *
+ * @details
+ * Clears the capture flag of `TCB0` after the counter is read, so a restart of the counter by a `TCA0` overflow within the window can be detected.
+ */
+unsigned int jitter_window_begin(void)
+{
+    unsigned int begin = TCB0.CNT;
+
+    TCB0.INTFLAGS = TCB_CAPT_bm;
+
+    return begin;
+}
+
+/**
+ * @brief Record the length of a window with disabled interrupts.
+ *
+ * @param begin Value returned by `jitter_window_begin()`.
+ * @param window Site of the window.
+ *
+ * @details
+ * Must be called before interrupts are enabled again. If a `TCA0` overflow restarted the counter within the window, the counts up to the restart are taken from `TCB0.CCMP`. Only one restart is accounted for, a window longer than one systick period is recorded too short. Without overflows (e.g. `TCA0` stopped) the 16-bit counter difference is used.
+ */
+void jitter_window_end(unsigned int begin, JITTER_Window window)
+{
+    unsigned int end = TCB0.CNT;
+    unsigned int length;
+
+    if(TCB0.INTFLAGS & TCB_CAPT_bm)
+    {
+        length = end + (TCB0.CCMP - begin);
+    }
+    else
+    {
+        length = (uint16_t)(end - begin);
+    }
+
+    if(length > jitter.window[window])
+    {
+        jitter.window[window] = length;
+    }
+}
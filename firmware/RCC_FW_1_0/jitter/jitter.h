@@ -0,0 +1,113 @@
+/**
+ * @file jitter.h
+ * @brief Interrupt latency and systick jitter instrumentation for the RCC firmware.
+ *
+ * This header declares an optional measurement of the `TCA0` overflow interrupt latency. The free `TCB0` is clocked with the peripheral clock and restarted by every `TCA0` overflow through the event system (frequency measurement mode), so the counter value read at the entry of the systick interrupt is the time since the overflow. The interrupt service routine passes this value to `jitter_record()`, which accumulates the minimum, the maximum and a histogram of the latency.
+ *
+ * The difference between the maximum and the minimum latency is the longest time a systick interrupt was held off beyond its minimum latency (global interrupts disabled, other interrupt service routines, multi-cycle instructions). The measurement is enabled with `ENABLE_JITTER_PROFILE` and the results are kept in the `jitter` variable, which can be read over UPDI or from the simulator.
+ *
+ * The windows in which the firmware runs with disabled interrupts are timestamped with `TCB0` as well: `jitter_window_begin()` and `jitter_window_end()` enclose the bodies of the interrupt service routines, the longest window of every site is kept in `jitter.window`. These windows are recorded whether or not they contain a `TCA0` overflow.
+ *
+ * @note The only `cli` of the firmware is the one in `system_shutdown()`, which is directly followed by the protected write of the software reset (`cli`, `CCP`, `RSTCTRL.SWRR`). There is no code in between that a timestamp could enclose, the window is bounded exactly by `rcc_wcet` (`cli:system_shutdown`). The firmware does not disable interrupts around its EEPROM accesses either, so there is no EEPROM window to enclose. A `cli` inside the library routines is bounded statically by `rcc_wcet` (`cli:<function>` entries) and shows up here as hold-off of the systick if it covers an overflow. The measured windows start at the first `TCB0` read of the site, the interrupt entry and the register saving before it are not included.
+ *
+ * @author g.raf
+ * @date 2026-10-17
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger embedded systems project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/rcc "RCC - RGB LED Color Cube"
+ */
+
+#ifndef JITTER_H_
+#define JITTER_H_
+
+    #ifndef JITTER_BINS
+        /**
+         * @def JITTER_BINS
+         * @brief Number of histogram bins.
+         *
+         * @details
+         * The last bin collects all latencies that exceed the range of the histogram.
+         */
+        #define JITTER_BINS 16
+    #endif
+
+    #ifndef JITTER_BIN_SHIFT
+        /**
+         * @def JITTER_BIN_SHIFT
+         * @brief Width of a histogram bin as power of two `TCB0` counts.
+         *
+         * @details
+         * With the default of `3` a bin covers 8 counts (`0.8 us` at a peripheral clock of `10 MHz`), so the histogram ranges up to `12 us`.
+         */
+        #define JITTER_BIN_SHIFT 3
+    #endif
+
+    #ifndef JITTER_CLOCK
+        /**
+         * @def JITTER_CLOCK
+         * @brief Clock selection of `TCB0`.
+         *
+         * @details
+         * The counter must not overflow within one systick period. With `TCB_CLKSEL_CLKDIV1_gc` a period of `1 ms` at `10 MHz` are 10000 counts.
+         */
+        #define JITTER_CLOCK TCB_CLKSEL_CLKDIV1_gc
+    #endif
+
+    #include <stdint.h>
+    #include <avr/io.h>
+
+    /**
+     * @enum JITTER_Window_t
+     * @brief Firmware sites that run with disabled interrupts.
+     */
+    enum JITTER_Window_t
+    {
+        JITTER_Window_Systick=0,                    /**< Body of the `TCA0` overflow interrupt */
+        JITTER_Window_Port,                         /**< Body of the `PORTA` pin change interrupt */
+        JITTER_Window_Count
+    };
+
+    /**
+     * @typedef JITTER_Window
+     * @brief Alias for enum JITTER_Window_t.
+     */
+    typedef enum JITTER_Window_t JITTER_Window;
+
+    /**
+     * @struct JITTER_Data_t
+     * @brief Accumulated latency of the systick interrupt in `TCB0` counts.
+     *
+     * @details
+     * The layout is fixed (16 and 32-bit little endian values, no padding) to allow the readout of the raw memory over UPDI.
+     */
+    struct JITTER_Data_t
+    {
+        uint16_t min;                               /**< Shortest latency */
+        uint16_t max;                               /**< Longest latency */
+        uint16_t holdoff;                           /**< Longest delay of a systick interrupt beyond the shortest latency (`max - min`) */
+        uint16_t period;                            /**< Counts of the last systick period */
+        uint32_t samples;                           /**< Number of recorded interrupts */
+        uint32_t max_tick;                          /**< `systick` at the longest latency */
+        uint16_t window[JITTER_Window_Count];       /**< Longest window with disabled interrupts per site */
+        uint16_t histogram[JITTER_BINS];            /**< Latencies per bin (`count >> JITTER_BIN_SHIFT`) */
+    };
+
+    /**
+     * @typedef JITTER_Data
+     * @brief Alias for struct JITTER_Data_t.
+     */
+    typedef struct JITTER_Data_t JITTER_Data;
+
+    extern volatile JITTER_Data jitter;
+
+    void jitter_init(void);
+    void jitter_record(unsigned int count, unsigned long tick);
+    unsigned int jitter_window_begin(void);
+    void jitter_window_end(unsigned int begin, JITTER_Window window);
+
+#endif /* JITTER_H_ */
@@ -18,6 +18,8 @@
 
 #include "led.h"
 
+static const unsigned int led_flux[LED_FLUX_LEVELS] = LED_FLUX;
+
 static void led_frame(unsigned char mode, unsigned char red, unsigned char green, unsigned char blue)
 {
 	spi_transfer(mode);
@@ -163,6 +165,61 @@ LED_Data led_status_color(LED_Status status, unsigned char intensity)
     return temp;
 }
 
+static unsigned char led_scale(unsigned char value, unsigned char from, unsigned char to)
+{
+    return (unsigned char)((((unsigned long)value * led_flux[from]) + (led_flux[to]>>1)) / led_flux[to]);
+}
+
+/**
+ * @brief Split the brightness of an LED into the global intensity and the PWM channels with the lowest current.
+ *
+ * @param led Target color and brightness (global intensity and PWM channels as set by the user).
+ *
+ * @return LED data with the same light output at the lowest possible global intensity.
+ *
+ * @details
+ * The global intensity sets the drive current of the channels and the efficacy of the LEDs drops with the current, so a low global intensity with a high PWM needs less current for the same light than a high global intensity with a low PWM. The function selects the lowest global intensity (not below `LED_MIN_INTENSITY`) at which the brightest channel still reaches its light output with a PWM of `255` and scales all channels by the ratio of the light outputs (`LED_FLUX`, generated from the energy model). The ratio of the channels and thereby the hue is kept.
+ *
+ * @note LEDs that are off or already at the lowest global intensity are returned unchanged.
+ */
+LED_Data led_balance(LED_Data led)
+{
+    unsigned char peak = led.red;
+    unsigned char level = LED_MIN_INTENSITY;
+    unsigned long light;
+
+    if(led.green > peak)
+    {
+        peak = led.green;
+    }
+
+    if(led.blue > peak)
+    {
+        peak = led.blue;
+    }
+
+    if(!peak || (led.intensity <= LED_MIN_INTENSITY) || (led.intensity >= LED_FLUX_LEVELS))
+    {
+        return led;
+    }
+    light = (unsigned long)peak * led_flux[led.intensity];
+
+    while((level < led.intensity) && (light > (255UL * led_flux[level])))
+    {
+        level++;
+    }
+
+    if(level < led.intensity)
+    {
+        led.red = led_scale(led.red, led.intensity, level);
+        led.green = led_scale(led.green, led.intensity, level);
+        led.blue = led_scale(led.blue, led.intensity, level);
+        led.intensity = level;
+    }
+
+    return led;
+}
+
 static void led_delay(LED_Delay delay)
 {
     switch (delay)
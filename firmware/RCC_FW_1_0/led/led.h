@@ -126,6 +126,7 @@
     #include <util/delay.h>
 
     #include "../hal/avr0/spi/spi.h"
+    #include "led_flux.h"
 
     /**
      * @enum LED_Status_t
@@ -176,13 +177,14 @@
      * @brief Defines LED position flags and alternating blinking modes.
      *
      * @details
-     * This enumeration specifies individual LED positions and options for alternating blinking patterns. Positions include left and right LEDs, as well as flags for alternating blink sequences.
+     * This enumeration specifies individual LED positions and options for alternating blinking patterns. Positions include left and right LEDs, both LEDs linked together (`LED_Position_Left | LED_Position_Right`), as well as flags for alternating blink sequences.
      */
     enum LED_Position_t
     {
         LED_Position_None=0x00,
         LED_Position_Left=0x01,
         LED_Position_Right=0x02,
+        LED_Position_Linked=0x03,
         LED_Position_Left_Alternating=0x04,
         LED_Position_Right_Alternating=0x08,
     };
@@ -239,6 +241,7 @@
     void leds_off(void);
 
     LED_Data led_status_color(LED_Status status, unsigned char intensity);
+    LED_Data led_balance(LED_Data led);
     void led_color(LED_Position position, LED_Data color);
     void led_blink(LED_Position position, LED_Data color, LED_Delay delay, unsigned char repeat);
 
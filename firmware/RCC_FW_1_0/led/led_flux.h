@@ -0,0 +1,41 @@
+/**
+ * @file led_flux.h
+ * @brief Relative light output of an LED channel per global intensity level.
+ *
+ * Generated by `make ledflux` (`rcc_energy -t`) from the LED model of the energy estimate with `ENERGY_LED_DROOP` 0.30, do not edit. The values are scaled to `65535` at the full global intensity.
+ *
+ * @note `ENERGY_LED_DROOP` is an assumed efficacy loss, not measured on the LEDs or taken from their datasheet. The model takes the channel current as linear in PWM times global intensity and lets only the light output drop with the intensity, so the savings of `led_balance()` hold only if the real LEDs droop the same way (`ENABLE_LED_BALANCE` is not defined by default).
+ *
+ * @author g.raf
+ * @date 2026-10-17
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger embedded systems project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/rcc "RCC - RGB LED Color Cube"
+ */
+
+#ifndef LED_FLUX_H_
+#define LED_FLUX_H_
+
+    /**
+     * @def LED_FLUX_LEVELS
+     * @brief Number of global intensity levels in `LED_FLUX`.
+     */
+    #define LED_FLUX_LEVELS 32
+
+    /**
+     * @def LED_FLUX
+     * @brief Initializer of the light output table, indexed by the global intensity level.
+     */
+    #define LED_FLUX { \
+            0,  2722,  5392,  8012, 10583, 13107, 15585, 18017, \
+        20406, 22753, 25058, 27322, 29548, 31735, 33885, 35998, \
+        38076, 40120, 42130, 44107, 46052, 47965, 49848, 51702, \
+        53526, 55322, 57090, 58831, 60545, 62233, 63897, 65535 \
+    }
+
+#endif /* LED_FLUX_H_ */
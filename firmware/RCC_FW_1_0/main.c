@@ -20,6 +20,17 @@
 
 static unsigned int switch_count = 0UL;
 
+// Defined first, so the scratch cell and the schedule follow the other EEMEM variables and do not move them
+// Cell without content for write tests (self-test, perf command), its value is restored after every test
+uint8_t EEMEM ee_scratch = 0xFF;
+
+UI_Dim EEMEM ee_dim = {
+	DIM_DELAY_MIN,
+	DIM_STEP_S,
+	DIM_FLOOR_INTENSITY,
+	DIM_PWM_SHIFT
+};
+
 char EEMEM description[] = "RCC Firmware v1.0 by";
 char EEMEM author[] = "R. GAECHTER";
 char EEMEM copyright[] = "Copyright 2025 g.raf engineering";
@@ -39,6 +50,11 @@ LED_Data EEMEM ee_led2  = {
 	0xFF
 };
 
+#ifdef ENABLE_USAGE_STATS
+	// The EEMEM image starts at address 0, the statistics record at the end of the EEPROM must not overlap it
+	_Static_assert((sizeof(ee_scratch) + sizeof(ee_dim) + sizeof(description) + sizeof(author) + sizeof(copyright) + sizeof(github) + sizeof(ee_led1) + sizeof(ee_led2)) <= STATS_EEPROM_ADDRESS, "EEMEM variables overlap STATS_EEPROM");
+#endif
+
 LED_Data led1, led2;
 
 /**
@@ -46,11 +62,19 @@ LED_Data led1, led2;
  *
  * This ISR handles the interrupt triggered by an event on PORTA pins. In this implementation, it only clears the interrupt flag for PIN7 on PORTA to acknowledge and allow further interrupts. This prevents the interrupt from continuously retriggering.
  *
- * @note The ISR is registered for the PORTA interrupt vector and is executed automatically upon the corresponding hardware interrupt and is necessary for system wakeup after deep sleep.
+ * @note The ISR is registered for the PORTA interrupt vector and is executed automatically upon the corresponding hardware interrupt and is necessary for system wakeup after deep sleep and for the immediate wakeup from idle sleep on a button press.
  */
 ISR(PORTA_PORT_vect)
 {	
+    #ifdef ENABLE_JITTER_PROFILE
+        unsigned int window = jitter_window_begin();
+    #endif
+
 	PORTA.INTFLAGS = PORT_INT_7_bm;
+
+    #ifdef ENABLE_JITTER_PROFILE
+        jitter_window_end(window, JITTER_Window_Port);
+    #endif
 }
 
 volatile unsigned long systick;
@@ -58,28 +82,38 @@ volatile unsigned long systick;
 /**
  * @brief Timer/Counter Overflow Interrupt Service Routine.
  *
- * This ISR is called when the Timer/Counter overflows. It increments the global millisecond tick counter `systick` used for system timing. The interrupt flag for the overflow is cleared to allow subsequent interrupts.
+ * This ISR is called when the Timer/Counter overflows. It increments the global millisecond tick counter `systick` used for system timing. The interrupt flag for the overflow is cleared to allow subsequent interrupts. With `ENABLE_JITTER_PROFILE` the latency of the interrupt is recorded first and the body is recorded as window with disabled interrupts.
  *
  * @note Ensure the timer is properly configured and overflow interrupts are enabled for this routine to be executed correctly.
  */
 ISR(TCA0_OVF_vect)
 {
+    #ifdef ENABLE_JITTER_PROFILE
+        unsigned int window = jitter_window_begin();
+
+        jitter_record(window, systick);
+    #endif
+
     systick++;
 	TCA0.SINGLE.INTFLAGS = TCA_SINGLE_OVF_bm;
+
+    #ifdef ENABLE_JITTER_PROFILE
+        jitter_window_end(window, JITTER_Window_Systick);
+    #endif
 }
 
 /**
  * @brief Initializes Timer/Counter in single mode with overflow interrupt.
  *
- * This function configures the TCA0 timer as a 16-bit timer operating in single mode. It sets the overflow interrupt enable bit, loads the period register with a predefined value, and starts the timer with a clock prescaler of divide-by-8.
+ * This function configures the TCA0 timer as a 16-bit timer operating in single mode. It sets the overflow interrupt enable bit, loads the period register for a 1 ms overflow, and starts the timer with a clock prescaler of divide-by-8.
  *
  * @details
- * The timer will generate an interrupt when the counter overflows at the value in the PER register. The overflow interrupt is enabled to allow time-based events or system ticks. The clock source selection and enabling the timer starts the counting immediately.
+ * The timer will generate an interrupt when the counter overflows at the value in the PER register. The overflow interrupt is enabled to allow time-based events or system ticks. The clock source selection and enabling the timer starts the counting immediately. The period is derived from `SYSTEM_PER_CLOCK` (`0x04E1` at 10 MHz), so `systick` keeps counting milliseconds with any `SYSTEM_PER_CLOCK_PRESCALER`.
  */
 static void timer_init(void)
 {	
 	TCA0.SINGLE.INTCTRL |= TCA_SINGLE_OVF_bm;
-	TCA0.SINGLE.PER = 0x04E1;
+	TCA0.SINGLE.PER = (uint16_t)((SYSTEM_PER_CLOCK / 8000UL) - 1UL);
 	TCA0.SINGLE.CTRLA |= TCA_SINGLE_CLKSEL_DIV8_gc | TCA_SINGLE_ENABLE_bm;
 }
 
@@ -115,6 +149,10 @@ static void timer_disable(void)
  */
 static void system_shutdown(void)
 {
+    #ifdef ENABLE_USAGE_STATS
+        stats_flush();
+    #endif
+
     // System Shutdown
     timer_disable();
     battery_disable();
@@ -142,165 +180,712 @@ static void system_shutdown(void)
     RSTCTRL.SWRR = RSTCTRL_SWRE_bm;
 }
 
+#ifdef ENABLE_SELFTEST
+
+/**
+ * @brief Wait in idle sleep for a number of systicks.
+ *
+ * @details
+ * Timed by `systick` instead of `_delay_ms()`, so the self-test takes the same time with every `SYSTEM_PER_CLOCK_PRESCALER`.
+ */
+static void selftest_wait(unsigned int ms)
+{
+    unsigned long start = systick;
+
+    set_sleep_mode(SLEEP_MODE_IDLE);
+
+    while((systick - start) < ms)
+    {
+        sleep_enable();
+        sleep_cpu();
+        sleep_disable();
+    }
+}
+
+static void selftest_blink(LED_Data color, unsigned char count)
+{
+    for(unsigned char i=0; i < count; i++)
+    {
+        led_color(LED_Position_Left | LED_Position_Right, color);
+        selftest_wait(SELFTEST_BLINK_MS);
+        leds_off();
+        selftest_wait(SELFTEST_BLINK_MS);
+    }
+}
+
+/**
+ * @brief Run the accelerated production self-test.
+ *
+ * @details
+ * All steps are timed by `systick`, a pass takes about 1.5 s on the device (at most 1.85 s with a failure):
+ * - Every color channel of both LEDs at full (`LED_MAX_INTENSITY`) and at the lowest global intensity, `SELFTEST_STEP_MS` each
+ * - Sleep of the LED chain (`LED_SLEEP_FLAG`), the LEDs go dark for `SELFTEST_STEP_MS` and come back white after `led_init()`, and wake-up of the core from idle sleep by the systick
+ * - LED records in the EEPROM programmed and a write/read-back of the complement of `ee_scratch`, the original value is restored
+ * - Battery measurement, reported as up to `SELFTEST_BATTERY_BLINKS` blue blinks (one per `SELFTEST_BATTERY_STEP` above `BATTERY_EMPTY_VALUE`)
+ *
+ * A pass is shown green, a failure as the number of red blinks given by `SELFTEST_Result` followed by red. The function returns when the button is released, so the held button does not switch the cube off.
+ *
+ * @note `systick` must be running and interrupts must be enabled.
+ */
+static void system_selftest(void)
+{
+    SELFTEST_Result result = SELFTEST_Result_Pass;
+    LED_Data color;
+    LED_Data check;
+    unsigned int value;
+    unsigned long tick;
+    uint8_t cell;
+
+    // LEDs: red, green and blue at full and at minimum brightness
+    for(unsigned char channel=0; channel < 3; channel++)
+    {
+        for(unsigned char level=0; level < 2; level++)
+        {
+            color.intensity = level ? LED_MIN_INTENSITY : LED_MAX_INTENSITY;
+            color.red = (channel == 0) ? 0xFF : 0x00;
+            color.green = (channel == 1) ? 0xFF : 0x00;
+            color.blue = (channel == 2) ? 0xFF : 0x00;
+
+            led_color(LED_Position_Left | LED_Position_Right, color);
+            selftest_wait(SELFTEST_STEP_MS);
+        }
+    }
+
+    // Sleep: the LED chain goes dark and comes back after a new enable frame, the next systick must wake the core
+    led_disable();
+    selftest_wait(SELFTEST_STEP_MS);
+    led_init();
+
+    color.red = 0xFF;
+    color.green = 0xFF;
+    led_color(LED_Position_Left | LED_Position_Right, color);
+    selftest_wait(SELFTEST_STEP_MS);
+    leds_off();
+
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    sleep_enable();
+    tick = systick;
+    sleep_cpu();
+    sleep_disable();
+
+    if(systick == tick)
+    {
+        result = SELFTEST_Result_Sleep;
+    }
+
+    // EEPROM: programmed LED records and write/read-back of a cell with a known value
+    eeprom_read_block(&check, &ee_led1, sizeof(LED_Data));
+
+    if(check.intensity > LED_MAX_INTENSITY)
+    {
+        result = SELFTEST_Result_EEPROM;
+    }
+    eeprom_read_block(&check, &ee_led2, sizeof(LED_Data));
+
+    if(check.intensity > LED_MAX_INTENSITY)
+    {
+        result = SELFTEST_Result_EEPROM;
+    }
+    cell = eeprom_read_byte(&ee_scratch);
+    eeprom_write_byte(&ee_scratch, (uint8_t)~cell);
+
+    if(eeprom_read_byte(&ee_scratch) != (uint8_t)~cell)
+    {
+        result = SELFTEST_Result_EEPROM;
+    }
+    eeprom_write_byte(&ee_scratch, cell);
+
+    if(eeprom_read_byte(&ee_scratch) != cell)
+    {
+        result = SELFTEST_Result_EEPROM;
+    }
+
+    // Battery: blink code of the ADC result
+    battery_init();
+    value = battery_value();
+    battery_disable();
+
+    if(value < BATTERY_EMPTY_VALUE)
+    {
+        result = SELFTEST_Result_Battery;
+    }
+    else
+    {
+        value = 1 + ((value - BATTERY_EMPTY_VALUE) / SELFTEST_BATTERY_STEP);
+        color.intensity = LED_MIN_INTENSITY;
+        color.red = 0x00;
+        color.green = 0x00;
+        color.blue = 0xFF;
+
+        selftest_blink(color, (value > SELFTEST_BATTERY_BLINKS) ? SELFTEST_BATTERY_BLINKS : (unsigned char)value);
+    }
+
+    if(result == SELFTEST_Result_Pass)
+    {
+        led_color(LED_Position_Left | LED_Position_Right, led_status_color(LED_Status_Ready, LED_MAX_INTENSITY));
+    }
+    else
+    {
+        selftest_blink(led_status_color(LED_Status_Error, LED_MAX_INTENSITY), result);
+        led_color(LED_Position_Left | LED_Position_Right, led_status_color(LED_Status_Error, LED_MAX_INTENSITY));
+    }
+    selftest_wait(SELFTEST_RESULT_MS);
+    leds_off();
+
+    while(PORTA.IN & SWITCH);
+}
+
+#endif
+
 static unsigned long last_button_press;
 static unsigned char execute_command;
 
+static UI_State ui_state = UI_State_Idle;
+static UI_Blink ui_blink;
+static LED_Position ui_position;
+static unsigned char ui_button;
+static unsigned char ui_render = 1;
+static unsigned char ui_step;
+static unsigned long ui_time;
+static unsigned long ui_edge;
+static UI_Dim ui_dim;
+static unsigned char ui_dim_level;
+static unsigned long ui_dim_time;
+static unsigned char ui_intensity;
+
+/**
+ * @brief Start a non-blocking LED blink.
+ *
+ * @param position Bitwise flags indicating LED positions and blinking modes to be used.
+ * @param color The color and intensity to blink on the LEDs.
+ * @param delay Duration of a blink phase.
+ * @param repeat The number of times to repeat the blink sequence.
+ *
+ * @details
+ * Shows the first phase immediately. The blink is advanced by `ui_blink_update()` and takes `2 * (repeat + 1)` phases like `led_blink()`.
+ */
+static void ui_blink_start(LED_Position position, LED_Data color, LED_Delay delay, unsigned char repeat)
+{
+    ui_blink.position = position;
+    ui_blink.color = color;
+    ui_blink.period = (unsigned int)(UI_BLINK_UNIT_MS * delay);
+    ui_blink.phases = (repeat + 1)<<1;
+    ui_blink.phase = 0;
+    ui_blink.start = systick;
+
+    led_color((position & (LED_Position_Left | LED_Position_Right)), color);
+}
+
+/**
+ * @brief Advance the running LED blink.
+ *
+ * @return `1` while the blink is running, `0` when it is finished.
+ *
+ * @details
+ * Sends a frame only when the phase changes. After the last phase all LEDs are switched off.
+ */
+static unsigned char ui_blink_update(void)
+{
+    if(ui_blink.phase >= ui_blink.phases)
+    {
+        return 0;
+    }
+
+    if((systick - ui_blink.start) < ui_blink.period)
+    {
+        return 1;
+    }
+    ui_blink.start += ui_blink.period;
+    ui_blink.phase++;
+
+    if(ui_blink.phase >= ui_blink.phases)
+    {
+        leds_off();
+        return 0;
+    }
+
+    if(ui_blink.phase & 0x01)
+    {
+        led_color((ui_blink.position & (LED_Position_Left_Alternating | LED_Position_Right_Alternating)), ui_blink.color);
+    }
+    else
+    {
+        led_color((ui_blink.position & (LED_Position_Left | LED_Position_Right)), ui_blink.color);
+    }
+    return 1;
+}
+
+/**
+ * @brief Prepare LED data for the output.
+ *
+ * @param led LED data as set by the user.
+ *
+ * @return LED data with the current-efficient brightness split if `ENABLE_LED_BALANCE` is defined.
+ */
+static LED_Data ui_output(LED_Data led)
+{
+    #ifdef ENABLE_LED_BALANCE
+        return led_balance(led);
+    #else
+        return led;
+    #endif
+}
+
+/**
+ * @brief Get the channel of an LED that is changed by the current command.
+ *
+ * @param led LED data.
+ *
+ * @return Pointer to the channel (`2` red, `3` green, `4` blue, `5` intensity).
+ */
+static unsigned char *ui_channel(LED_Data *led)
+{
+    switch (execute_command)
+    {
+        case 2:
+            return &led->red;
+        case 3:
+            return &led->green;
+        case 4:
+            return &led->blue;
+        default:
+            return &led->intensity;
+    }
+}
+
+/**
+ * @brief Execute one step of the color ramp of the current command.
+ *
+ * @details
+ * Changes the channel of the selected LED and shows the LED. If both LEDs are linked, the left LED is ramped and the right LED takes over the channel, so both LEDs end up with the same value in one pass.
+ */
+static void ui_adjust(void)
+{
+    LED_Data *led = (ui_position == LED_Position_Right) ? &led2 : &led1;
+    unsigned char *channel = ui_channel(led);
+
+    (*channel)++;
+
+    if((execute_command == 5) && (*channel > LED_MAX_INTENSITY))
+    {
+        *channel = LED_MIN_INTENSITY;
+    }
+
+    if(ui_position == LED_Position_Linked)
+    {
+        *ui_channel(&led2) = *channel;
+
+        LED_SOF();
+        led_data(ui_output(led1));
+        led_data(ui_output(led2));
+        LED_EOF();
+    }
+    else
+    {
+        led_color(ui_position, ui_output(*led));
+    }
+}
+
+/**
+ * @brief Apply the current dimming level to an LED.
+ *
+ * @param led LED data as set by the user.
+ *
+ * @return LED data to show.
+ *
+ * @details
+ * The first levels lower the intensity down to the floor of the schedule, the following levels halve the color channels up to the configured number of PWM steps. The intensity of an LED that is already below the floor is not raised.
+ */
+static LED_Data ui_dimmed(LED_Data led)
+{
+    unsigned char level = ui_dim_level;
+
+    if(led.intensity > ui_dim.floor)
+    {
+        if(level <= (led.intensity - ui_dim.floor))
+        {
+            led.intensity -= level;
+            return led;
+        }
+        level -= led.intensity - ui_dim.floor;
+        led.intensity = ui_dim.floor;
+    }
+
+    if(level > ui_dim.pwm)
+    {
+        level = ui_dim.pwm;
+    }
+    led.red >>= level;
+    led.green >>= level;
+    led.blue >>= level;
+
+    return led;
+}
+
+/**
+ * @brief Get the last dimming level that still changes one of the LEDs.
+ */
+static unsigned char ui_dim_end(void)
+{
+    unsigned char intensity = (led1.intensity > led2.intensity) ? led1.intensity : led2.intensity;
+
+    return ((intensity > ui_dim.floor) ? (intensity - ui_dim.floor) : 0) + ui_dim.pwm;
+}
+
+/**
+ * @brief Show both LEDs with the current dimming level.
+ */
+static void ui_show(void)
+{
+    LED_Data left = ui_dimmed(led1);
+    LED_Data right = ui_dimmed(led2);
+
+    LED_SOF();
+    led_data(ui_output(left));
+    led_data(ui_output(right));
+    LED_EOF();
+
+    ui_intensity = (left.intensity > right.intensity) ? left.intensity : right.intensity;
+}
+
+/**
+ * @brief Get the number of systicks until `ui_task()` has work again.
+ *
+ * @return `0` if the next systick may have work, otherwise the systicks until the next command, dimming step or `UI_IDLE_MAX_TICKS`.
+ *
+ * @details
+ * Only the idle user interface without a held button is quiet, every other state runs its blinks and ramps on every systick.
+ */
+static unsigned long ui_idle_ticks(void)
+{
+    unsigned long ticks = UI_IDLE_MAX_TICKS;
+    unsigned long elapsed;
+    unsigned long period;
+
+    if((ui_state != UI_State_Idle) || ui_button || ui_render)
+    {
+        return 0;
+    }
+
+    if(switch_count > 0)
+    {
+        elapsed = systick - last_button_press;
+        period = SWITCH_COMMAND_EXECUTE_MS + 1UL;
+        ticks = (elapsed < period) ? (period - elapsed) : 0;
+    }
+
+    if(ui_dim.delay && (ui_dim_level < ui_dim_end()))
+    {
+        elapsed = systick - ui_dim_time;
+        period = ui_dim_level ? (1000UL * ui_dim.step) : (60000UL * ui_dim.delay);
+
+        if((elapsed < period) && ((period - elapsed) < ticks))
+        {
+            ticks = period - elapsed;
+        }
+        else if(elapsed >= period)
+        {
+            ticks = 0;
+        }
+    }
+    return ticks;
+}
+
+/**
+ * @brief Execute one step of the button user interface.
+ *
+ * @details
+ * Samples the switch and advances the state machine without blocking. Commands are entered with multiple short presses: after `SWITCH_COMMAND_EXECUTE_MS` without a press the left LED is selected and blinks, every press moves the selection to the right LED, to both LEDs linked together and back to the left LED. Once the selected LED has blinked without a press for `SWITCH_COMMAND_EXECUTE_MS`, its channel is ramped until the next press and the LED is stored in the EEPROM. Holding the switch for `SWITCH_SYSTEM_OFF_TIME_MS` shuts the system down.
+ *
+ * After `ui_dim.delay` minutes without a press the idle LEDs are dimmed by one level every `ui_dim.step` seconds, the next press restores the set brightness.
+ *
+ * @note Must be called at least once per systick, `systick` must be running.
+ */
+static void ui_task(void)
+{
+    unsigned char button = PORTA.IN & SWITCH;
+    unsigned char pressed = 0;
+
+    // Edges within SWITCH_DEBOUNCE_MS of the last accepted press or release are contact bounce
+    if((button != ui_button) && ((systick - ui_edge) >= SWITCH_DEBOUNCE_MS))
+    {
+        ui_edge = systick;
+        pressed = (button != 0);
+    }
+    ui_button = button;
+
+    if(button)
+    {
+        ui_dim_time = systick;
+    }
+
+    switch (ui_state)
+    {
+        case UI_State_Idle:
+            if(pressed || (button && ((systick - ui_edge) >= SWITCH_DEBOUNCE_MS)))
+            {
+                // Restore the set brightness on the press edge, not only after the release
+                if(ui_dim_level)
+                {
+                    ui_dim_level = 0;
+                    ui_show();
+                }
+                ui_blink_start(LED_Position_Left | LED_Position_Right_Alternating, led_status_color(LED_Status_Ready, LED_MIN_INTENSITY), LED_Delay_MS_100, 0);
+                switch_count++;
+                ui_state = UI_State_Press;
+            }
+            else if((switch_count > 0) && ((systick - last_button_press) > SWITCH_COMMAND_EXECUTE_MS))
+            {
+                #ifdef ENABLE_PERF_COMMAND
+                    if(switch_count == PERF_COMMAND)
+                    {
+                        perf_run(&ee_scratch);
+                        ui_step = 0;
+                        ui_state = UI_State_Perf;
+                        switch_count = 0;
+                    }
+                #endif
+
+                if(switch_count > 1)
+                {
+                    execute_command = switch_count;
+                    ui_position = LED_Position_Left;
+                    ui_blink_start(ui_position, led_status_color(LED_Status_Ready, LED_MIN_INTENSITY), LED_Delay_MS_500, 1);
+                    ui_state = UI_State_Select;
+                }
+                switch_count = 0;
+            }
+            else if(ui_render)
+            {
+                ui_show();
+                ui_render = 0;
+            }
+            else if(ui_dim.delay && (ui_dim_level < ui_dim_end()) && ((systick - ui_dim_time) >= (ui_dim_level ? (1000UL * ui_dim.step) : (60000UL * ui_dim.delay))))
+            {
+                ui_dim_time = systick;
+                ui_dim_level++;
+                ui_show();
+            }
+            break;
+
+        case UI_State_Press:
+            if(!ui_blink_update())
+            {
+                last_button_press = systick;
+                ui_state = UI_State_Hold;
+            }
+            break;
+
+        case UI_State_Hold:
+            if(!button)
+            {
+                ui_render = 1;
+                ui_state = UI_State_Idle;
+            }
+            else if((systick - last_button_press) > SWITCH_SYSTEM_OFF_TIME_MS)
+            {
+                ui_blink_start(LED_Position_Left | LED_Position_Right_Alternating, led_status_color(LED_Status_Ready, LED_MIN_INTENSITY), LED_Delay_MS_500, 0);
+                ui_step = 0;
+                ui_state = UI_State_Off;
+            }
+            break;
+
+        case UI_State_Select:
+            if(pressed)
+            {
+                // Left, right, both linked and left again
+                ui_position = (ui_position == LED_Position_Linked) ? LED_Position_Left : (LED_Position)(ui_position + 1);
+                last_button_press = systick;
+                ui_blink_start(ui_position, led_status_color(LED_Status_Ready, LED_MIN_INTENSITY), LED_Delay_MS_500, 1);
+            }
+            else if(!ui_blink_update())
+            {
+                if((systick - last_button_press) < SWITCH_COMMAND_EXECUTE_MS)
+                {
+                    ui_blink_start(ui_position, led_status_color(LED_Status_Ready, LED_MIN_INTENSITY), LED_Delay_MS_500, 1);
+                }
+                else if(execute_command <= 5)
+                {
+                    ui_adjust();
+                    ui_time = systick;
+                    ui_state = UI_State_Adjust;
+                }
+                else
+                {
+                    ui_blink_start(LED_Position_Left | LED_Position_Right, led_status_color(LED_Status_Error, LED_MIN_INTENSITY), LED_Delay_MS_500, 4);
+                    ui_state = UI_State_Error;
+                }
+            }
+            break;
+
+        case UI_State_Adjust:
+            if(pressed)
+            {
+                #ifdef ENABLE_EEPROM_WRITE
+                    // Linked LEDs are stored together in a single commit
+                    if(ui_position & LED_Position_Left)
+                    {
+                        eeprom_write_block(&led1, &ee_led1, sizeof(LED_Data));
+                    }
+
+                    if(ui_position & LED_Position_Right)
+                    {
+                        eeprom_write_block(&led2, &ee_led2, sizeof(LED_Data));
+                    }
+                #endif
+
+                #ifdef ENABLE_USAGE_STATS
+                    stats_adjustment(execute_command);
+                #endif
+
+                ui_blink_start(LED_Position_Left | LED_Position_Right_Alternating, led_status_color(LED_Status_Ready, LED_MIN_INTENSITY), LED_Delay_MS_500, 2);
+                ui_state = UI_State_Commit;
+            }
+            else if((systick - ui_time) >= ((execute_command == 5) ? COLOR_INTENSITY_DELAY_MS : COLOR_FADE_DELAY_MS))
+            {
+                ui_time = systick;
+                ui_adjust();
+            }
+            break;
+
+        case UI_State_Error:
+            if(!ui_blink_update())
+            {
+                ui_blink_start(LED_Position_Left | LED_Position_Right_Alternating, led_status_color(LED_Status_Ready, LED_MIN_INTENSITY), LED_Delay_MS_500, 2);
+                ui_state = UI_State_Commit;
+            }
+            break;
+
+        case UI_State_Commit:
+            if(!ui_blink_update())
+            {
+                execute_command = 0;
+                switch_count = 0;
+                ui_render = 1;
+                ui_state = UI_State_Idle;
+            }
+            break;
+
+        case UI_State_Off:
+            if(!ui_blink_update())
+            {
+                // Ready, warning and error blink before the shutdown
+                if(++ui_step > 2)
+                {
+                    system_shutdown();
+                }
+                ui_blink_start(LED_Position_Left | LED_Position_Right_Alternating, led_status_color((LED_Status)(LED_Status_Ready + ui_step), LED_MIN_INTENSITY), LED_Delay_MS_500, 0);
+            }
+            break;
+
+        #ifdef ENABLE_PERF_COMMAND
+            case UI_State_Perf:
+                if(!ui_blink_update())
+                {
+                    // Frame, ADC and EEPROM: green within and red above the budget
+                    if(ui_step > 2)
+                    {
+                        ui_render = 1;
+                        ui_state = UI_State_Idle;
+                    }
+                    else
+                    {
+                        ui_blink_start(LED_Position_Left | LED_Position_Right, led_status_color((perf.exceeded & (1<<ui_step)) ? LED_Status_Error : LED_Status_Ready, LED_MIN_INTENSITY), LED_Delay_MS_100, 0);
+                        ui_step++;
+                    }
+                }
+                break;
+        #endif
+
+        default:
+            ui_state = UI_State_Idle;
+            break;
+    }
+}
+
 int main(void)
 {
+    // Reset flags are cleared by writing them back
+    unsigned char reset_flags = RSTCTRL.RSTFR;
+    unsigned char selftest = 0;
+
+    RSTCTRL.RSTFR = reset_flags;
+
+    #ifdef ENABLE_USAGE_STATS
+        stats_init(reset_flags);
+    #endif
+
     system_init();
     led_init();
 	battery_init();
-	
-    if(battery_status() == BATTERY_Ok)
+
+    #ifdef ENABLE_SELFTEST
+        // Button held while the battery is inserted, a wake-up press ends in a software reset
+        selftest = (reset_flags & RSTCTRL_PORF_bm) && (PORTA.IN & SWITCH);
+    #endif
+
+    if(selftest)
+    {
+        // The boot blink is replaced by the self-test
+    }
+    else if(battery_status() == BATTERY_Ok)
     {
         led_blink(LED_Position_Left | LED_Position_Right_Alternating, led_status_color(LED_Status_Ready, LED_MIN_INTENSITY), LED_Delay_MS_200, 2);
     }
     else
     {
         led_blink(LED_Position_Left | LED_Position_Right_Alternating, led_status_color(LED_Status_Error, LED_MIN_INTENSITY), LED_Delay_MS_200, 2);
+
+        #ifdef ENABLE_USAGE_STATS
+            stats_low_battery();
+        #endif
     }
 
 	battery_disable();
+
+    #ifdef ENABLE_JITTER_PROFILE
+        jitter_init();
+    #endif
+
 	timer_init();
 	sei();
 	
 	// read LED data from EEPROM
     eeprom_read_block(&led1, &ee_led1, sizeof(LED_Data));
     eeprom_read_block(&led2, &ee_led2, sizeof(LED_Data));
-	
-    while (1)
-    {	
-        LED_SOF();
-        led_data(led1);
-        led_data(led2);
-        LED_EOF();
+    eeprom_read_block(&ui_dim, &ee_dim, sizeof(UI_Dim));
 
-		if(PORTA.IN & SWITCH)
-		{
-			led_blink(LED_Position_Left | LED_Position_Right_Alternating, led_status_color(LED_Status_Ready, LED_MIN_INTENSITY), LED_Delay_MS_100, 0);
-			
-			switch_count++;
-			last_button_press = systick;
-			
-			while(PORTA.IN & SWITCH)
-			{
-				if((systick - last_button_press) > SWITCH_SYSTEM_OFF_TIME_MS)
-				{
-					led_blink(LED_Position_Left | LED_Position_Right_Alternating, led_status_color(LED_Status_Ready,   LED_MIN_INTENSITY), LED_Delay_MS_500, 0);
-					led_blink(LED_Position_Left | LED_Position_Right_Alternating, led_status_color(LED_Status_Warning, LED_MIN_INTENSITY), LED_Delay_MS_500, 0);
-					led_blink(LED_Position_Left | LED_Position_Right_Alternating, led_status_color(LED_Status_Error,   LED_MIN_INTENSITY), LED_Delay_MS_500, 0);
-					system_shutdown();
-				}
-			}
-		}
-
-        if((switch_count > 0) && ((systick - last_button_press) > SWITCH_COMMAND_EXECUTE_MS))
+    // Erased or corrupted schedule, a zero step would dim on every systick
+    if((ui_dim.delay == 0xFF) || !ui_dim.step || (ui_dim.floor > LED_MAX_INTENSITY))
+    {
+        ui_dim.delay = DIM_DELAY_MIN;
+        ui_dim.step = DIM_STEP_S;
+        ui_dim.floor = DIM_FLOOR_INTENSITY;
+        ui_dim.pwm = DIM_PWM_SHIFT;
+    }
+
+    #ifdef ENABLE_SELFTEST
+        if(selftest)
         {
-			if(switch_count == 1)
-			{
-				switch_count = 0;
-			}
-			else
-			{
-				execute_command = switch_count;
-				switch_count = 0;
-			}
+            system_selftest();
         }
-		
-		if(execute_command)
-		{	
-			LED_Position position = LED_Position_Left;
-			LED_Data *led;
-			do 
-			{
-				if(position == LED_Position_Left)
-				{
-                    led = &led1;
-                    led_blink(LED_Position_Left, led_status_color(LED_Status_Ready, LED_MIN_INTENSITY), LED_Delay_MS_500, 1);
-				}
-				else
-				{
-    				led = &led2;
-					led_blink(LED_Position_Right, led_status_color(LED_Status_Ready, LED_MIN_INTENSITY), LED_Delay_MS_500, 1);
-				}
-				
-				if(PORTA.IN & SWITCH)
-				{
-					_delay_ms(10);
-
-                    if(position == LED_Position_Left)
-                    {
-                        position = LED_Position_Right;
-                    }
-                    else
-                    {
-                        position = LED_Position_Left;
-                    }
-                    last_button_press = systick;
-				}
-
-			} while ((systick - last_button_press) < SWITCH_COMMAND_EXECUTE_MS);
-			
-			switch (execute_command)
-			{
-				case 2:
-					while(!(PORTA.IN & SWITCH))
-					{
-                        led->red++;
-                        led_color(position, *led);
-                        _delay_ms(COLOR_FADE_DELAY_MS);
-					}
-                    break;
-				case 3:
-				    while(!(PORTA.IN & SWITCH))
-				    {
-    				    led->green++;
-    				    led_color(position, *led);
-    				    _delay_ms(COLOR_FADE_DELAY_MS);
-				    }
-                    break;
-				case 4:
-					while(!(PORTA.IN & SWITCH))
-					{
-    					led->blue++;
-    					led_color(position, *led);
-    					_delay_ms(COLOR_FADE_DELAY_MS);
-					}
-                    break;
-				case 5:
-					while(!(PORTA.IN & SWITCH))
-					{
-    					led->intensity++;
-
-                        if(led->intensity > LED_MAX_INTENSITY)
-                        {
-                            led->intensity = LED_MIN_INTENSITY;
-                        }
-
-    					led_color(position, *led);
-    					_delay_ms(COLOR_INTENSITY_DELAY_MS);
-					}
-                    break;
-				default:
-					led_blink(LED_Position_Left | LED_Position_Right, led_status_color(LED_Status_Error, LED_MIN_INTENSITY), LED_Delay_MS_500, 4);
-				break;
-			}
-
-            #ifdef ENABLE_EEPROM_WRITE
-                if(position == LED_Position_Left)
-                {
-                    eeprom_write_block(&led1, &ee_led1, sizeof(LED_Data));
-                }
-                else
-                {
-                    eeprom_write_block(&led2, &ee_led2, sizeof(LED_Data));
-                }
-            #endif
+    #endif
 
-			led_blink(LED_Position_Left | LED_Position_Right_Alternating, led_status_color(LED_Status_Ready, LED_MIN_INTENSITY), LED_Delay_MS_500, 2);
+    // TCA0 keeps running in idle sleep and wakes the core every systick, a press wakes it immediately
+    PORTA.PIN7CTRL = PORT_ISC_RISING_gc;
+    set_sleep_mode(SLEEP_MODE_IDLE);
+	
+    while (1)
+    {	
+        ui_task();
 
-			execute_command = 0;
-			switch_count = 0;
-		}
+        #ifdef ENABLE_USAGE_STATS
+            stats_update(systick, ui_intensity);
+        #endif
+
+        sleep_hint(ui_idle_ticks());
+        sleep_enable();
+        sleep_cpu();
+        sleep_disable();
     }
-}
\ No newline at end of file
+}
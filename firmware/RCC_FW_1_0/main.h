@@ -63,6 +63,17 @@
 		#define SWITCH_SYSTEM_OFF_TIME_MS 3000UL
 	#endif
 
+	#ifndef SWITCH_DEBOUNCE_MS
+		/**
+		 * @def SWITCH_DEBOUNCE_MS
+		 * @brief Minimum distance of two button events in milliseconds.
+		 *
+		 * @details
+		 * Edges of the switch within this time after an accepted press or release are treated as contact bounce and ignored. In the idle state a held switch only counts as a new press once this time has passed since the last accepted edge.
+		 */
+		#define SWITCH_DEBOUNCE_MS 10UL
+	#endif
+
 	#ifndef COLOR_FADE_DELAY_MS
 		/**
 		 * @def COLOR_FADE_DELAY_MS
@@ -85,6 +96,50 @@
 		#define COLOR_INTENSITY_DELAY_MS 350UL
 	#endif
 
+	#ifndef DIM_DELAY_MIN
+		/**
+		 * @def DIM_DELAY_MIN
+		 * @brief Time without a button press before the LEDs are dimmed, in minutes.
+		 *
+		 * @details
+		 * Default of the dimming schedule, overridden by `ee_dim` in the EEPROM. `0` disables the dimming.
+		 */
+		#define DIM_DELAY_MIN 10
+	#endif
+
+	#ifndef DIM_STEP_S
+		/**
+		 * @def DIM_STEP_S
+		 * @brief Interval of the dimming steps in seconds.
+		 *
+		 * @details
+		 * Every step lowers the intensity of both LEDs by one level, so the LEDs fade down smoothly over several minutes. Default of the dimming schedule, overridden by `ee_dim` in the EEPROM.
+		 */
+		#define DIM_STEP_S 30
+	#endif
+
+	#ifndef DIM_FLOOR_INTENSITY
+		/**
+		 * @def DIM_FLOOR_INTENSITY
+		 * @brief Lowest intensity level the LEDs are dimmed to.
+		 *
+		 * @details
+		 * LEDs that are set to a lower intensity are not changed. Default of the dimming schedule, overridden by `ee_dim` in the EEPROM.
+		 */
+		#define DIM_FLOOR_INTENSITY LED_MIN_INTENSITY
+	#endif
+
+	#ifndef DIM_PWM_SHIFT
+		/**
+		 * @def DIM_PWM_SHIFT
+		 * @brief Number of further steps that halve the color channels (PWM) at the intensity floor.
+		 *
+		 * @details
+		 * Halving all channels of an LED keeps its hue. `0` only dims the intensity. Default of the dimming schedule, overridden by `ee_dim` in the EEPROM.
+		 */
+		#define DIM_PWM_SHIFT 0
+	#endif
+
 	#ifndef ENABLE_EEPROM_WRITE
 		/**
 		 * @def ENABLE_EEPROM_WRITE
@@ -96,6 +151,100 @@
 		#define ENABLE_EEPROM_WRITE
 	#endif
 
+	#ifndef UI_BLINK_UNIT_MS
+		/**
+		 * @def UI_BLINK_UNIT_MS
+		 * @brief Duration of one `LED_Delay` step of the non-blocking blinks in milliseconds.
+		 *
+		 * @details
+		 * Matches the blocking `led_blink()`, whose `_delay_ms(100)` steps run with `CLK_PER` and take `100 * F_CPU / SYSTEM_PER_CLOCK` milliseconds on the device (`200` with `CLKCTRL_PDIV_2X_gc`), so the status blinks keep their speed.
+		 */
+		#define UI_BLINK_UNIT_MS (100UL * (F_CPU / SYSTEM_PER_CLOCK))
+	#endif
+
+	#ifndef UI_IDLE_MAX_TICKS
+		/**
+		 * @def UI_IDLE_MAX_TICKS
+		 * @brief Longest quiet period of the idle user interface in systicks that is announced with `sleep_hint()`.
+		 *
+		 * @details
+		 * Keeps the milliseconds that `stats_update()` accumulates between two calls within 16 bit.
+		 */
+		#define UI_IDLE_MAX_TICKS 60000UL
+	#endif
+
+	/**
+	 * @def ENABLE_LED_BALANCE
+	 * @brief Enables the current-efficient split of the LED brightness (not defined by default).
+	 *
+	 * @details
+	 * When defined (e.g. `-DENABLE_LED_BALANCE`), the LED colors are shown at the lowest global intensity that still reaches the same light output with the PWM channels (see `led_balance()`). The saving rests on the efficacy droop of `led/led_flux.h`, which is an assumption of the energy model and not measured on the LEDs, so the split stays off until the droop is measured.
+	 */
+
+	/**
+	 * @def ENABLE_USAGE_STATS
+	 * @brief Enables the persistent usage statistics (not defined by default).
+	 *
+	 * @details
+	 * When defined (e.g. `-DENABLE_USAGE_STATS`), power-on cycles, on-time, adjustments, low battery boots and the on-time per intensity range are counted and written to a record at the end of the EEPROM within a write budget (see `stats/stats.h`). Left out of the ATtiny402 image until `make size` shows that it fits into the flash and RAM of the part, the host build enables it.
+	 */
+
+	/**
+	 * @def ENABLE_SELFTEST
+	 * @brief Enables the production self-test (not defined by default).
+	 *
+	 * @details
+	 * When defined (e.g. `-DENABLE_SELFTEST`), holding the button while the battery is inserted (power-on reset) runs an accelerated test of the LEDs, the sleep controller, the EEPROM and the battery measurement instead of the boot blink. Left out of the ATtiny402 image until `make size` shows that it fits, the host build enables it.
+	 */
+
+	#ifndef SELFTEST_STEP_MS
+		/**
+		 * @def SELFTEST_STEP_MS
+		 * @brief Duration of every channel of the LED test in milliseconds.
+		 */
+		#define SELFTEST_STEP_MS 80
+	#endif
+
+	#ifndef SELFTEST_BLINK_MS
+		/**
+		 * @def SELFTEST_BLINK_MS
+		 * @brief Duration of the on and off phase of a blink code in milliseconds.
+		 */
+		#define SELFTEST_BLINK_MS 50
+	#endif
+
+	#ifndef SELFTEST_RESULT_MS
+		/**
+		 * @def SELFTEST_RESULT_MS
+		 * @brief Duration of the final pass (green) or fail (red) indication in milliseconds.
+		 */
+		#define SELFTEST_RESULT_MS 400
+	#endif
+
+	#ifndef SELFTEST_BATTERY_STEP
+		/**
+		 * @def SELFTEST_BATTERY_STEP
+		 * @brief ADC steps above `BATTERY_EMPTY_VALUE` per blink of the battery code.
+		 */
+		#define SELFTEST_BATTERY_STEP 32U
+	#endif
+
+	#ifndef SELFTEST_BATTERY_BLINKS
+		/**
+		 * @def SELFTEST_BATTERY_BLINKS
+		 * @brief Maximum number of blinks of the battery code.
+		 */
+		#define SELFTEST_BATTERY_BLINKS 5U
+	#endif
+
+	#ifndef PERF_COMMAND
+		/**
+		 * @def PERF_COMMAND
+		 * @brief Number of button presses of the hidden micro-benchmark command.
+		 */
+		#define PERF_COMMAND 9
+	#endif
+
 	#include <avr/io.h>
 	#include <avr/sleep.h>
 	#include <avr/interrupt.h>
@@ -106,4 +255,135 @@
 	#include "./battery/battery.h"
 	#include "./led/led.h"
 
+	#ifndef sleep_hint
+		/**
+		 * @def sleep_hint
+		 * @brief Announce the systicks of the next idle sleep that have no work for the firmware.
+		 *
+		 * @details
+		 * No effect on the device, which wakes on every systick. The host backend provides its own definition in `<avr/sleep.h>` and executes these systicks back to back. The argument is not evaluated here.
+		 */
+		#define sleep_hint(ticks) ((void)sizeof(ticks))
+	#endif
+
+	#ifdef ENABLE_USAGE_STATS
+		#include "./stats/stats.h"
+	#endif
+
+	/**
+	 * @def ENABLE_PERF_COMMAND
+	 * @brief Enables the hidden micro-benchmark command (not defined by default).
+	 *
+	 * @details
+	 * When defined (e.g. `-DENABLE_PERF_COMMAND`, `make perf` builds its host tool this way), `PERF_COMMAND` button presses measure the LED frame, ADC conversion and EEPROM write durations on the device and show them as blink code (see `perf/perf.h`). The command is meant for characterization images, the shipped image of the 4 KB part does not carry its code and `.noinit` block. Not available together with `ENABLE_JITTER_PROFILE`, both use `TCB0`.
+	 */
+	#ifdef ENABLE_PERF_COMMAND
+		#ifdef ENABLE_JITTER_PROFILE
+			#error "ENABLE_PERF_COMMAND and ENABLE_JITTER_PROFILE both use TCB0"
+		#endif
+		#include "./perf/perf.h"
+	#endif
+
+	/**
+	 * @def ENABLE_JITTER_PROFILE
+	 * @brief Enables the systick latency instrumentation (not defined by default).
+	 *
+	 * @details
+	 * When defined (e.g. `-DENABLE_JITTER_PROFILE`), `TCB0` timestamps the entry of the `TCA0` overflow interrupt relative to the overflow and the statistics are accumulated in the `jitter` variable together with the longest body of both interrupt service routines (see `jitter/jitter.h`). The instrumentation occupies `TCB0` and the synchronous event channel 0 and extends the interrupt service routines by the timestamp calls.
+	 */
+	#ifdef ENABLE_JITTER_PROFILE
+		#include "./jitter/jitter.h"
+	#endif
+
+	/**
+	 * @enum UI_State_t
+	 * @brief States of the button user interface.
+	 *
+	 * @details
+	 * The user interface is a non-blocking state machine. Every call of `ui_task()` executes one step of the current state and returns, the transitions are triggered by button events and the `systick` timebase. Between two steps the core sleeps until the next systick.
+	 */
+	enum UI_State_t
+	{
+		UI_State_Idle=0,                /**< Show the LED colors and count the presses of a command */
+		UI_State_Press,                 /**< Feedback blink of a press */
+		UI_State_Hold,                  /**< Wait for the release of the button or switch off */
+		UI_State_Select,                /**< Blink the selected LED, a press moves the selection (left, right, linked) */
+		UI_State_Adjust,                /**< Ramp the channel of the command until a press */
+		UI_State_Error,                 /**< Error blink of an unknown command */
+		UI_State_Commit,                /**< Confirmation blink after the LED is stored */
+		UI_State_Off,                   /**< Shutdown blink sequence */
+		UI_State_Perf                   /**< Blink code of the micro-benchmark results (`ENABLE_PERF_COMMAND`) */
+	};
+
+	/**
+	 * @typedef UI_State
+	 * @brief Alias for enum UI_State_t representing the state of the user interface.
+	 */
+	typedef enum UI_State_t UI_State;
+
+	/**
+	 * @struct UI_Blink_t
+	 * @brief Progress of a non-blocking LED blink.
+	 *
+	 * @details
+	 * Same pattern as `led_blink()`: even phases show `color` on the `LED_Position_Left`/`LED_Position_Right` positions, odd phases on the alternating positions. After the last phase all LEDs are switched off.
+	 */
+	struct UI_Blink_t
+	{
+		LED_Position position;          /**< LED positions and alternating flags */
+		LED_Data color;                 /**< Color of the blink */
+		unsigned int period;            /**< Duration of a phase in milliseconds */
+		unsigned char phases;           /**< Number of phases (two per repetition) */
+		unsigned char phase;            /**< Current phase */
+		unsigned long start;            /**< `systick` at the start of the current phase */
+	};
+
+	/**
+	 * @typedef UI_Blink
+	 * @brief Alias for struct UI_Blink_t representing a running LED blink.
+	 */
+	typedef struct UI_Blink_t UI_Blink;
+
+	/**
+	 * @struct UI_Dim_t
+	 * @brief Schedule of the automatic dimming.
+	 *
+	 * @details
+	 * Stored in the EEPROM (`ee_dim`) with the defaults `DIM_DELAY_MIN`, `DIM_STEP_S`, `DIM_FLOOR_INTENSITY` and `DIM_PWM_SHIFT`. An erased or invalid schedule (`delay` is `0xFF`, `step` is `0` or `floor` is above `LED_MAX_INTENSITY`) falls back to the defaults. `floor` and `pwm` share one byte (intensities fit into 5 bits, more than 7 halvings clear every channel), which leaves room for `ee_scratch` in the full EEPROM.
+	 */
+	struct UI_Dim_t
+	{
+		unsigned char delay;            /**< Minutes without a press before the first step, `0` disables the dimming */
+		unsigned char step;             /**< Seconds between two steps */
+		unsigned char floor:5;          /**< Lowest intensity level */
+		unsigned char pwm:3;            /**< Halving steps of the color channels at the floor */
+	};
+
+	/**
+	 * @typedef UI_Dim
+	 * @brief Alias for struct UI_Dim_t representing the dimming schedule.
+	 */
+	typedef struct UI_Dim_t UI_Dim;
+
+	/**
+	 * @enum SELFTEST_Result_t
+	 * @brief Result of the production self-test.
+	 *
+	 * @details
+	 * A failed test is shown as the number of red blinks given by the result.
+	 */
+	enum SELFTEST_Result_t
+	{
+		SELFTEST_Result_Pass=0,         /**< All tests passed */
+		SELFTEST_Result_Sleep,          /**< No wake-up from idle sleep by the systick */
+		SELFTEST_Result_EEPROM,         /**< LED records not programmed or read-back mismatch of `ee_scratch` */
+		SELFTEST_Result_Battery         /**< Battery below `BATTERY_EMPTY_VALUE` */
+	};
+
+	/**
+	 * @typedef SELFTEST_Result
+	 * @brief Alias for enum SELFTEST_Result_t representing the result of the self-test.
+	 */
+	typedef enum SELFTEST_Result_t SELFTEST_Result;
+
 #endif /* MAIN_H_ */
\ No newline at end of file
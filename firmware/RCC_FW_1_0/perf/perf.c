@@ -0,0 +1,104 @@
+/**
+ * @file perf.c
+ * @brief On-device micro-benchmarks of the RCC firmware.
+ *
+ * This source file measures the LED frame, ADC conversion and EEPROM write durations with the free running `TCB0` and flags the results that exceed their budget.
+ *
+ * @author g.raf
+ * @date 2026-10-17
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger embedded systems project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/rcc "RCC - RGB LED Color Cube"
+ */
+
+#include "perf.h"
+
+PERF_Data perf PERF_NOINIT;
+
+/**
+ * @brief Run the micro-benchmarks.
+ *
+ * @param cell EEPROM cell that is rewritten with its current value for the write measurement.
+ *
+ * @details
+ * `TCB0` counts with `CLK_PER/2` in periodic interrupt mode without interrupt (`CCMP` `0xFFFF`), every duration is the difference of two counter readings. The frame and ADC measurements are repeated `PERF_RUNS` times and the shortest run is kept, so a systick interrupt within a run does not distort the result. The EEPROM cell is written once per run to limit the wear. The LEDs show the ready color afterwards and the ADC is disabled again.
+ */
+void perf_run(uint8_t *cell)
+{
+    LED_Data color = led_status_color(LED_Status_Ready, LED_MIN_INTENSITY);
+    uint16_t start;
+    uint16_t elapsed;
+
+    if(perf.magic != PERF_MAGIC)
+    {
+        perf.magic = PERF_MAGIC;
+        perf.runs = 0;
+    }
+    perf.frame = 0xFFFF;
+    perf.adc = 0xFFFF;
+    perf.exceeded = 0;
+
+    TCB0.CCMP = 0xFFFF;
+    TCB0.CTRLB = TCB_CNTMODE_INT_gc;
+    TCB0.CTRLA = TCB_CLKSEL_CLKDIV2_gc | TCB_ENABLE_bm;
+
+    for(unsigned char i=0; i < PERF_RUNS; i++)
+    {
+        start = TCB0.CNT;
+        led_color(LED_Position_Left | LED_Position_Right, color);
+        elapsed = TCB0.CNT - start;
+
+        if(elapsed < perf.frame)
+        {
+            perf.frame = elapsed;
+        }
+    }
+
+    battery_init();
+
+    for(unsigned char i=0; i < PERF_RUNS; i++)
+    {
+        start = TCB0.CNT;
+        battery_value();
+        elapsed = TCB0.CNT - start;
+
+        if(elapsed < perf.adc)
+        {
+            perf.adc = elapsed;
+        }
+    }
+    battery_disable();
+
+    eeprom_busy_wait();
+    start = TCB0.CNT;
+    eeprom_write_byte(cell, eeprom_read_byte(cell));
+    eeprom_busy_wait();
+    perf.eeprom = TCB0.CNT - start;
+
+    TCB0.CTRLA = 0;
+
+    if(perf.frame > PERF_COUNTS(PERF_FRAME_US))
+    {
+        perf.exceeded |= PERF_Exceeded_Frame;
+    }
+
+    if(perf.adc > PERF_COUNTS(PERF_ADC_US))
+    {
+        perf.exceeded |= PERF_Exceeded_ADC;
+    }
+
+    if(perf.eeprom > PERF_COUNTS(PERF_EEPROM_US))
+    {
+        perf.exceeded |= PERF_Exceeded_EEPROM;
+    }
+
+    if(perf.runs != 0xFFFF)
+    {
+        perf.runs++;
+    }
+}
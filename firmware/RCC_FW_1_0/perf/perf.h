@@ -0,0 +1,138 @@
+/**
+ * @file perf.h
+ * @brief On-device micro-benchmarks of the RCC firmware.
+ *
+ * This header declares micro-benchmarks that run on the real hardware and measure the duration of an LED frame (`led_color()` of both LEDs), of an ADC conversion of the battery channel and of an EEPROM byte write with `TCB0`. The results are kept in the `perf` block in RAM that is not cleared by a software reset (`.noinit`), so they can be read over UPDI (address of `perf` in the map file) even after the cube was switched off. The `exceeded` flags compare the results against the budgets `PERF_FRAME_US`, `PERF_ADC_US` and `PERF_EEPROM_US`, the user interface shows them as blink code.
+ *
+ * @note `TCB0` is also used by the systick latency instrumentation (`ENABLE_JITTER_PROFILE`), both can not be used together.
+ *
+ * @author g.raf
+ * @date 2026-10-17
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger embedded systems project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/rcc "RCC - RGB LED Color Cube"
+ */
+
+#ifndef PERF_H_
+#define PERF_H_
+
+    #ifndef PERF_MAGIC
+        /**
+         * @def PERF_MAGIC
+         * @brief Marker of a valid result block.
+         */
+        #define PERF_MAGIC 0x5043
+    #endif
+
+    #ifndef PERF_RUNS
+        /**
+         * @def PERF_RUNS
+         * @brief Repetitions of the frame and ADC measurement, the shortest run is kept (free of systick interrupts).
+         */
+        #define PERF_RUNS 8
+    #endif
+
+    #ifndef PERF_CLK_PER
+        /**
+         * @def PERF_CLK_PER
+         * @brief Peripheral clock in Hertz (`F_CPU` divided by `SYSTEM_PER_CLOCK_PRESCALER`).
+         */
+        #define PERF_CLK_PER SYSTEM_PER_CLOCK
+    #endif
+
+    #ifndef PERF_FRAME_US
+        /**
+         * @def PERF_FRAME_US
+         * @brief Budget of an LED frame of both LEDs in microseconds.
+         */
+        #define PERF_FRAME_US 100UL
+    #endif
+
+    #ifndef PERF_ADC_US
+        /**
+         * @def PERF_ADC_US
+         * @brief Budget of an ADC conversion of the battery channel in microseconds.
+         */
+        #define PERF_ADC_US 1000UL
+    #endif
+
+    #ifndef PERF_EEPROM_US
+        /**
+         * @def PERF_EEPROM_US
+         * @brief Budget of an EEPROM byte write (erase and write) in microseconds.
+         */
+        #define PERF_EEPROM_US 5000UL
+    #endif
+
+    #ifndef PERF_NOINIT
+        /**
+         * @def PERF_NOINIT
+         * @brief Placement of the result block in memory that is not cleared by the startup code.
+         */
+        #define PERF_NOINIT __attribute__((section(".noinit")))
+    #endif
+
+    /**
+     * @def PERF_COUNTS
+     * @brief Convert microseconds into `TCB0` counts (`CLK_PER/2`).
+     */
+    #define PERF_COUNTS(us) ((unsigned long)(us) * (PERF_CLK_PER / 2000UL) / 1000UL)
+
+    #include <stdint.h>
+    #include <avr/io.h>
+    #include <avr/eeprom.h>
+
+    #include "../hal/avr0/system/system.h"
+    #include "../led/led.h"
+    #include "../battery/battery.h"
+
+    /**
+     * @enum PERF_Exceeded_t
+     * @brief Flags of the measurements that exceeded their budget.
+     */
+    enum PERF_Exceeded_t
+    {
+        PERF_Exceeded_Frame=0x01,       /**< LED frame above `PERF_FRAME_US` */
+        PERF_Exceeded_ADC=0x02,         /**< ADC conversion above `PERF_ADC_US` */
+        PERF_Exceeded_EEPROM=0x04       /**< EEPROM write above `PERF_EEPROM_US` */
+    };
+
+    /**
+     * @typedef PERF_Exceeded
+     * @brief Alias for enum PERF_Exceeded_t.
+     */
+    typedef enum PERF_Exceeded_t PERF_Exceeded;
+
+    /**
+     * @struct PERF_Data_t
+     * @brief Result block of the micro-benchmarks.
+     *
+     * @details
+     * Durations are `TCB0` counts at `CLK_PER/2`, the CPU cycles are twice the counts. The block is valid if `magic` is `PERF_MAGIC`.
+     */
+    struct PERF_Data_t
+    {
+        uint16_t magic;                 /**< `PERF_MAGIC` */
+        uint16_t runs;                  /**< Number of benchmark runs since the battery was inserted */
+        uint16_t frame;                 /**< Shortest LED frame of both LEDs */
+        uint16_t adc;                   /**< Shortest ADC conversion */
+        uint16_t eeprom;                /**< EEPROM byte write until the EEPROM is ready */
+        uint8_t exceeded;               /**< Flags of `PERF_Exceeded` */
+    };
+
+    /**
+     * @typedef PERF_Data
+     * @brief Alias for struct PERF_Data_t.
+     */
+    typedef struct PERF_Data_t PERF_Data;
+
+    extern PERF_Data perf;
+
+    void perf_run(uint8_t *cell);
+
+#endif /* PERF_H_ */
@@ -0,0 +1,172 @@
+/**
+ * @file stats.c
+ * @brief Persistent usage statistics of the RCC firmware.
+ *
+ * This source file accumulates the usage counters in `.noinit` RAM and writes them to the EEPROM record within the write budget.
+ *
+ * @author g.raf
+ * @date 2026-10-17
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger embedded systems project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/rcc "RCC - RGB LED Color Cube"
+ */
+
+#include "stats.h"
+
+static STATS_Data stats STATS_NOINIT;
+static unsigned long stats_tick STATS_NOINIT;
+static unsigned int stats_ms STATS_NOINIT;
+static unsigned int stats_refill STATS_NOINIT;
+static unsigned int stats_interval STATS_NOINIT;
+static unsigned char stats_seconds[STATS_INTENSITY_BINS] STATS_NOINIT;
+
+static void stats_increment(uint16_t *counter)
+{
+    if(*counter != 0xFFFF)
+    {
+        (*counter)++;
+    }
+}
+
+/**
+ * @brief Start the statistics of a boot.
+ *
+ * @param reset_flags Reset cause of the boot (`RSTCTRL.RSTFR`).
+ *
+ * @details
+ * After a software reset (the wake-up from `system_shutdown()`) the counters in RAM are continued. After any other reset the RAM is undefined and the counters are reloaded from the EEPROM record, an invalid record is cleared with the full write budget. The power-on counter is incremented in both cases. Must be called before `stats_update()` with a `systick` that starts at `0`.
+ */
+void stats_init(unsigned char reset_flags)
+{
+    if(!(reset_flags & RSTCTRL_SWRF_bm) || (stats.version != STATS_VERSION))
+    {
+        eeprom_read_block(&stats, STATS_EEPROM, sizeof(STATS_Data));
+
+        if(stats.version != STATS_VERSION)
+        {
+            unsigned char *data = (unsigned char *)&stats;
+
+            for(unsigned char i=0; i < sizeof(STATS_Data); i++)
+            {
+                data[i] = 0;
+            }
+            stats.version = STATS_VERSION;
+            stats.credit = STATS_WRITE_BUDGET;
+        }
+
+        stats_ms = 0;
+        stats_refill = 0;
+        stats_interval = 0;
+
+        for(unsigned char i=0; i < STATS_INTENSITY_BINS; i++)
+        {
+            stats_seconds[i] = 0;
+        }
+    }
+
+    stats_tick = 0;
+    stats_increment(&stats.power_on);
+}
+
+/**
+ * @brief Count a boot with a low battery.
+ */
+void stats_low_battery(void)
+{
+    stats_increment(&stats.low_battery);
+}
+
+/**
+ * @brief Count a committed adjustment.
+ *
+ * @param command Executed command (`2` red, `3` green, `4` blue, `5` intensity), other commands are ignored.
+ */
+void stats_adjustment(unsigned char command)
+{
+    if((command >= 2) && (command < (2 + STATS_COMMANDS)))
+    {
+        stats_increment(&stats.adjustments[command - 2]);
+    }
+}
+
+/**
+ * @brief Write the counters to the EEPROM record if the write budget allows it.
+ *
+ * @details
+ * Takes one token of the write budget and only programs the changed bytes of the record (`eeprom_update_block`). Without a token nothing is written, the counters are kept in RAM.
+ */
+void stats_flush(void)
+{
+    stats_interval = 0;
+
+    if(!stats.credit)
+    {
+        return;
+    }
+    stats.credit--;
+    stats_increment(&stats.flushes);
+
+    eeprom_update_block(&stats, STATS_EEPROM, sizeof(STATS_Data));
+}
+
+static void stats_second(unsigned char intensity)
+{
+    unsigned char bin = intensity >> STATS_INTENSITY_SHIFT;
+
+    if(bin >= STATS_INTENSITY_BINS)
+    {
+        bin = STATS_INTENSITY_BINS - 1;
+    }
+
+    if(stats.on_time != 0xFFFFFFFFUL)
+    {
+        stats.on_time++;
+    }
+
+    if(++stats_seconds[bin] >= 60)
+    {
+        stats_seconds[bin] = 0;
+        stats_increment(&stats.intensity[bin]);
+    }
+
+    if(++stats_refill >= (unsigned int)(STATS_BUDGET_PERIOD_S / STATS_WRITE_BUDGET))
+    {
+        stats_refill = 0;
+
+        if(stats.credit < STATS_WRITE_BUDGET)
+        {
+            stats.credit++;
+        }
+    }
+
+    if(++stats_interval >= STATS_FLUSH_INTERVAL_S)
+    {
+        stats_flush();
+    }
+}
+
+/**
+ * @brief Accumulate the on-time.
+ *
+ * @param tick Current `systick` in milliseconds.
+ * @param intensity Current intensity level of the brighter LED.
+ *
+ * @details
+ * Called from the main loop. Every elapsed second is counted as on-time and into the range of `intensity`, the periodic write is triggered after `STATS_FLUSH_INTERVAL_S`.
+ */
+void stats_update(unsigned long tick, unsigned char intensity)
+{
+    stats_ms += (unsigned int)(tick - stats_tick);
+    stats_tick = tick;
+
+    while(stats_ms >= 1000)
+    {
+        stats_ms -= 1000;
+        stats_second(intensity);
+    }
+}
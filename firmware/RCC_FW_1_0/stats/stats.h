@@ -0,0 +1,154 @@
+/**
+ * @file stats.h
+ * @brief Persistent usage statistics of the RCC firmware.
+ *
+ * This header declares counters of the field usage of the cube: power-on cycles, cumulative on-time, adjustments per command, boots with a low battery and the on-time per intensity range. The counters are accumulated in RAM that is not cleared by a software reset (`.noinit`), so they survive the shutdown/wake-up cycles of the cube as long as the battery is inserted. They are written to a fixed record at the end of the EEPROM only at `system_shutdown()` and every `STATS_FLUSH_INTERVAL_S` of on-time, and never more often than the write budget allows.
+ *
+ * The record (`STATS_Data`, little endian, packed) can be read over UPDI from the EEPROM address `STATS_EEPROM` and decoded with `tools/sim/stats.c`.
+ *
+ * @author g.raf
+ * @date 2026-10-17
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger embedded systems project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/rcc "RCC - RGB LED Color Cube"
+ */
+
+#ifndef STATS_H_
+#define STATS_H_
+
+    #ifndef STATS_VERSION
+        /**
+         * @def STATS_VERSION
+         * @brief Layout version of the EEPROM record.
+         *
+         * @details
+         * A record with a different version (e.g. an erased EEPROM with `0xFF`) is cleared at the next power-on reset.
+         */
+        #define STATS_VERSION 0x01
+    #endif
+
+    #ifndef STATS_COMMANDS
+        /**
+         * @def STATS_COMMANDS
+         * @brief Number of counted commands (`2` red, `3` green, `4` blue, `5` intensity).
+         */
+        #define STATS_COMMANDS 4
+    #endif
+
+    #ifndef STATS_INTENSITY_BINS
+        /**
+         * @def STATS_INTENSITY_BINS
+         * @brief Number of intensity ranges with an own on-time counter.
+         */
+        #define STATS_INTENSITY_BINS 4
+    #endif
+
+    #ifndef STATS_INTENSITY_SHIFT
+        /**
+         * @def STATS_INTENSITY_SHIFT
+         * @brief Width of an intensity range as power of two levels.
+         *
+         * @details
+         * With the default of `2` the ranges are `0-3`, `4-7`, `8-11` and `12-15` (`LED_MAX_INTENSITY`). Higher levels are counted in the last range.
+         */
+        #define STATS_INTENSITY_SHIFT 2
+    #endif
+
+    #ifndef STATS_WRITE_BUDGET
+        /**
+         * @def STATS_WRITE_BUDGET
+         * @brief Maximum number of record writes per `STATS_BUDGET_PERIOD_S`.
+         *
+         * @details
+         * The budget is a token bucket. Every write takes one token, a token is returned every `STATS_BUDGET_PERIOD_S / STATS_WRITE_BUDGET` seconds of on-time (at most `STATS_WRITE_BUDGET` tokens). Without a token the counters stay in RAM until a later write.
+         */
+        #define STATS_WRITE_BUDGET 4U
+    #endif
+
+    #ifndef STATS_BUDGET_PERIOD_S
+        /**
+         * @def STATS_BUDGET_PERIOD_S
+         * @brief Period of the write budget in seconds of on-time (one day).
+         *
+         * @details
+         * The cube has no clock while it is switched off, so the budget refers to the time it is switched on. `STATS_BUDGET_PERIOD_S / STATS_WRITE_BUDGET` must fit into 16 bits.
+         */
+        #define STATS_BUDGET_PERIOD_S 86400UL
+    #endif
+
+    #ifndef STATS_FLUSH_INTERVAL_S
+        /**
+         * @def STATS_FLUSH_INTERVAL_S
+         * @brief Interval of the periodic record write in seconds of on-time (max. `65535`).
+         */
+        #define STATS_FLUSH_INTERVAL_S 21600U
+    #endif
+
+    #ifndef STATS_NOINIT
+        /**
+         * @def STATS_NOINIT
+         * @brief Placement of the RAM counters in memory that is not cleared by the startup code.
+         */
+        #define STATS_NOINIT __attribute__((section(".noinit")))
+    #endif
+
+    #include <stdint.h>
+    #include <avr/io.h>
+    #include <avr/eeprom.h>
+
+    /**
+     * @struct STATS_Data_t
+     * @brief EEPROM record of the usage statistics.
+     *
+     * @details
+     * The layout is fixed (little endian, no padding on the target and on the host) to allow the readout of the raw EEPROM over UPDI. Counters saturate at their maximum.
+     */
+    struct STATS_Data_t
+    {
+        uint8_t version;                                /**< Layout version (`STATS_VERSION`) */
+        uint8_t credit;                                 /**< Remaining tokens of the write budget */
+        uint16_t power_on;                              /**< Power-on cycles (every boot) */
+        uint16_t low_battery;                           /**< Boots with a low battery */
+        uint16_t flushes;                               /**< Writes of the record */
+        uint32_t on_time;                               /**< Cumulative on-time in seconds */
+        uint16_t adjustments[STATS_COMMANDS];           /**< Adjustments per command */
+        uint16_t intensity[STATS_INTENSITY_BINS];       /**< On-time per intensity range in minutes */
+    };
+
+    /**
+     * @typedef STATS_Data
+     * @brief Alias for struct STATS_Data_t.
+     */
+    typedef struct STATS_Data_t STATS_Data;
+
+    #ifndef STATS_EEPROM_ADDRESS
+        /**
+         * @def STATS_EEPROM_ADDRESS
+         * @brief EEPROM address of the record as integer constant expression.
+         *
+         * @details
+         * The record is placed at the end of the EEPROM behind the `EEMEM` variables of the firmware, so their addresses do not depend on the link order. The address is not part of the `.eep` image, an erased record is detected by its version.
+         *
+         * @note The `EEMEM` image must end at or before this address, `main.c` checks this at compile time.
+         */
+        #define STATS_EEPROM_ADDRESS (EEPROM_SIZE - sizeof(STATS_Data))
+    #endif
+
+    /**
+     * @def STATS_EEPROM
+     * @brief EEPROM address of the record as pointer for the `eeprom_*` functions.
+     */
+    #define STATS_EEPROM ((void *)(STATS_EEPROM_ADDRESS))
+
+    void stats_init(unsigned char reset_flags);
+    void stats_low_battery(void);
+    void stats_adjustment(unsigned char command);
+    void stats_update(unsigned long tick, unsigned char intensity);
+    void stats_flush(void);
+
+#endif /* STATS_H_ */
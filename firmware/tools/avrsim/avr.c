@@ -0,0 +1,1376 @@
+/**
+ * @file avr.c
+ * @brief Cycle-accurate simulator of the ATtiny402 (AVRxt core) for RCC firmware images.
+ *
+ * This source file implements the AVRxt instruction set on predecoded flash, the data space of the ATtiny402 and the peripherals used by the RCC firmware. Interrupts follow the AVRxt scheme: the global interrupt flag is not cleared on entry, instead `CPUINT.STATUS.LVL0EX` blocks further level 0 interrupts until `RETI`.
+ *
+ * @author g.raf
+ * @date 2026-10-17
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger embedded systems project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/rcc "RCC - RGB LED Color Cube"
+ */
+
+#include <string.h>
+
+#include "avr.h"
+
+#define SREG_C 0x01
+#define SREG_Z 0x02
+#define SREG_N 0x04
+#define SREG_V 0x08
+#define SREG_S 0x10
+#define SREG_H 0x20
+#define SREG_T 0x40
+#define SREG_I 0x80
+
+/**
+ * @brief Recalculate the CPU clock period after a change of `CLKCTRL`.
+ */
+static void avr_clock_update(AVR *avr)
+{
+    avr->period_ps = (unsigned long)(1000000000000ULL / avr_clock(avr));
+}
+
+/**
+ * @brief Calculate the current CPU/peripheral clock frequency.
+ *
+ * @param avr Simulator.
+ *
+ * @return `CLK_CPU` (= `CLK_PER`) in Hertz.
+ */
+unsigned long avr_clock(const AVR *avr)
+{
+    static const unsigned char divider[16] = { 2, 4, 8, 16, 32, 64, 1, 1, 6, 10, 12, 24, 48, 1, 1, 1 };
+    unsigned long clock = ((avr->io[AVR_IO_CLKCTRL_MCLKCTRLA] & 0x03) == 0x01) ? 32768UL : AVR_OSCILLATOR;
+
+    if(avr->io[AVR_IO_CLKCTRL_MCLKCTRLB] & 0x01)
+    {
+        clock /= divider[(avr->io[AVR_IO_CLKCTRL_MCLKCTRLB]>>1) & 0x0F];
+    }
+    return clock;
+}
+
+/**
+ * @brief Get the name of an interrupt vector.
+ *
+ * @param vector Vector number.
+ *
+ * @return Name as used in `iotn402.h` without the `_vect` suffix, `NULL` for reserved vectors.
+ */
+const char *avr_vector_name(unsigned char vector)
+{
+    static const char *const names[AVR_VECTORS] = {
+        "RESET", "CRCSCAN_NMI", "BOD_VLM", "PORTA_PORT", NULL, NULL, "RTC_CNT", "RTC_PIT",
+        "TCA0_OVF", "TCA0_HUNF", "TCA0_CMP0", "TCA0_CMP1", "TCA0_CMP2", "TCB0_INT", "TCD0_OVF", "TCD0_TRIG",
+        "AC0_AC", "ADC0_RESRDY", "ADC0_WCOMP", "TWI0_TWIS", "TWI0_TWIM", "SPI0_INT", "USART0_RXC", "USART0_DRE",
+        "USART0_TXC", "NVMCTRL_EE"
+    };
+
+    return (vector < AVR_VECTORS) ? names[vector] : NULL;
+}
+
+/**
+ * @brief Power-on the simulated device with a firmware image.
+ *
+ * @param avr Simulator.
+ * @param image Firmware image (must stay valid while simulating).
+ */
+void avr_init(AVR *avr, const IMAGE_Firmware *image)
+{
+    memset(avr, 0, sizeof(*avr));
+    avr->image = image;
+
+    for(unsigned long i=0; i < (AVR_FLASH_SIZE / 2); i++)
+    {
+        unsigned int opcode = image->flash[2 * i] | ((unsigned int)image->flash[2 * i + 1]<<8);
+        unsigned int next = ((2 * i + 3) < AVR_FLASH_SIZE) ? (image->flash[2 * i + 2] | ((unsigned int)image->flash[2 * i + 3]<<8)) : 0xFFFF;
+
+        avr->code[i] = avr_decode(opcode, next);
+    }
+    memcpy(avr->eeprom, image->eeprom, AVR_EEPROM_SIZE);
+    avr->horizon = ~0ULL;
+    avr_reset(avr, 0x01);
+}
+
+/**
+ * @brief Reset the CPU and all peripherals.
+ *
+ * @param avr Simulator.
+ * @param flags Reset cause written to `RSTCTRL.RSTFR` (`0x01` power-on, `0x10` software reset).
+ *
+ * @details
+ * SRAM and EEPROM keep their contents, environment (pins, analog inputs) and statistics are not affected.
+ */
+void avr_reset(AVR *avr, unsigned char flags)
+{
+    memset(avr->r, 0, sizeof(avr->r));
+    memset(avr->io, 0, AVR_RAM_START);
+    memset(avr->page_loaded, 0, sizeof(avr->page_loaded));
+
+    avr->sreg = 0;
+    avr->sp = AVR_RAM_END;
+    avr->pc = 0;
+    avr->level = 0;
+    avr->status = AVR_Status_Run;
+    avr->spi_busy = 0;
+    avr->adc_busy = 0;
+    avr->nvm_busy_ps = 0;
+    avr->tca_prescale = 0;
+    avr->tcb_prescale = 0;
+
+    avr->io[AVR_IO_RSTCTRL_RSTFR] = flags;
+    avr->io[AVR_IO_CLKCTRL_MCLKCTRLB] = (0x08<<1) | 0x01;
+    avr->io[AVR_IO_TCA0_PERL] = 0xFF;
+    avr->io[AVR_IO_TCA0_PERH] = 0xFF;
+    avr->io[AVR_IO_PORTA_IN] = avr->pins;
+    avr_clock_update(avr);
+}
+
+/**
+ * @brief Set the external level of a `PORTA` pin.
+ *
+ * @param avr Simulator.
+ * @param pin Pin number (0-7).
+ * @param level Pin level (0 or 1).
+ *
+ * @details
+ * Sets the pin interrupt flag according to the input sense configuration (`PINnCTRL.ISC`).
+ */
+void avr_pin(AVR *avr, unsigned char pin, unsigned char level)
+{
+    unsigned char mask = (unsigned char)(1U<<(pin & 0x07));
+    unsigned char old = avr->pins & mask;
+    unsigned char isc = avr->io[AVR_IO_PORTA_PIN0CTRL + (pin & 0x07)] & 0x07;
+
+    avr->pins = level ? (avr->pins | mask) : (avr->pins & ~mask);
+
+    if(old == (avr->pins & mask))
+    {
+        return;
+    }
+
+    if((isc == 0x01) || ((isc == 0x02) && level) || (((isc == 0x03) || (isc == 0x05)) && !level))
+    {
+        avr->io[AVR_IO_PORTA_INTFLAGS] |= mask;
+    }
+}
+
+static unsigned char avr_port_in(const AVR *avr)
+{
+    return (unsigned char)((avr->pins & ~avr->io[AVR_IO_PORTA_DIR]) | (avr->io[AVR_IO_PORTA_OUT] & avr->io[AVR_IO_PORTA_DIR]));
+}
+
+/**
+ * @brief Read a byte from data space.
+ *
+ * @param avr Simulator.
+ * @param address Data space address.
+ *
+ * @return Register, SRAM, EEPROM or mapped flash contents.
+ */
+unsigned char avr_read(AVR *avr, unsigned int address)
+{
+    if((address >= AVR_RAM_START) && (address <= AVR_RAM_END))
+    {
+        return avr->io[address];
+    }
+
+    if(address >= AVR_FLASH_MAPPED)
+    {
+        address -= AVR_FLASH_MAPPED;
+        return (address < AVR_FLASH_SIZE) ? avr->image->flash[address] : 0xFF;
+    }
+
+    if((address >= AVR_EEPROM_START) && (address < (AVR_EEPROM_START + AVR_EEPROM_SIZE)))
+    {
+        return avr->eeprom[address - AVR_EEPROM_START];
+    }
+
+    if(address >= AVR_RAM_START)
+    {
+        return 0x00;
+    }
+
+    switch(address)
+    {
+        case AVR_IO_VPORTA_DIR:
+            return avr->io[AVR_IO_PORTA_DIR];
+        case AVR_IO_VPORTA_OUT:
+            return avr->io[AVR_IO_PORTA_OUT];
+        case AVR_IO_VPORTA_IN:
+        case AVR_IO_PORTA_IN:
+            return avr_port_in(avr);
+        case AVR_IO_VPORTA_INTFLAGS:
+            return avr->io[AVR_IO_PORTA_INTFLAGS];
+        case AVR_IO_SPL:
+            return (unsigned char)avr->sp;
+        case AVR_IO_SPH:
+            return (unsigned char)(avr->sp>>8);
+        case AVR_IO_SREG:
+            return avr->sreg;
+        case AVR_IO_CLKCTRL_MCLKSTATUS:
+            return ((avr->io[AVR_IO_CLKCTRL_MCLKCTRLA] & 0x03) == 0x01) ? 0x20 : 0x10;
+        case AVR_IO_CPUINT_STATUS:
+            return avr->level;
+        case AVR_IO_SPI0_DATA:
+            // Normal mode: reading DATA after IF was set clears IF, MISO is pulled up
+            avr->io[AVR_IO_SPI0_INTFLAGS] &= (unsigned char)~0x80;
+            return 0xFF;
+        case AVR_IO_ADC0_RESL:
+            avr->io[AVR_IO_ADC0_INTFLAGS] &= (unsigned char)~0x01;
+            return avr->io[AVR_IO_ADC0_RESL];
+        case AVR_IO_NVMCTRL_STATUS:
+            return avr->nvm_busy_ps ? 0x02 : 0x00;
+        default:
+            return avr->io[address];
+    }
+}
+
+static void avr_spi_start(AVR *avr, unsigned char data)
+{
+    static const unsigned char prescaler[4] = { 4, 16, 64, 128 };
+    unsigned char control = avr->io[AVR_IO_SPI0_CTRLA];
+    unsigned long divider = prescaler[(control>>1) & 0x03];
+
+    if((control & 0x21) != 0x21)
+    {
+        return;
+    }
+
+    if(control & 0x10)
+    {
+        divider >>= 1;
+    }
+    avr->io[AVR_IO_SPI0_INTFLAGS] &= (unsigned char)~0x80;
+    avr->spi_busy = 8 * divider;
+
+    if(avr->observer.spi)
+    {
+        avr->observer.spi(avr, data);
+    }
+}
+
+static void avr_adc_start(AVR *avr)
+{
+    unsigned long divider = 2UL<<(avr->io[AVR_IO_ADC0_CTRLC] & 0x07);
+    unsigned long clocks = 2UL + (avr->io[AVR_IO_ADC0_SAMPCTRL] & 0x1F) + (avr->io[AVR_IO_ADC0_CTRLD] & 0x0F) + ((avr->io[AVR_IO_ADC0_CTRLA] & 0x04) ? 8UL : 10UL);
+
+    if(!(avr->io[AVR_IO_ADC0_CTRLA] & 0x01))
+    {
+        return;
+    }
+    avr->io[AVR_IO_ADC0_COMMAND] |= 0x01;
+    avr->adc_busy = (clocks * divider)<<(avr->io[AVR_IO_ADC0_CTRLB] & 0x07);
+}
+
+static void avr_adc_done(AVR *avr)
+{
+    unsigned int result = avr->analog[avr->io[AVR_IO_ADC0_MUXPOS] & 0x1F];
+
+    if(avr->io[AVR_IO_ADC0_CTRLA] & 0x04)
+    {
+        result >>= 2;
+    }
+    result <<= (avr->io[AVR_IO_ADC0_CTRLB] & 0x07);
+
+    avr->io[AVR_IO_ADC0_RESL] = (unsigned char)result;
+    avr->io[AVR_IO_ADC0_RESH] = (unsigned char)(result>>8);
+    avr->io[AVR_IO_ADC0_INTFLAGS] |= 0x01;
+    avr->io[AVR_IO_ADC0_COMMAND] &= (unsigned char)~0x01;
+}
+
+static void avr_nvm_command(AVR *avr, unsigned char command)
+{
+    unsigned long long duration = 0;
+
+    switch(command & 0x07)
+    {
+        case 0x01:  // Write page
+        case 0x02:  // Erase page
+        case 0x03:  // Erase and write page
+            for(unsigned int i=0; i < AVR_EEPROM_SIZE; i++)
+            {
+                if(!avr->page_loaded[i])
+                {
+                    continue;
+                }
+
+                if((command & 0x07) == 0x02)
+                {
+                    avr->eeprom[i] = 0xFF;
+                }
+                else if((command & 0x07) == 0x01)
+                {
+                    avr->eeprom[i] &= avr->page[i];
+                }
+                else
+                {
+                    avr->eeprom[i] = avr->page[i];
+                }
+                avr->eeprom_writes[i]++;
+
+                if(avr->observer.eeprom)
+                {
+                    avr->observer.eeprom(avr, i, avr->eeprom[i]);
+                }
+            }
+            duration = ((command & 0x07) == 0x03) ? AVR_EEPROM_WRITE_NS : (AVR_EEPROM_WRITE_NS / 2);
+            memset(avr->page_loaded, 0, sizeof(avr->page_loaded));
+            break;
+        case 0x04:  // Page buffer clear
+            memset(avr->page_loaded, 0, sizeof(avr->page_loaded));
+            break;
+        case 0x06:  // EEPROM erase
+            for(unsigned int i=0; i < AVR_EEPROM_SIZE; i++)
+            {
+                avr->eeprom[i] = 0xFF;
+                avr->eeprom_writes[i]++;
+            }
+            duration = AVR_EEPROM_WRITE_NS / 2;
+            break;
+        default:
+            break;
+    }
+    avr->nvm_busy_ps = duration * 1000ULL;
+}
+
+/**
+ * @brief Write a byte to data space.
+ *
+ * @param avr Simulator.
+ * @param address Data space address.
+ * @param value Value to write.
+ */
+void avr_write(AVR *avr, unsigned int address, unsigned char value)
+{
+    if((address >= AVR_RAM_START) && (address <= AVR_RAM_END))
+    {
+        avr->io[address] = value;
+        return;
+    }
+
+    if((address >= AVR_EEPROM_START) && (address < (AVR_EEPROM_START + AVR_EEPROM_SIZE)))
+    {
+        avr->page[address - AVR_EEPROM_START] = value;
+        avr->page_loaded[address - AVR_EEPROM_START] = 1;
+        return;
+    }
+
+    if(address >= AVR_RAM_START)
+    {
+        return;
+    }
+
+    switch(address)
+    {
+        case AVR_IO_VPORTA_DIR:
+            avr->io[AVR_IO_PORTA_DIR] = value;
+            break;
+        case AVR_IO_VPORTA_OUT:
+            avr->io[AVR_IO_PORTA_OUT] = value;
+            break;
+        case AVR_IO_VPORTA_IN:
+        case AVR_IO_PORTA_IN:
+            avr->io[AVR_IO_PORTA_OUT] ^= value;
+            break;
+        case AVR_IO_VPORTA_INTFLAGS:
+        case AVR_IO_PORTA_INTFLAGS:
+            avr->io[AVR_IO_PORTA_INTFLAGS] &= (unsigned char)~value;
+            break;
+        case AVR_IO_SPL:
+            avr->sp = (avr->sp & 0xFF00) | value;
+            break;
+        case AVR_IO_SPH:
+            avr->sp = (avr->sp & 0x00FF) | ((unsigned int)value<<8);
+            break;
+        case AVR_IO_SREG:
+            avr->sreg = value;
+            break;
+        case AVR_IO_RSTCTRL_RSTFR:
+            avr->io[AVR_IO_RSTCTRL_RSTFR] &= (unsigned char)~value;
+            break;
+        case AVR_IO_RSTCTRL_SWRR:
+            if(value & 0x01)
+            {
+                avr->status = AVR_Status_Reset;
+            }
+            break;
+        case AVR_IO_CLKCTRL_MCLKCTRLA:
+        case AVR_IO_CLKCTRL_MCLKCTRLB:
+            avr->io[address] = value;
+            avr_clock_update(avr);
+            break;
+        case AVR_IO_CLKCTRL_MCLKSTATUS:
+            break;
+        case AVR_IO_PORTA_DIRSET:
+            avr->io[AVR_IO_PORTA_DIR] |= value;
+            break;
+        case AVR_IO_PORTA_DIRCLR:
+            avr->io[AVR_IO_PORTA_DIR] &= (unsigned char)~value;
+            break;
+        case AVR_IO_PORTA_DIRTGL:
+            avr->io[AVR_IO_PORTA_DIR] ^= value;
+            break;
+        case AVR_IO_PORTA_OUTSET:
+            avr->io[AVR_IO_PORTA_OUT] |= value;
+            break;
+        case AVR_IO_PORTA_OUTCLR:
+            avr->io[AVR_IO_PORTA_OUT] &= (unsigned char)~value;
+            break;
+        case AVR_IO_PORTA_OUTTGL:
+            avr->io[AVR_IO_PORTA_OUT] ^= value;
+            break;
+        case AVR_IO_SPI0_DATA:
+            avr_spi_start(avr, value);
+            break;
+        case AVR_IO_SPI0_INTFLAGS:
+        case AVR_IO_ADC0_INTFLAGS:
+        case AVR_IO_TCA0_INTFLAGS:
+        case AVR_IO_TCB0_INTFLAGS:
+            avr->io[address] &= (unsigned char)~value;
+            break;
+        case AVR_IO_ADC0_COMMAND:
+            if(value & 0x01)
+            {
+                avr_adc_start(avr);
+            }
+            break;
+        case AVR_IO_NVMCTRL_CTRLA:
+            avr_nvm_command(avr, value);
+            break;
+        default:
+            avr->io[address] = value;
+
+            if((address >= AVR_IO_GPIOR0) && (address <= AVR_IO_GPIOR3) && avr->observer.gpior)
+            {
+                avr->observer.gpior(avr, (unsigned char)(address - AVR_IO_GPIOR0), value);
+            }
+            break;
+    }
+}
+
+/**
+ * @brief Convert peripheral cycles into `TCB0` counts.
+ *
+ * @param avr Simulator.
+ * @param cycles Peripheral cycles elapsed.
+ * @param divider Peripheral cycles per count of the selected clock.
+ */
+static unsigned long avr_tcb_counts(AVR *avr, unsigned long cycles, unsigned int divider)
+{
+    avr->tcb_prescale += cycles;
+    cycles = avr->tcb_prescale / divider;
+    avr->tcb_prescale %= divider;
+
+    return cycles;
+}
+
+/**
+ * @brief Advance `TCB0`.
+ *
+ * @param avr Simulator.
+ * @param cycles Peripheral cycles elapsed.
+ * @param overflow Peripheral cycles since a `TCA0` overflow within the elapsed cycles (`~0UL` if none).
+ *
+ * @details
+ * The counter runs with `CLK_PER`, `CLK_PER/2` or the `TCA0` clock and wraps at 16 bits. In frequency measurement mode with the `TCA0` overflow routed over the synchronous event channel 0 (the only event source of the simulator) every overflow copies the counter to `CCMP`, restarts the counter and sets the capture flag.
+ */
+static void avr_tcb(AVR *avr, unsigned long cycles, unsigned long overflow)
+{
+    static const unsigned int prescaler[8] = { 1, 2, 4, 8, 16, 64, 256, 1024 };
+    unsigned long count = avr->io[AVR_IO_TCB0_CNTL] | ((unsigned int)avr->io[AVR_IO_TCB0_CNTH]<<8);
+    unsigned int divider;
+
+    switch((avr->io[AVR_IO_TCB0_CTRLA]>>1) & 0x03)
+    {
+        case 0x01:
+            divider = 2;
+            break;
+        case 0x02:
+            divider = prescaler[(avr->io[AVR_IO_TCA0_CTRLA]>>1) & 0x07];
+            break;
+        default:
+            divider = 1;
+            break;
+    }
+
+    if((overflow <= cycles) &&
+       ((avr->io[AVR_IO_TCB0_CTRLB] & 0x07) == 0x03) &&
+       (avr->io[AVR_IO_TCB0_EVCTRL] & 0x01) &&
+       (avr->io[AVR_IO_EVSYS_SYNCCH0] == 0x02) &&
+       (avr->io[AVR_IO_EVSYS_ASYNCUSER0] == 0x01))
+    {
+        count = (count + avr_tcb_counts(avr, cycles - overflow, divider)) & 0xFFFF;
+        avr->io[AVR_IO_TCB0_CCMPL] = (unsigned char)count;
+        avr->io[AVR_IO_TCB0_CCMPH] = (unsigned char)(count>>8);
+        avr->io[AVR_IO_TCB0_INTFLAGS] |= 0x01;
+
+        avr->tcb_prescale = 0;
+        count = avr_tcb_counts(avr, overflow, divider);
+    }
+    else
+    {
+        count += avr_tcb_counts(avr, cycles, divider);
+    }
+    avr->io[AVR_IO_TCB0_CNTL] = (unsigned char)count;
+    avr->io[AVR_IO_TCB0_CNTH] = (unsigned char)(count>>8);
+}
+
+/**
+ * @brief Advance clock and peripherals.
+ *
+ * @param avr Simulator.
+ * @param cycles CPU cycles elapsed.
+ */
+static void avr_tick(AVR *avr, unsigned long cycles)
+{
+    static const unsigned int prescaler[8] = { 1, 2, 4, 8, 16, 64, 256, 1024 };
+    unsigned char halted = (avr->status == AVR_Status_Sleep) && (avr->io[AVR_IO_SLPCTRL_CTRLA] & 0x06);
+    unsigned long overflow = ~0UL;
+
+    avr->cycles += cycles;
+    avr->time_ps += (unsigned long long)cycles * avr->period_ps;
+
+    if(avr->spi_busy)
+    {
+        if(avr->spi_busy <= cycles)
+        {
+            avr->spi_busy = 0;
+            avr->io[AVR_IO_SPI0_INTFLAGS] |= 0x80;
+        }
+        else
+        {
+            avr->spi_busy -= cycles;
+        }
+    }
+
+    if(avr->adc_busy)
+    {
+        if(avr->adc_busy <= cycles)
+        {
+            avr->adc_busy = 0;
+            avr_adc_done(avr);
+        }
+        else
+        {
+            avr->adc_busy -= cycles;
+        }
+    }
+
+    if(avr->nvm_busy_ps)
+    {
+        unsigned long long elapsed = (unsigned long long)cycles * avr->period_ps;
+        avr->nvm_busy_ps = (avr->nvm_busy_ps > elapsed) ? (avr->nvm_busy_ps - elapsed) : 0;
+    }
+
+    // TCA0 and TCB0 stop in standby and power-down
+    if((avr->io[AVR_IO_TCA0_CTRLA] & 0x01) && !halted)
+    {
+        unsigned int divider = prescaler[(avr->io[AVR_IO_TCA0_CTRLA]>>1) & 0x07];
+        unsigned long period = (unsigned long)(avr->io[AVR_IO_TCA0_PERL] | ((unsigned int)avr->io[AVR_IO_TCA0_PERH]<<8)) + 1UL;
+        unsigned long count = avr->io[AVR_IO_TCA0_CNTL] | ((unsigned int)avr->io[AVR_IO_TCA0_CNTH]<<8);
+
+        avr->tca_prescale += cycles;
+        count += avr->tca_prescale / divider;
+        avr->tca_prescale %= divider;
+
+        if(count >= period)
+        {
+            count %= period;
+            avr->io[AVR_IO_TCA0_INTFLAGS] |= 0x01;
+            overflow = count * divider + avr->tca_prescale;
+        }
+        avr->io[AVR_IO_TCA0_CNTL] = (unsigned char)count;
+        avr->io[AVR_IO_TCA0_CNTH] = (unsigned char)(count>>8);
+    }
+
+    if((avr->io[AVR_IO_TCB0_CTRLA] & 0x01) && !halted)
+    {
+        avr_tcb(avr, cycles, overflow);
+    }
+}
+
+/**
+ * @brief Get the highest priority pending interrupt.
+ *
+ * @return Vector number or `0` if no enabled interrupt is pending.
+ */
+static unsigned char avr_pending(const AVR *avr)
+{
+    unsigned char porta = 0;
+
+    for(unsigned char i=0; avr->io[AVR_IO_PORTA_INTFLAGS] && (i < 8); i++)
+    {
+        if((avr->io[AVR_IO_PORTA_INTFLAGS] & (1U<<i)) && ((avr->io[AVR_IO_PORTA_PIN0CTRL + i] & 0x07) != 0x00) && ((avr->io[AVR_IO_PORTA_PIN0CTRL + i] & 0x07) != 0x04))
+        {
+            porta = 1;
+        }
+    }
+
+    if(porta)
+    {
+        return AVR_VECTOR_PORTA;
+    }
+
+    if(avr->io[AVR_IO_TCA0_INTFLAGS] & avr->io[AVR_IO_TCA0_INTCTRL] & 0x01)
+    {
+        return AVR_VECTOR_TCA0_OVF;
+    }
+    return 0;
+}
+
+static void avr_push(AVR *avr, unsigned char value)
+{
+    avr_write(avr, avr->sp, value);
+    avr->sp = (avr->sp - 1) & 0xFFFF;
+}
+
+static unsigned char avr_pop(AVR *avr)
+{
+    avr->sp = (avr->sp + 1) & 0xFFFF;
+    return avr_read(avr, avr->sp);
+}
+
+static void avr_push_pc(AVR *avr, unsigned int pc)
+{
+    avr_push(avr, (unsigned char)pc);
+    avr_push(avr, (unsigned char)(pc>>8));
+}
+
+static unsigned int avr_pop_pc(AVR *avr)
+{
+    unsigned int pc = (unsigned int)avr_pop(avr)<<8;
+    return pc | avr_pop(avr);
+}
+
+static unsigned int avr_word(const AVR *avr, unsigned char index)
+{
+    return avr->r[index] | ((unsigned int)avr->r[index + 1]<<8);
+}
+
+static void avr_set_word(AVR *avr, unsigned char index, unsigned int value)
+{
+    avr->r[index] = (unsigned char)value;
+    avr->r[index + 1] = (unsigned char)(value>>8);
+}
+
+static void avr_flags(AVR *avr, unsigned char mask, unsigned char flags)
+{
+    avr->sreg = (unsigned char)((avr->sreg & ~mask) | (flags & mask));
+}
+
+static unsigned char avr_nzs(unsigned char result, unsigned char v)
+{
+    unsigned char flags = v ? SREG_V : 0;
+
+    if(!result)
+    {
+        flags |= SREG_Z;
+    }
+
+    if(result & 0x80)
+    {
+        flags |= SREG_N;
+    }
+
+    if(((flags & SREG_N) != 0) != (v != 0))
+    {
+        flags |= SREG_S;
+    }
+    return flags;
+}
+
+static unsigned char avr_add(AVR *avr, unsigned char a, unsigned char b, unsigned char carry)
+{
+    unsigned char result = (unsigned char)(a + b + carry);
+    unsigned char c = (unsigned char)((a & b) | (b & ~result) | (~result & a));
+    unsigned char flags = avr_nzs(result, ((a & b & ~result) | (~a & ~b & result)) & 0x80);
+
+    if(c & 0x80)
+    {
+        flags |= SREG_C;
+    }
+
+    if(c & 0x08)
+    {
+        flags |= SREG_H;
+    }
+    avr_flags(avr, SREG_H | SREG_S | SREG_V | SREG_N | SREG_Z | SREG_C, flags);
+
+    return result;
+}
+
+static unsigned char avr_sub(AVR *avr, unsigned char a, unsigned char b, unsigned char carry, unsigned char keep_z)
+{
+    unsigned char result = (unsigned char)(a - b - carry);
+    unsigned char c = (unsigned char)((~a & b) | (b & result) | (result & ~a));
+    unsigned char flags = avr_nzs(result, ((a & ~b & ~result) | (~a & b & result)) & 0x80);
+
+    if(c & 0x80)
+    {
+        flags |= SREG_C;
+    }
+
+    if(c & 0x08)
+    {
+        flags |= SREG_H;
+    }
+
+    // SBC, SBCI and CPC only clear Z
+    if(keep_z && !(avr->sreg & SREG_Z))
+    {
+        flags &= (unsigned char)~SREG_Z;
+    }
+    avr_flags(avr, SREG_H | SREG_S | SREG_V | SREG_N | SREG_Z | SREG_C, flags);
+
+    return result;
+}
+
+static void avr_logic(AVR *avr, unsigned char result)
+{
+    avr_flags(avr, SREG_S | SREG_V | SREG_N | SREG_Z, avr_nzs(result, 0));
+}
+
+static void avr_shift(AVR *avr, unsigned char result, unsigned char carry)
+{
+    unsigned char n = (result & 0x80) ? 1 : 0;
+    unsigned char flags = avr_nzs(result, n ^ carry);
+
+    if(carry)
+    {
+        flags |= SREG_C;
+    }
+    avr_flags(avr, SREG_S | SREG_V | SREG_N | SREG_Z | SREG_C, flags);
+}
+
+static void avr_multiply(AVR *avr, unsigned int product, unsigned char fractional)
+{
+    unsigned char carry = (product & 0x8000) ? SREG_C : 0;
+
+    if(fractional)
+    {
+        product = (product<<1) & 0xFFFF;
+    }
+    avr_set_word(avr, 0, product);
+    avr_flags(avr, SREG_Z | SREG_C, carry | ((product & 0xFFFF) ? 0 : SREG_Z));
+}
+
+/**
+ * @brief Number of words to skip for a taken skip instruction.
+ *
+ * @details
+ * Called after the program counter has been advanced past the skip instruction, so it addresses the instruction to skip.
+ */
+static unsigned char avr_skip(const AVR *avr)
+{
+    return (avr->pc < (AVR_FLASH_SIZE / 2)) ? avr->code[avr->pc].words : 1;
+}
+
+static void avr_interrupt(AVR *avr, unsigned char vector)
+{
+    avr_push_pc(avr, avr->pc);
+    avr->pc = vector;
+    avr->level = 1;
+    avr->interrupts[vector]++;
+    avr_tick(avr, 2);
+
+    if(avr->observer.interrupt)
+    {
+        avr->observer.interrupt(avr, vector);
+    }
+}
+
+/**
+ * @brief Execute one instruction (or enter an interrupt, or sleep).
+ *
+ * @param avr Simulator.
+ *
+ * @return Execution state after the step.
+ *
+ * @details
+ * A sleeping CPU advances the clock to the next `TCA0` overflow, the end of a running peripheral operation or `avr->horizon`, whichever comes first. When nothing can wake the CPU, `AVR_Status_Halt` is returned.
+ */
+AVR_Status avr_step(AVR *avr)
+{
+    AVR_Instruction *instruction;
+    unsigned char vector;
+    unsigned long cycles;
+    unsigned int pc;
+
+    if((avr->status != AVR_Status_Run) && (avr->status != AVR_Status_Sleep))
+    {
+        return avr->status;
+    }
+
+    vector = avr_pending(avr);
+
+    if(vector && (avr->sreg & SREG_I) && !avr->level)
+    {
+        avr->status = AVR_Status_Run;
+        avr_interrupt(avr, vector);
+        return avr->status;
+    }
+
+    if(avr->status == AVR_Status_Sleep)
+    {
+        unsigned char timer = (avr->io[AVR_IO_TCA0_CTRLA] & 0x01) && !(avr->io[AVR_IO_SLPCTRL_CTRLA] & 0x06);
+        unsigned long long wait = (avr->horizon > avr->cycles) ? (avr->horizon - avr->cycles) : 0;
+
+        // Nothing left that could wake the CPU (pin changes are only applied by the caller at the horizon)
+        if(!timer && !avr->spi_busy && !avr->adc_busy && (avr->horizon == ~0ULL))
+        {
+            avr->status = AVR_Status_Halt;
+            return avr->status;
+        }
+
+        if(!wait)
+        {
+            return AVR_Status_Sleep;
+        }
+
+        if(avr->spi_busy && (avr->spi_busy < wait))
+        {
+            wait = avr->spi_busy;
+        }
+
+        if(avr->adc_busy && (avr->adc_busy < wait))
+        {
+            wait = avr->adc_busy;
+        }
+
+        // Idle mode keeps TCA0 running, the next overflow is at most one period away
+        if(timer)
+        {
+            static const unsigned int prescaler[8] = { 1, 2, 4, 8, 16, 64, 256, 1024 };
+            unsigned long period = (unsigned long)(avr->io[AVR_IO_TCA0_PERL] | ((unsigned int)avr->io[AVR_IO_TCA0_PERH]<<8)) + 1UL;
+            unsigned long count = avr->io[AVR_IO_TCA0_CNTL] | ((unsigned int)avr->io[AVR_IO_TCA0_CNTH]<<8);
+            unsigned long long overflow = (unsigned long long)(period - count) * prescaler[(avr->io[AVR_IO_TCA0_CTRLA]>>1) & 0x07] - avr->tca_prescale;
+
+            if(overflow && (overflow < wait))
+            {
+                wait = overflow;
+            }
+        }
+
+        if(wait > 0x40000000ULL)
+        {
+            wait = 0x40000000ULL;
+        }
+        avr_tick(avr, (unsigned long)wait);
+
+        return avr->status;
+    }
+
+    pc = avr->pc;
+
+    if(pc >= (AVR_FLASH_SIZE / 2))
+    {
+        avr->status = AVR_Status_Error;
+        return avr->status;
+    }
+    instruction = &avr->code[pc];
+    cycles = instruction->cycles;
+    avr->pc = pc + instruction->words;
+
+    switch(instruction->op)
+    {
+        case AVR_Op_NOP:
+        case AVR_Op_WDR:
+        case AVR_Op_SPM:
+            break;
+        case AVR_Op_MOVW:
+            avr->r[instruction->d] = avr->r[instruction->r];
+            avr->r[instruction->d + 1] = avr->r[instruction->r + 1];
+            break;
+        case AVR_Op_MUL:
+            avr_multiply(avr, (unsigned int)avr->r[instruction->d] * avr->r[instruction->r], 0);
+            break;
+        case AVR_Op_MULS:
+            avr_multiply(avr, (unsigned int)((int)(signed char)avr->r[instruction->d] * (signed char)avr->r[instruction->r]) & 0xFFFF, 0);
+            break;
+        case AVR_Op_MULSU:
+            avr_multiply(avr, (unsigned int)((int)(signed char)avr->r[instruction->d] * avr->r[instruction->r]) & 0xFFFF, 0);
+            break;
+        case AVR_Op_FMUL:
+            avr_multiply(avr, (unsigned int)avr->r[instruction->d] * avr->r[instruction->r], 1);
+            break;
+        case AVR_Op_FMULS:
+            avr_multiply(avr, (unsigned int)((int)(signed char)avr->r[instruction->d] * (signed char)avr->r[instruction->r]) & 0xFFFF, 1);
+            break;
+        case AVR_Op_FMULSU:
+            avr_multiply(avr, (unsigned int)((int)(signed char)avr->r[instruction->d] * avr->r[instruction->r]) & 0xFFFF, 1);
+            break;
+        case AVR_Op_CPC:
+            avr_sub(avr, avr->r[instruction->d], avr->r[instruction->r], avr->sreg & SREG_C, 1);
+            break;
+        case AVR_Op_SBC:
+            avr->r[instruction->d] = avr_sub(avr, avr->r[instruction->d], avr->r[instruction->r], avr->sreg & SREG_C, 1);
+            break;
+        case AVR_Op_ADD:
+            avr->r[instruction->d] = avr_add(avr, avr->r[instruction->d], avr->r[instruction->r], 0);
+            break;
+        case AVR_Op_ADC:
+            avr->r[instruction->d] = avr_add(avr, avr->r[instruction->d], avr->r[instruction->r], avr->sreg & SREG_C);
+            break;
+        case AVR_Op_CPSE:
+            if(avr->r[instruction->d] == avr->r[instruction->r])
+            {
+                cycles += avr_skip(avr);
+                avr->pc += avr_skip(avr);
+            }
+            break;
+        case AVR_Op_CP:
+            avr_sub(avr, avr->r[instruction->d], avr->r[instruction->r], 0, 0);
+            break;
+        case AVR_Op_SUB:
+            avr->r[instruction->d] = avr_sub(avr, avr->r[instruction->d], avr->r[instruction->r], 0, 0);
+            break;
+        case AVR_Op_AND:
+            avr->r[instruction->d] &= avr->r[instruction->r];
+            avr_logic(avr, avr->r[instruction->d]);
+            break;
+        case AVR_Op_EOR:
+            avr->r[instruction->d] ^= avr->r[instruction->r];
+            avr_logic(avr, avr->r[instruction->d]);
+            break;
+        case AVR_Op_OR:
+            avr->r[instruction->d] |= avr->r[instruction->r];
+            avr_logic(avr, avr->r[instruction->d]);
+            break;
+        case AVR_Op_MOV:
+            avr->r[instruction->d] = avr->r[instruction->r];
+            break;
+        case AVR_Op_CPI:
+            avr_sub(avr, avr->r[instruction->d], (unsigned char)instruction->k, 0, 0);
+            break;
+        case AVR_Op_SBCI:
+            avr->r[instruction->d] = avr_sub(avr, avr->r[instruction->d], (unsigned char)instruction->k, avr->sreg & SREG_C, 1);
+            break;
+        case AVR_Op_SUBI:
+            avr->r[instruction->d] = avr_sub(avr, avr->r[instruction->d], (unsigned char)instruction->k, 0, 0);
+            break;
+        case AVR_Op_ORI:
+            avr->r[instruction->d] |= (unsigned char)instruction->k;
+            avr_logic(avr, avr->r[instruction->d]);
+            break;
+        case AVR_Op_ANDI:
+            avr->r[instruction->d] &= (unsigned char)instruction->k;
+            avr_logic(avr, avr->r[instruction->d]);
+            break;
+        case AVR_Op_LDD_Y:
+            avr->r[instruction->d] = avr_read(avr, (avr_word(avr, 28) + (unsigned int)instruction->k) & 0xFFFF);
+            break;
+        case AVR_Op_LDD_Z:
+            avr->r[instruction->d] = avr_read(avr, (avr_word(avr, 30) + (unsigned int)instruction->k) & 0xFFFF);
+            break;
+        case AVR_Op_STD_Y:
+            avr_write(avr, (avr_word(avr, 28) + (unsigned int)instruction->k) & 0xFFFF, avr->r[instruction->d]);
+            break;
+        case AVR_Op_STD_Z:
+            avr_write(avr, (avr_word(avr, 30) + (unsigned int)instruction->k) & 0xFFFF, avr->r[instruction->d]);
+            break;
+        case AVR_Op_LDS:
+            avr->r[instruction->d] = avr_read(avr, (unsigned int)instruction->k);
+            break;
+        case AVR_Op_STS:
+            avr_write(avr, (unsigned int)instruction->k, avr->r[instruction->d]);
+            break;
+        case AVR_Op_LD_X:
+        case AVR_Op_LD_XP:
+        case AVR_Op_LD_MX:
+        case AVR_Op_LD_YP:
+        case AVR_Op_LD_MY:
+        case AVR_Op_LD_ZP:
+        case AVR_Op_LD_MZ:
+        {
+            static const unsigned char pointer[] = { 26, 26, 26, 28, 28, 30, 30 };
+            static const signed char step[] = { 0, 1, -1, 1, -1, 1, -1 };
+            unsigned char index = (unsigned char)(instruction->op - AVR_Op_LD_X);
+            unsigned int address = avr_word(avr, pointer[index]);
+
+            if(step[index] < 0)
+            {
+                address = (address - 1) & 0xFFFF;
+                avr_set_word(avr, pointer[index], address);
+            }
+            avr->r[instruction->d] = avr_read(avr, address);
+
+            if(step[index] > 0)
+            {
+                avr_set_word(avr, pointer[index], (address + 1) & 0xFFFF);
+            }
+            break;
+        }
+        case AVR_Op_ST_X:
+        case AVR_Op_ST_XP:
+        case AVR_Op_ST_MX:
+        case AVR_Op_ST_YP:
+        case AVR_Op_ST_MY:
+        case AVR_Op_ST_ZP:
+        case AVR_Op_ST_MZ:
+        {
+            static const unsigned char pointer[] = { 26, 26, 26, 28, 28, 30, 30 };
+            static const signed char step[] = { 0, 1, -1, 1, -1, 1, -1 };
+            unsigned char index = (unsigned char)(instruction->op - AVR_Op_ST_X);
+            unsigned int address = avr_word(avr, pointer[index]);
+            unsigned char value = avr->r[instruction->d];
+
+            if(step[index] < 0)
+            {
+                address = (address - 1) & 0xFFFF;
+                avr_set_word(avr, pointer[index], address);
+            }
+            else if(step[index] > 0)
+            {
+                avr_set_word(avr, pointer[index], (address + 1) & 0xFFFF);
+            }
+            avr_write(avr, address, value);
+            break;
+        }
+        case AVR_Op_LPM:
+        case AVR_Op_LPM_Z:
+        case AVR_Op_LPM_ZP:
+        {
+            unsigned int address = avr_word(avr, 30);
+            unsigned char value = (address < AVR_FLASH_SIZE) ? avr->image->flash[address] : 0xFF;
+
+            avr->r[(instruction->op == AVR_Op_LPM) ? 0 : instruction->d] = value;
+
+            if(instruction->op == AVR_Op_LPM_ZP)
+            {
+                avr_set_word(avr, 30, (address + 1) & 0xFFFF);
+            }
+            break;
+        }
+        case AVR_Op_POP:
+            avr->r[instruction->d] = avr_pop(avr);
+            break;
+        case AVR_Op_PUSH:
+            avr_push(avr, avr->r[instruction->d]);
+            break;
+        case AVR_Op_COM:
+            avr->r[instruction->d] = (unsigned char)~avr->r[instruction->d];
+            avr_flags(avr, SREG_S | SREG_V | SREG_N | SREG_Z | SREG_C, avr_nzs(avr->r[instruction->d], 0) | SREG_C);
+            break;
+        case AVR_Op_NEG:
+        {
+            unsigned char value = avr->r[instruction->d];
+            avr->r[instruction->d] = avr_sub(avr, 0, value, 0, 0);
+            break;
+        }
+        case AVR_Op_SWAP:
+            avr->r[instruction->d] = (unsigned char)((avr->r[instruction->d]<<4) | (avr->r[instruction->d]>>4));
+            break;
+        case AVR_Op_INC:
+            avr->r[instruction->d]++;
+            avr_flags(avr, SREG_S | SREG_V | SREG_N | SREG_Z, avr_nzs(avr->r[instruction->d], avr->r[instruction->d] == 0x80));
+            break;
+        case AVR_Op_DEC:
+            avr->r[instruction->d]--;
+            avr_flags(avr, SREG_S | SREG_V | SREG_N | SREG_Z, avr_nzs(avr->r[instruction->d], avr->r[instruction->d] == 0x7F));
+            break;
+        case AVR_Op_ASR:
+        {
+            unsigned char value = avr->r[instruction->d];
+            avr->r[instruction->d] = (unsigned char)((value>>1) | (value & 0x80));
+            avr_shift(avr, avr->r[instruction->d], value & 0x01);
+            break;
+        }
+        case AVR_Op_LSR:
+        {
+            unsigned char value = avr->r[instruction->d];
+            avr->r[instruction->d] = value>>1;
+            avr_shift(avr, avr->r[instruction->d], value & 0x01);
+            break;
+        }
+        case AVR_Op_ROR:
+        {
+            unsigned char value = avr->r[instruction->d];
+            avr->r[instruction->d] = (unsigned char)((value>>1) | ((avr->sreg & SREG_C) ? 0x80 : 0x00));
+            avr_shift(avr, avr->r[instruction->d], value & 0x01);
+            break;
+        }
+        case AVR_Op_BSET:
+            avr->sreg |= (unsigned char)(1U<<instruction->d);
+            break;
+        case AVR_Op_BCLR:
+            avr->sreg &= (unsigned char)~(1U<<instruction->d);
+            break;
+        case AVR_Op_RET:
+            avr->pc = avr_pop_pc(avr);
+
+            if(avr->observer.ret)
+            {
+                avr->observer.ret(avr);
+            }
+            break;
+        case AVR_Op_RETI:
+            avr->pc = avr_pop_pc(avr);
+            avr->level = 0;
+
+            if(avr->observer.reti)
+            {
+                avr->observer.reti(avr);
+            }
+            break;
+        case AVR_Op_SLEEP:
+            if(avr->io[AVR_IO_SLPCTRL_CTRLA] & 0x01)
+            {
+                avr->status = AVR_Status_Sleep;
+            }
+            break;
+        case AVR_Op_BREAK:
+            avr->status = AVR_Status_Break;
+            break;
+        case AVR_Op_IJMP:
+            avr->pc = avr_word(avr, 30);
+            break;
+        case AVR_Op_ICALL:
+        case AVR_Op_RCALL:
+        case AVR_Op_CALL:
+        {
+            unsigned int target = (instruction->op == AVR_Op_ICALL) ? avr_word(avr, 30) :
+                                  (instruction->op == AVR_Op_CALL) ? (unsigned int)instruction->k :
+                                  (unsigned int)((int)avr->pc + instruction->k);
+
+            target &= (AVR_FLASH_SIZE / 2) - 1;
+            avr_push_pc(avr, avr->pc);
+            avr->pc = target;
+
+            if(avr->observer.call)
+            {
+                avr->observer.call(avr, 2UL * pc, 2UL * target);
+            }
+            break;
+        }
+        case AVR_Op_JMP:
+            avr->pc = (unsigned int)instruction->k;
+            break;
+        case AVR_Op_RJMP:
+            avr->pc = (unsigned int)((int)avr->pc + instruction->k) & ((AVR_FLASH_SIZE / 2) - 1);
+            break;
+        case AVR_Op_ADIW:
+        case AVR_Op_SBIW:
+        {
+            unsigned int value = avr_word(avr, instruction->d);
+            unsigned int result = (instruction->op == AVR_Op_ADIW) ? ((value + (unsigned int)instruction->k) & 0xFFFF) : ((value - (unsigned int)instruction->k) & 0xFFFF);
+            unsigned char flags = 0;
+            unsigned char v;
+            unsigned char c;
+
+            if(instruction->op == AVR_Op_ADIW)
+            {
+                v = (!(value & 0x8000) && (result & 0x8000));
+                c = (!(result & 0x8000) && (value & 0x8000));
+            }
+            else
+            {
+                v = ((value & 0x8000) && !(result & 0x8000));
+                c = ((result & 0x8000) && !(value & 0x8000));
+            }
+
+            if(!result)
+            {
+                flags |= SREG_Z;
+            }
+
+            if(result & 0x8000)
+            {
+                flags |= SREG_N;
+            }
+
+            if(v)
+            {
+                flags |= SREG_V;
+            }
+
+            if(c)
+            {
+                flags |= SREG_C;
+            }
+
+            if(((flags & SREG_N) != 0) != (v != 0))
+            {
+                flags |= SREG_S;
+            }
+            avr_set_word(avr, instruction->d, result);
+            avr_flags(avr, SREG_S | SREG_V | SREG_N | SREG_Z | SREG_C, flags);
+            break;
+        }
+        case AVR_Op_CBI:
+            avr_write(avr, (unsigned int)instruction->k, avr_read(avr, (unsigned int)instruction->k) & (unsigned char)~(1U<<instruction->r));
+            break;
+        case AVR_Op_SBI:
+            avr_write(avr, (unsigned int)instruction->k, avr_read(avr, (unsigned int)instruction->k) | (unsigned char)(1U<<instruction->r));
+            break;
+        case AVR_Op_SBIC:
+        case AVR_Op_SBIS:
+        {
+            unsigned char set = (avr_read(avr, (unsigned int)instruction->k)>>instruction->r) & 0x01;
+
+            if(set == (instruction->op == AVR_Op_SBIS))
+            {
+                cycles += avr_skip(avr);
+                avr->pc += avr_skip(avr);
+            }
+            break;
+        }
+        case AVR_Op_IN:
+            avr->r[instruction->d] = avr_read(avr, (unsigned int)instruction->k);
+            break;
+        case AVR_Op_OUT:
+            avr_write(avr, (unsigned int)instruction->k, avr->r[instruction->d]);
+            break;
+        case AVR_Op_LDI:
+            avr->r[instruction->d] = (unsigned char)instruction->k;
+            break;
+        case AVR_Op_BRBS:
+        case AVR_Op_BRBC:
+            if(((avr->sreg>>instruction->r) & 0x01) == (instruction->op == AVR_Op_BRBS))
+            {
+                avr->pc = (unsigned int)((int)avr->pc + instruction->k) & ((AVR_FLASH_SIZE / 2) - 1);
+                cycles++;
+            }
+            break;
+        case AVR_Op_BLD:
+            if(avr->sreg & SREG_T)
+            {
+                avr->r[instruction->d] |= (unsigned char)(1U<<instruction->r);
+            }
+            else
+            {
+                avr->r[instruction->d] &= (unsigned char)~(1U<<instruction->r);
+            }
+            break;
+        case AVR_Op_BST:
+            avr_flags(avr, SREG_T, ((avr->r[instruction->d]>>instruction->r) & 0x01) ? SREG_T : 0);
+            break;
+        case AVR_Op_SBRC:
+        case AVR_Op_SBRS:
+            if(((avr->r[instruction->d]>>instruction->r) & 0x01) == (instruction->op == AVR_Op_SBRS))
+            {
+                cycles += avr_skip(avr);
+                avr->pc += avr_skip(avr);
+            }
+            break;
+        default:
+            avr->pc = pc;
+            avr->status = AVR_Status_Error;
+            return avr->status;
+    }
+    avr_tick(avr, cycles);
+
+    return avr->status;
+}
+
+/**
+ * @brief Run the simulation for a number of cycles.
+ *
+ * @param avr Simulator.
+ * @param cycles Cycles to simulate.
+ *
+ * @return Execution state (`AVR_Status_Run`/`AVR_Status_Sleep` if the time elapsed).
+ */
+AVR_Status avr_run(AVR *avr, unsigned long long cycles)
+{
+    unsigned long long end = avr->cycles + cycles;
+    unsigned long long horizon = avr->horizon;
+
+    if(end < horizon)
+    {
+        avr->horizon = end;
+    }
+
+    while(avr->cycles < end)
+    {
+        AVR_Status status = avr_step(avr);
+
+        if((status != AVR_Status_Run) && (status != AVR_Status_Sleep))
+        {
+            break;
+        }
+
+        if((status == AVR_Status_Sleep) && (avr->cycles >= avr->horizon))
+        {
+            break;
+        }
+    }
+    avr->horizon = horizon;
+
+    return avr->status;
+}
+
+/**
+ * @brief Run from the current state until the program counter reaches an address.
+ *
+ * @param avr Simulator.
+ * @param address Byte address in flash (e.g. of `main`).
+ * @param limit Maximum number of cycles.
+ *
+ * @return `0` if the address was reached, `-1` otherwise.
+ */
+int avr_run_to(AVR *avr, unsigned long address, unsigned long long limit)
+{
+    unsigned long long end = avr->cycles + limit;
+
+    while((avr->pc != (address / 2)) || (avr->status == AVR_Status_Sleep))
+    {
+        if((avr->cycles >= end) || (avr_step(avr) > AVR_Status_Sleep))
+        {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Call a firmware function and run until it returns.
+ *
+ * @param avr Simulator.
+ * @param address Byte address of the function.
+ * @param arguments Argument bytes (little endian, concatenated).
+ * @param sizes Size of every argument in bytes.
+ * @param count Number of arguments.
+ * @param limit Maximum number of cycles.
+ *
+ * @return `0` on success, `-1` if the function did not return within `limit` or the CPU stopped.
+ *
+ * @details
+ * Arguments are assigned to registers following the avr-gcc calling convention (starting at `r25` downwards, every argument aligned to an even register). The return value is left in `r24`/`r25` (`r22`-`r25` for 4 bytes). Interrupts stay as configured by the firmware.
+ */
+int avr_call(AVR *avr, unsigned long address, const unsigned char *arguments, const unsigned char *sizes, unsigned char count, unsigned long long limit)
+{
+    unsigned int sentinel = (AVR_FLASH_SIZE / 2) - 1;
+    unsigned int sp = avr->sp;
+    unsigned long long end = avr->cycles + limit;
+    unsigned char reg = 26;
+
+    for(unsigned char i=0; i < count; i++)
+    {
+        reg = (unsigned char)(reg - ((sizes[i] + 1U) & ~1U));
+
+        for(unsigned char j=0; j < sizes[i]; j++)
+        {
+            avr->r[reg + j] = *arguments++;
+        }
+    }
+
+    // Return into the last flash word, which is never reached by regular code
+    avr_push_pc(avr, sentinel);
+    avr->pc = (unsigned int)(address / 2);
+
+    while((avr->pc != sentinel) || (avr->sp != sp))
+    {
+        if((avr->cycles >= end) || (avr_step(avr) > AVR_Status_Sleep))
+        {
+            return -1;
+        }
+    }
+    return 0;
+}
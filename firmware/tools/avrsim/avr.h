@@ -0,0 +1,267 @@
+/**
+ * @file avr.h
+ * @brief Cycle-accurate simulator of the ATtiny402 (AVRxt core) for RCC firmware images.
+ *
+ * This header declares the simulated microcontroller: the AVRxt CPU core and the peripherals used by the RCC firmware (`PORTA`, `CLKCTRL`, `RSTCTRL`, `SLPCTRL`, `SPI0`, `ADC0`, `TCA0`, `TCB0` with the `TCA0` overflow event, `NVMCTRL`/EEPROM). The simulator executes avr-gcc ELF images and counts CPU cycles with the AVRxt instruction timing.
+ *
+ * Tools attach to the simulation through observer callbacks (SPI bytes, `GPIORn` writes, calls, returns and interrupts) and drive the environment through the pin and analog input state.
+ *
+ * @note Peripheral timing is modeled at transaction level (SPI byte, ADC conversion, EEPROM write); the CPU core itself is cycle exact for the AVRxt timing table. Bus wait states are not modeled.
+ *
+ * @author g.raf
+ * @date 2026-10-17
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger embedded systems project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/rcc "RCC - RGB LED Color Cube"
+ */
+
+#ifndef AVR_H_
+#define AVR_H_
+
+    #include "image.h"
+    #include "decode.h"
+
+    #ifndef AVR_OSCILLATOR
+        /**
+         * @def AVR_OSCILLATOR
+         * @brief Frequency of the internal 20 MHz oscillator (OSC20M) in Hertz.
+         */
+        #define AVR_OSCILLATOR 20000000UL
+    #endif
+
+    #ifndef AVR_FLASH_SIZE
+        /**
+         * @def AVR_FLASH_SIZE
+         * @brief Flash size of the simulated device in bytes (ATtiny402).
+         */
+        #define AVR_FLASH_SIZE 4096UL
+    #endif
+
+    /**
+     * @def AVR_FLASH_MAPPED
+     * @brief Start of the flash mapping in data space.
+     */
+    #define AVR_FLASH_MAPPED 0x8000U
+
+    /**
+     * @def AVR_RAM_START
+     * @brief Start of the internal SRAM in data space.
+     */
+    #define AVR_RAM_START 0x3F00U
+
+    /**
+     * @def AVR_RAM_END
+     * @brief Last address of the internal SRAM (`RAMEND`).
+     */
+    #define AVR_RAM_END 0x3FFFU
+
+    /**
+     * @def AVR_EEPROM_START
+     * @brief Start of the EEPROM in data space.
+     */
+    #define AVR_EEPROM_START 0x1400U
+
+    /**
+     * @def AVR_EEPROM_SIZE
+     * @brief EEPROM size in bytes.
+     */
+    #define AVR_EEPROM_SIZE 128U
+
+    #ifndef AVR_EEPROM_WRITE_NS
+        /**
+         * @def AVR_EEPROM_WRITE_NS
+         * @brief Duration of an EEPROM erase/write operation in nanoseconds (erase and write are half of it each).
+         */
+        #define AVR_EEPROM_WRITE_NS 4000000ULL
+    #endif
+
+    /**
+     * @def AVR_VECTORS
+     * @brief Number of interrupt vectors of the ATtiny402.
+     */
+    #define AVR_VECTORS 26
+
+    /**
+     * @def AVR_VECTOR_PORTA
+     * @brief Vector number of `PORTA_PORT_vect`.
+     */
+    #define AVR_VECTOR_PORTA 3
+
+    /**
+     * @def AVR_VECTOR_TCA0_OVF
+     * @brief Vector number of `TCA0_OVF_vect`.
+     */
+    #define AVR_VECTOR_TCA0_OVF 8
+
+    /**
+     * @def AVR_ANALOG_CHANNELS
+     * @brief Number of analog inputs selectable by `ADC0.MUXPOS`.
+     */
+    #define AVR_ANALOG_CHANNELS 32
+
+    // Data space addresses of the ATtiny402 registers (see iotn402.h)
+    #define AVR_IO_VPORTA_DIR               0x0000
+    #define AVR_IO_VPORTA_OUT               0x0001
+    #define AVR_IO_VPORTA_IN                0x0002
+    #define AVR_IO_VPORTA_INTFLAGS          0x0003
+    #define AVR_IO_GPIOR0                   0x001C
+    #define AVR_IO_GPIOR3                   0x001F
+    #define AVR_IO_CCP                      0x0034
+    #define AVR_IO_SPL                      0x003D
+    #define AVR_IO_SPH                      0x003E
+    #define AVR_IO_SREG                     0x003F
+    #define AVR_IO_RSTCTRL_RSTFR            0x0040
+    #define AVR_IO_RSTCTRL_SWRR             0x0041
+    #define AVR_IO_SLPCTRL_CTRLA            0x0050
+    #define AVR_IO_CLKCTRL_MCLKCTRLA        0x0060
+    #define AVR_IO_CLKCTRL_MCLKCTRLB        0x0061
+    #define AVR_IO_CLKCTRL_MCLKSTATUS       0x0063
+    #define AVR_IO_CPUINT_STATUS            0x0111
+    #define AVR_IO_EVSYS_SYNCCH0            0x018A
+    #define AVR_IO_EVSYS_ASYNCUSER0         0x0192
+    #define AVR_IO_PORTA_DIR                0x0400
+    #define AVR_IO_PORTA_DIRSET             0x0401
+    #define AVR_IO_PORTA_DIRCLR             0x0402
+    #define AVR_IO_PORTA_DIRTGL             0x0403
+    #define AVR_IO_PORTA_OUT                0x0404
+    #define AVR_IO_PORTA_OUTSET             0x0405
+    #define AVR_IO_PORTA_OUTCLR             0x0406
+    #define AVR_IO_PORTA_OUTTGL             0x0407
+    #define AVR_IO_PORTA_IN                 0x0408
+    #define AVR_IO_PORTA_INTFLAGS           0x0409
+    #define AVR_IO_PORTA_PIN0CTRL           0x0410
+    #define AVR_IO_ADC0_CTRLA               0x0600
+    #define AVR_IO_ADC0_CTRLB               0x0601
+    #define AVR_IO_ADC0_CTRLC               0x0602
+    #define AVR_IO_ADC0_CTRLD               0x0603
+    #define AVR_IO_ADC0_SAMPCTRL            0x0605
+    #define AVR_IO_ADC0_MUXPOS              0x0606
+    #define AVR_IO_ADC0_COMMAND             0x0608
+    #define AVR_IO_ADC0_INTCTRL             0x060A
+    #define AVR_IO_ADC0_INTFLAGS            0x060B
+    #define AVR_IO_ADC0_RESL                0x0610
+    #define AVR_IO_ADC0_RESH                0x0611
+    #define AVR_IO_SPI0_CTRLA               0x0820
+    #define AVR_IO_SPI0_INTFLAGS            0x0823
+    #define AVR_IO_SPI0_DATA                0x0824
+    #define AVR_IO_TCA0_CTRLA               0x0A00
+    #define AVR_IO_TCA0_INTCTRL             0x0A0A
+    #define AVR_IO_TCA0_INTFLAGS            0x0A0B
+    #define AVR_IO_TCA0_CNTL                0x0A20
+    #define AVR_IO_TCA0_CNTH                0x0A21
+    #define AVR_IO_TCA0_PERL                0x0A26
+    #define AVR_IO_TCA0_PERH                0x0A27
+    #define AVR_IO_TCB0_CTRLA               0x0A40
+    #define AVR_IO_TCB0_CTRLB               0x0A41
+    #define AVR_IO_TCB0_EVCTRL              0x0A44
+    #define AVR_IO_TCB0_INTFLAGS            0x0A46
+    #define AVR_IO_TCB0_CNTL                0x0A4A
+    #define AVR_IO_TCB0_CNTH                0x0A4B
+    #define AVR_IO_TCB0_CCMPL               0x0A4C
+    #define AVR_IO_TCB0_CCMPH               0x0A4D
+    #define AVR_IO_NVMCTRL_CTRLA            0x1000
+    #define AVR_IO_NVMCTRL_STATUS           0x1002
+
+    /**
+     * @enum AVR_Status_t
+     * @brief Execution state returned by the simulator.
+     */
+    enum AVR_Status_t
+    {
+        AVR_Status_Run=0,       /**< CPU executes instructions */
+        AVR_Status_Sleep,       /**< CPU sleeps and waits for an interrupt */
+        AVR_Status_Reset,       /**< Software reset requested (`RSTCTRL.SWRR`) */
+        AVR_Status_Halt,        /**< CPU sleeps without any possible wake-up source */
+        AVR_Status_Break,       /**< `BREAK` instruction executed */
+        AVR_Status_Error        /**< Invalid instruction or program counter */
+    };
+
+    /**
+     * @typedef AVR_Status
+     * @brief Alias for enum AVR_Status_t.
+     */
+    typedef enum AVR_Status_t AVR_Status;
+
+    typedef struct AVR_t AVR;
+
+    /**
+     * @struct AVR_Observer_t
+     * @brief Optional callbacks invoked by the simulator.
+     */
+    struct AVR_Observer_t
+    {
+        void (*spi)(AVR *avr, unsigned char data);                                  /**< Byte shifted out by `SPI0` */
+        void (*gpior)(AVR *avr, unsigned char index, unsigned char value);          /**< Write to `GPIORn` */
+        void (*call)(AVR *avr, unsigned long from, unsigned long to);               /**< Subroutine call (byte addresses) */
+        void (*ret)(AVR *avr);                                                      /**< Return from subroutine */
+        void (*interrupt)(AVR *avr, unsigned char vector);                          /**< Interrupt entry */
+        void (*reti)(AVR *avr);                                                     /**< Return from interrupt */
+        void (*eeprom)(AVR *avr, unsigned int address, unsigned char value);        /**< EEPROM cell written */
+    };
+
+    /**
+     * @typedef AVR_Observer
+     * @brief Alias for struct AVR_Observer_t.
+     */
+    typedef struct AVR_Observer_t AVR_Observer;
+
+    /**
+     * @struct AVR_t
+     * @brief State of the simulated microcontroller.
+     */
+    struct AVR_t
+    {
+        const IMAGE_Firmware *image;                    /**< Loaded firmware */
+        AVR_Instruction code[AVR_FLASH_SIZE / 2];       /**< Predecoded flash (per word) */
+
+        unsigned char r[32];                            /**< Register file */
+        unsigned char sreg;                             /**< Status register */
+        unsigned int sp;                                /**< Stack pointer */
+        unsigned int pc;                                /**< Program counter (word address) */
+        unsigned char io[0x4000];                       /**< I/O, peripheral and SRAM space */
+        unsigned char eeprom[AVR_EEPROM_SIZE];          /**< EEPROM contents */
+        unsigned char page[AVR_EEPROM_SIZE];            /**< NVM page buffer */
+        unsigned char page_loaded[AVR_EEPROM_SIZE];     /**< Page buffer bytes written since the last command */
+
+        AVR_Status status;                              /**< Execution state */
+        unsigned char level;                            /**< Interrupt level 0 executing (`CPUINT.STATUS.LVL0EX`) */
+        unsigned long long cycles;                      /**< Executed CPU cycles since power-on */
+        unsigned long long time_ps;                     /**< Time since power-on in picoseconds */
+        unsigned long period_ps;                        /**< Current CPU clock period in picoseconds */
+        unsigned long long horizon;                     /**< Cycle at which a sleeping CPU returns control to the caller */
+
+        unsigned long spi_busy;                         /**< Remaining cycles of the running SPI transfer */
+        unsigned long adc_busy;                         /**< Remaining cycles of the running ADC conversion */
+        unsigned long long nvm_busy_ps;                 /**< Remaining time of the running EEPROM operation */
+        unsigned long tca_prescale;                     /**< Peripheral cycles accumulated for the next `TCA0` count */
+        unsigned long tcb_prescale;                     /**< Peripheral cycles accumulated for the next `TCB0` count */
+
+        unsigned char pins;                             /**< External levels of the `PORTA` pins */
+        unsigned int analog[AVR_ANALOG_CHANNELS];       /**< ADC result per `MUXPOS` input */
+
+        unsigned long long interrupts[AVR_VECTORS];     /**< Executed interrupts per vector */
+        unsigned long eeprom_writes[AVR_EEPROM_SIZE];   /**< Erase/write cycles per EEPROM cell */
+
+        AVR_Observer observer;                          /**< Observer callbacks */
+        void *user;                                     /**< Tool specific data */
+    };
+
+    void avr_init(AVR *avr, const IMAGE_Firmware *image);
+    void avr_reset(AVR *avr, unsigned char flags);
+    AVR_Status avr_step(AVR *avr);
+    AVR_Status avr_run(AVR *avr, unsigned long long cycles);
+    int avr_call(AVR *avr, unsigned long address, const unsigned char *arguments, const unsigned char *sizes, unsigned char count, unsigned long long limit);
+    int avr_run_to(AVR *avr, unsigned long address, unsigned long long limit);
+
+    void avr_pin(AVR *avr, unsigned char pin, unsigned char level);
+    unsigned long avr_clock(const AVR *avr);
+    const char *avr_vector_name(unsigned char vector);
+    unsigned char avr_read(AVR *avr, unsigned int address);
+    void avr_write(AVR *avr, unsigned int address, unsigned char value);
+
+#endif /* AVR_H_ */
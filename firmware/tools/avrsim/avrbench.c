@@ -0,0 +1,379 @@
+/**
+ * @file avrbench.c
+ * @brief Cycle-accurate benchmarks of the RCC firmware hot paths on the simulated ATtiny402.
+ *
+ * This tool loads the AVR firmware image (ELF), runs the startup code up to `main()`, initializes the peripherals through the firmware functions and then calls the LED, SPI and ADC routines and the `TCA0` overflow ISR directly on the simulated CPU. For every operation the executed CPU cycles, the resulting device time at the configured clock and the host time of the simulator are reported.
+ *
+ * A baseline file (`<name> <cycles>` per line) stores the average cycles of every operation. Operations that exceed their baseline by more than the tolerance are reported as regression and make the tool exit with a failure. A baseline that can not be read, an operation without baseline entry and an operation that can not be executed (symbol not linked or call failed) fail the run as well.
+ *
+ * @author g.raf
+ * @date 2026-10-17
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger embedded systems project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/rcc "RCC - RGB LED Color Cube"
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "avr.h"
+
+#ifndef AVRBENCH_ITERATIONS
+    /**
+     * @def AVRBENCH_ITERATIONS
+     * @brief Default number of iterations per benchmark.
+     */
+    #define AVRBENCH_ITERATIONS 100UL
+#endif
+
+#ifndef AVRBENCH_TOLERANCE
+    /**
+     * @def AVRBENCH_TOLERANCE
+     * @brief Default tolerance in percent before an operation is reported as regression.
+     */
+    #define AVRBENCH_TOLERANCE 2.0
+#endif
+
+#ifndef AVRBENCH_LIMIT
+    /**
+     * @def AVRBENCH_LIMIT
+     * @brief Maximum number of cycles a single call may take.
+     */
+    #define AVRBENCH_LIMIT 10000000ULL
+#endif
+
+#ifndef AVRBENCH_BATTERY_CHANNEL
+    /**
+     * @def AVRBENCH_BATTERY_CHANNEL
+     * @brief `ADC0.MUXPOS` input of the battery measurement (`BATTERY_CHANNEL`).
+     */
+    #define AVRBENCH_BATTERY_CHANNEL 6
+#endif
+
+#ifndef AVRBENCH_BATTERY_VALUE
+    /**
+     * @def AVRBENCH_BATTERY_VALUE
+     * @brief ADC result applied to the battery channel.
+     */
+    #define AVRBENCH_BATTERY_VALUE 1000
+#endif
+
+/**
+ * @struct AVRBENCH_Call_t
+ * @brief Call of a firmware function with its arguments.
+ */
+struct AVRBENCH_Call_t
+{
+    const char *symbol;             /**< Function or vector symbol */
+    unsigned char arguments[5];     /**< Argument bytes (little endian, concatenated) */
+    unsigned char sizes[2];         /**< Size of every argument */
+    unsigned char count;            /**< Number of arguments */
+};
+
+/**
+ * @struct AVRBENCH_Case_t
+ * @brief Benchmarked operation (sequence of calls).
+ */
+struct AVRBENCH_Case_t
+{
+    const char *name;
+    struct AVRBENCH_Call_t calls[4];
+    unsigned char call_count;
+};
+
+// LED_Data = { intensity, red, green, blue }, LED_Position_Left | LED_Position_Right = 0x03
+static const struct AVRBENCH_Case_t avrbench_cases[] = {
+    { "spi_transfer",   { { "spi_transfer", { 0xA5 }, { 1 }, 1 } }, 1 },
+    { "led_data",       { { "led_data", { 0x0A, 0x12, 0x34, 0x56 }, { 4 }, 1 } }, 1 },
+    { "led_color",      { { "led_color", { 0x03, 0x0A, 0x12, 0x34, 0x56 }, { 1, 4 }, 2 } }, 1 },
+    { "leds_off",       { { "leds_off", { 0 }, { 0 }, 0 } }, 1 },
+    { "frame",          { { "led_xof", { 0x00 }, { 1 }, 1 },
+                          { "led_data", { 0x0A, 0x12, 0x34, 0x56 }, { 4 }, 1 },
+                          { "led_data", { 0x0A, 0x56, 0x34, 0x12 }, { 4 }, 1 },
+                          { "led_xof", { 0xFF }, { 1 }, 1 } }, 4 },
+    { "adc_average(8)", { { "adc_average", { 8 }, { 1 }, 1 } }, 1 },
+    { "battery_status", { { "battery_status", { 0 }, { 0 }, 0 } }, 1 },
+    { "TCA0_OVF_vect",  { { "__vector_8", { 0 }, { 0 }, 0 } }, 1 },
+};
+
+#define AVRBENCH_CASES (sizeof(avrbench_cases)/sizeof(avrbench_cases[0]))
+
+/**
+ * @struct AVRBENCH_Result_t
+ * @brief Measurement of a single operation.
+ */
+struct AVRBENCH_Result_t
+{
+    unsigned long long min;
+    unsigned long long max;
+    double average;
+    double device_us;
+    double host_ns;
+    unsigned long spi_bytes;
+    int valid;
+};
+
+static unsigned long avrbench_spi_bytes;
+
+static void avrbench_spi(AVR *avr, unsigned char data)
+{
+    (void)avr;
+    (void)data;
+    avrbench_spi_bytes++;
+}
+
+static double avrbench_now_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec * 1e9 + (double)now.tv_nsec;
+}
+
+static int avrbench_call(AVR *avr, const IMAGE_Firmware *image, const char *symbol, const unsigned char *arguments, const unsigned char *sizes, unsigned char count)
+{
+    const IMAGE_Symbol *function = image_symbol(image, symbol);
+
+    if(!function || (avr_call(avr, function->address, arguments, sizes, count, AVRBENCH_LIMIT) != 0))
+    {
+        return -1;
+    }
+    return 0;
+}
+
+static void avrbench_usage(const char *name)
+{
+    fprintf(stderr, "usage: %s [-n iterations] [-b baseline] [-t tolerance] [-w] firmware.elf\n", name);
+}
+
+/**
+ * @brief Look up the baseline cycles of an operation.
+ *
+ * @return Average cycles or a negative value if the operation is not part of the baseline.
+ */
+static double avrbench_baseline(FILE *file, const char *name)
+{
+    char line[128];
+    double cycles = -1.0;
+
+    rewind(file);
+
+    while(fgets(line, sizeof(line), file))
+    {
+        char entry[64];
+        double value;
+
+        if((line[0] == '#') || (sscanf(line, "%63s %lf", entry, &value) != 2))
+        {
+            continue;
+        }
+
+        if(!strcmp(entry, name))
+        {
+            cycles = value;
+        }
+    }
+
+    return cycles;
+}
+
+int main(int argc, char *argv[])
+{
+    static IMAGE_Firmware image;
+    static AVR avr;
+    static struct AVRBENCH_Result_t results[AVRBENCH_CASES];
+
+    unsigned long iterations = AVRBENCH_ITERATIONS;
+    double tolerance = AVRBENCH_TOLERANCE;
+    const char *baseline = NULL;
+    FILE *reference_file = NULL;
+    const IMAGE_Symbol *entry;
+    unsigned char write = 0;
+    unsigned char regressions = 0;
+    unsigned char failures = 0;
+    int option;
+
+    while((option = getopt(argc, argv, "n:b:t:w")) != -1)
+    {
+        switch(option)
+        {
+            case 'n': iterations = strtoul(optarg, NULL, 0); break;
+            case 'b': baseline = optarg; break;
+            case 't': tolerance = strtod(optarg, NULL); break;
+            case 'w': write = 1; break;
+            default:
+                avrbench_usage(argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    if((optind >= argc) || !iterations || (write && !baseline))
+    {
+        avrbench_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if(baseline && !write && !(reference_file = fopen(baseline, "r")))
+    {
+        fprintf(stderr, "%s: cannot read baseline %s (record it with -w)\n", argv[0], baseline);
+        return EXIT_FAILURE;
+    }
+
+    if(image_load(argv[optind], &image) != 0)
+    {
+        fprintf(stderr, "%s: cannot load firmware image %s\n", argv[0], argv[optind]);
+        return EXIT_FAILURE;
+    }
+
+    // Startup code (stack, .data, .bss) runs up to main(), peripherals are set up by the firmware itself
+    avr_init(&avr, &image);
+    avr.analog[AVRBENCH_BATTERY_CHANNEL] = AVRBENCH_BATTERY_VALUE;
+    entry = image_symbol(&image, "main");
+
+    if(!entry || (avr_run_to(&avr, entry->address, AVRBENCH_LIMIT) != 0) ||
+       (avrbench_call(&avr, &image, "system_init", NULL, NULL, 0) != 0) ||
+       (avrbench_call(&avr, &image, "led_init", NULL, NULL, 0) != 0) ||
+       (avrbench_call(&avr, &image, "battery_init", NULL, NULL, 0) != 0))
+    {
+        fprintf(stderr, "%s: firmware initialization failed\n", argv[0]);
+        image_free(&image);
+
+        if(reference_file)
+        {
+            fclose(reference_file);
+        }
+        return EXIT_FAILURE;
+    }
+    avr.observer.spi = avrbench_spi;
+
+    printf("firmware: %s (%lu bytes flash, %lu bytes RAM), CPU clock %lu Hz\n\n", argv[optind], image.flash_size, image.data_size, avr_clock(&avr));
+    printf("%-16s %10s %10s %10s %12s %12s %6s %10s\n", "operation", "min", "avg", "max", "device us", "host ns", "SPI", "baseline");
+
+    for(unsigned char i=0; i < AVRBENCH_CASES; i++)
+    {
+        const struct AVRBENCH_Case_t *test = &avrbench_cases[i];
+        struct AVRBENCH_Result_t *result = &results[i];
+        unsigned long long total = 0;
+        unsigned long long time_ps = avr.time_ps;
+        double reference = reference_file ? avrbench_baseline(reference_file, test->name) : -1.0;
+        double start;
+
+        result->min = ~0ULL;
+        avrbench_spi_bytes = 0;
+        start = avrbench_now_ns();
+
+        for(unsigned long j=0; j < iterations; j++)
+        {
+            unsigned long long cycles = avr.cycles;
+
+            result->valid = 0;
+
+            for(unsigned char k=0; k < test->call_count; k++)
+            {
+                const struct AVRBENCH_Call_t *call = &test->calls[k];
+
+                if(avrbench_call(&avr, &image, call->symbol, call->arguments, call->sizes, call->count) != 0)
+                {
+                    break;
+                }
+                result->valid = (k == (test->call_count - 1));
+            }
+
+            if(!result->valid)
+            {
+                break;
+            }
+            cycles = avr.cycles - cycles;
+            total += cycles;
+            result->min = (cycles < result->min) ? cycles : result->min;
+            result->max = (cycles > result->max) ? cycles : result->max;
+        }
+
+        if(!result->valid)
+        {
+            printf("%-16s %10s\n", test->name, "n/a (symbol not linked or call failed)");
+            failures++;
+            continue;
+        }
+        result->host_ns = (avrbench_now_ns() - start) / (double)iterations;
+        result->average = (double)total / (double)iterations;
+        result->device_us = (double)(avr.time_ps - time_ps) / 1e6 / (double)iterations;
+        result->spi_bytes = avrbench_spi_bytes / iterations;
+
+        printf("%-16s %10llu %10.1f %10llu %12.2f %12.1f %6lu", test->name, result->min, result->average, result->max, result->device_us, result->host_ns, result->spi_bytes);
+
+        if(!reference_file)
+        {
+            printf(" %10s\n", "-");
+        }
+        else if(reference < 0.0)
+        {
+            printf(" %10s\n", "missing");
+            failures++;
+        }
+        else if(result->average > (reference * (1.0 + tolerance / 100.0)))
+        {
+            printf(" %+9.1f%% REGRESSION\n", (result->average / reference - 1.0) * 100.0);
+            regressions++;
+        }
+        else
+        {
+            printf(" %+9.1f%%\n", (result->average / reference - 1.0) * 100.0);
+        }
+    }
+
+    if(reference_file)
+    {
+        fclose(reference_file);
+    }
+
+    if(write && failures)
+    {
+        printf("\n%u operation(s) could not be executed, baseline not written\n", failures);
+    }
+    else if(write)
+    {
+        FILE *file = fopen(baseline, "w");
+
+        if(!file)
+        {
+            fprintf(stderr, "%s: cannot write baseline %s\n", argv[0], baseline);
+            image_free(&image);
+            return EXIT_FAILURE;
+        }
+        fprintf(file, "# RCC cycle baseline (average CPU cycles per operation, written by rcc_avrbench -w)\n");
+
+        for(unsigned char i=0; i < AVRBENCH_CASES; i++)
+        {
+            if(results[i].valid)
+            {
+                fprintf(file, "%s %.1f\n", avrbench_cases[i].name, results[i].average);
+            }
+        }
+        fclose(file);
+        printf("\nbaseline written to %s\n", baseline);
+        regressions = 0;
+    }
+    else
+    {
+        if(failures)
+        {
+            printf("\n%u operation(s) could not be executed or have no baseline\n", failures);
+        }
+
+        if(regressions)
+        {
+            printf("\n%u operation(s) exceed the baseline by more than %.1f%%\n", regressions, tolerance);
+        }
+    }
+    image_free(&image);
+
+    return (regressions || failures) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
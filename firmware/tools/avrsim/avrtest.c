@@ -0,0 +1,261 @@
+/**
+ * @file avrtest.c
+ * @brief Unit tests of the instruction decoder and the AVRxt cycle counts of the AVR simulator.
+ *
+ * The tools of tools/avrsim (benchmarks, profile, energy, WCET and jitter) report cycles of the simulated ATtiny402, so their numbers are only as good as the decoder and the cycle model. This tool checks both against the AVR instruction set manual without a firmware image:
+ *
+ * - Decoder: hand-encoded opcodes (cross-checked with an AVR assembler) are decoded and disassembled, the mnemonic with its operands, the instruction size and the AVRxt base cycles have to match.
+ * - Execution: short programs are placed into an empty flash image and stepped on the simulated CPU, the total cycles (taken/not taken branches, skips over one- and two-word instructions, calls and returns, memory accesses), the program counter, the stack pointer and a result register have to match.
+ *
+ * Every failing check is printed and makes the tool exit with a failure.
+ *
+ * @author g.raf
+ * @date 2026-10-17
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger embedded systems project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/rcc "RCC - RGB LED Color Cube"
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "avr.h"
+
+/**
+ * @def AVRTEST_ADDRESS
+ * @brief Byte address used to disassemble the decoder cases (relative targets).
+ */
+#define AVRTEST_ADDRESS 0x0100UL
+
+/**
+ * @def AVRTEST_WORDS
+ * @brief Maximum number of words of an execution case.
+ */
+#define AVRTEST_WORDS 8
+
+/**
+ * @struct AVRTEST_Decode_t
+ * @brief Opcode with its expected decoding.
+ */
+struct AVRTEST_Decode_t
+{
+    unsigned int opcode;        /**< Instruction word */
+    unsigned int next;          /**< Following word (operand of 32-bit instructions) */
+    const char *text;           /**< Expected disassembly at `AVRTEST_ADDRESS` */
+    unsigned char words;        /**< Expected size in words */
+    unsigned char cycles;       /**< Expected AVRxt cycles (branch not taken, no skip) */
+};
+
+static const struct AVRTEST_Decode_t avrtest_decode[] = {
+    { 0x0000, 0, "nop",                 1, 1 },
+    { 0x01CF, 0, "movw r24, r30",       1, 1 },
+    { 0x020F, 0, "muls r16, r31",       1, 2 },
+    { 0x0312, 0, "mulsu r17, r18",      1, 2 },
+    { 0x033C, 0, "fmul r19, r20",       1, 2 },
+    { 0x03D6, 0, "fmuls r21, r22",      1, 2 },
+    { 0x03F8, 0, "fmulsu r23, r16",     1, 2 },
+    { 0x061F, 0, "cpc r1, r31",         1, 1 },
+    { 0x09F0, 0, "sbc r31, r0",         1, 1 },
+    { 0x0C12, 0, "add r1, r2",          1, 1 },
+    { 0x1034, 0, "cpse r3, r4",         1, 1 },
+    { 0x1789, 0, "cp r24, r25",         1, 1 },
+    { 0x1B01, 0, "sub r16, r17",        1, 1 },
+    { 0x1FEF, 0, "adc r30, r31",        1, 1 },
+    { 0x2056, 0, "and r5, r6",          1, 1 },
+    { 0x2411, 0, "eor r1, r1",          1, 1 },
+    { 0x2B89, 0, "or r24, r25",         1, 1 },
+    { 0x2E0F, 0, "mov r0, r31",         1, 1 },
+    { 0x3A85, 0, "cpi r24, 0xA5",       1, 1 },
+    { 0x4091, 0, "sbci r25, 0x01",      1, 1 },
+    { 0x5F0F, 0, "subi r16, 0xFF",      1, 1 },
+    { 0x6810, 0, "ori r17, 0x80",       1, 1 },
+    { 0x70FF, 0, "andi r31, 0x0F",      1, 1 },
+    { 0xAD8F, 0, "ldd r24, Y+63",       1, 2 },
+    { 0x8051, 0, "ldd r5, Z+1",         1, 2 },
+    { 0x832F, 0, "std Y+7, r18",        1, 1 },
+    { 0xA200, 0, "std Z+32, r0",        1, 1 },
+    { 0x9180, 0x3F00, "lds r24, 0x3F00", 2, 3 },
+    { 0x9390, 0x0A0B, "sts 0x0A0B, r25", 2, 2 },
+    { 0x901C, 0, "ld r1, X",            1, 2 },
+    { 0x902D, 0, "ld r2, X+",           1, 2 },
+    { 0x903E, 0, "ld r3, -X",           1, 2 },
+    { 0x9049, 0, "ld r4, Y+",           1, 2 },
+    { 0x905A, 0, "ld r5, -Y",           1, 2 },
+    { 0x9061, 0, "ld r6, Z+",           1, 2 },
+    { 0x9072, 0, "ld r7, -Z",           1, 2 },
+    { 0x928C, 0, "st X, r8",            1, 1 },
+    { 0x929D, 0, "st X+, r9",           1, 1 },
+    { 0x92AE, 0, "st -X, r10",          1, 1 },
+    { 0x92B9, 0, "st Y+, r11",          1, 1 },
+    { 0x92CA, 0, "st -Y, r12",          1, 1 },
+    { 0x92D1, 0, "st Z+, r13",          1, 1 },
+    { 0x92E2, 0, "st -Z, r14",          1, 1 },
+    { 0x95C8, 0, "lpm",                 1, 3 },
+    { 0x9184, 0, "lpm r24, Z",          1, 3 },
+    { 0x9195, 0, "lpm r25, Z+",         1, 3 },
+    { 0x91CF, 0, "pop r28",             1, 2 },
+    { 0x93DF, 0, "push r29",            1, 1 },
+    { 0x9410, 0, "com r1",              1, 1 },
+    { 0x9421, 0, "neg r2",              1, 1 },
+    { 0x9432, 0, "swap r3",             1, 1 },
+    { 0x9443, 0, "inc r4",              1, 1 },
+    { 0x9455, 0, "asr r5",              1, 1 },
+    { 0x9466, 0, "lsr r6",              1, 1 },
+    { 0x9477, 0, "ror r7",              1, 1 },
+    { 0x948A, 0, "dec r8",              1, 1 },
+    { 0x9478, 0, "bset 7",              1, 1 },
+    { 0x94F8, 0, "bclr 7",              1, 1 },
+    { 0x9508, 0, "ret",                 1, 4 },
+    { 0x9518, 0, "reti",                1, 4 },
+    { 0x9588, 0, "sleep",               1, 1 },
+    { 0x9598, 0, "break",               1, 1 },
+    { 0x95A8, 0, "wdr",                 1, 1 },
+    { 0x95E8, 0, "spm",                 1, 1 },
+    { 0x9409, 0, "ijmp",                1, 2 },
+    { 0x9509, 0, "icall",               1, 2 },
+    { 0x940C, 0x07FF, "jmp 0x0FFE",     2, 3 },
+    { 0x940E, 0x0080, "call 0x0100",    2, 3 },
+    { 0x96CF, 0, "adiw r24, 63",        1, 2 },
+    { 0x9731, 0, "sbiw r30, 1",         1, 2 },
+    { 0x98FF, 0, "cbi 0x1F, 7",         1, 1 },
+    { 0x9908, 0, "sbic 0x01, 0",        1, 1 },
+    { 0x9A03, 0, "sbi 0x00, 3",         1, 1 },
+    { 0x9B16, 0, "sbis 0x02, 6",        1, 1 },
+    { 0x9DF0, 0, "mul r31, r0",         1, 2 },
+    { 0xB78F, 0, "in r24, 0x3F",        1, 1 },
+    { 0xBFCD, 0, "out 0x3D, r28",       1, 1 },
+    { 0xCFFE, 0, "rjmp 0x00FE",         1, 2 },
+    { 0xD7FE, 0, "rcall 0x10FE",        1, 2 },
+    { 0xEC03, 0, "ldi r16, 0xC3",       1, 1 },
+    { 0xF201, 0, "brbs 1, 0x0082",      1, 1 },
+    { 0xF5F9, 0, "brbc 1, 0x0180",      1, 1 },
+    { 0xF895, 0, "bld r9, 5",           1, 1 },
+    { 0xFAA0, 0, "bst r10, 0",          1, 1 },
+    { 0xFCB7, 0, "sbrc r11, 7",         1, 1 },
+    { 0xFFF1, 0, "sbrs r31, 1",         1, 1 },
+    { 0x0001, 0, ".word",               1, 1 },
+    { 0x9003, 0, ".word",               1, 1 },
+    { 0x95F8, 0, ".word",               1, 1 },
+    { 0xF808, 0, ".word",               1, 1 },
+};
+
+/**
+ * @struct AVRTEST_Run_t
+ * @brief Program with its expected execution.
+ */
+struct AVRTEST_Run_t
+{
+    const char *name;                   /**< Case name */
+    unsigned int code[AVRTEST_WORDS];   /**< Program at flash address 0 */
+    unsigned char steps;                /**< Instructions to execute */
+    unsigned long cycles;               /**< Expected total cycles */
+    unsigned int pc;                    /**< Expected program counter (words) */
+    unsigned char reg;                  /**< Register checked after the run */
+    unsigned char value;                /**< Expected value of the register */
+};
+
+static const struct AVRTEST_Run_t avrtest_run[] = {
+    { "nop",                    { 0x0000 },                                         1,  1, 1,  0, 0x00 },
+    { "breq not taken",         { 0xF009 },                                         1,  1, 1,  0, 0x00 },
+    { "sez, breq taken",        { 0x9418, 0xF009 },                                 2,  3, 3,  0, 0x00 },
+    { "rjmp",                   { 0xC001 },                                         1,  2, 2,  0, 0x00 },
+    { "jmp",                    { 0x940C, 0x07FF },                                 1,  3, 0x07FF, 0, 0x00 },
+    { "cpse no skip",           { 0xE001, 0x1301, 0x0000 },                         2,  2, 2,  16, 0x01 },
+    { "cpse skip 1 word",       { 0x1301, 0x0000, 0x0000 },                         1,  2, 2,  0, 0x00 },
+    { "cpse skip 2 words",      { 0x1301, 0x9180, 0x3F00, 0x0000 },                 1,  3, 3,  0, 0x00 },
+    { "cpse skip before lds",   { 0x1301, 0x0000, 0x9180, 0x3F00 },                 1,  2, 2,  0, 0x00 },
+    { "sbrs skip",              { 0xE001, 0xFF00, 0x0000, 0x0000 },                 2,  3, 3,  16, 0x01 },
+    { "sbrc no skip",           { 0xE001, 0xFD00, 0x0000 },                         2,  2, 2,  16, 0x01 },
+    { "sbic skip",              { 0x9908, 0x0000, 0x0000 },                         1,  2, 2,  0, 0x00 },
+    { "sbis skip 2 words",      { 0x9A08, 0x9B08, 0x9300, 0x3F10, 0x0000 },         2,  4, 4,  0, 0x00 },
+    { "rcall, ret",             { 0xD001, 0x0000, 0x9508 },                         2,  6, 1,  0, 0x00 },
+    { "call, ret",              { 0x940E, 0x0003, 0x0000, 0x9508 },                 2,  7, 2,  0, 0x00 },
+    { "icall, ret",             { 0xE0E3, 0x9509, 0x0000, 0x9508 },                 3,  7, 2,  0, 0x00 },
+    { "push, pop",              { 0xE50A, 0x930F, 0x911F },                         3,  4, 3,  17, 0x5A },
+    { "sts, lds",               { 0xEA05, 0x9300, 0x3F10, 0x9110, 0x3F10 },         3,  6, 5,  17, 0xA5 },
+    { "st X+, ld -X",           { 0xE1A0, 0xE3BF, 0xE30C, 0x930D, 0x911E },         5,  6, 5,  17, 0x3C },
+    { "std Y+1, ldd Y+1",       { 0xE1C0, 0xE3DF, 0xE30C, 0x8309, 0x8119 },         5,  6, 5,  17, 0x3C },
+    { "lpm",                    { 0xE0E0, 0x9104 },                                 2,  4, 2,  16, 0xE0 },
+    { "adiw",                   { 0xEF8F, 0x9601 },                                 2,  3, 2,  25, 0x01 },
+    { "mul",                    { 0xE00C, 0xE01B, 0x9F01 },                         3,  4, 3,  0, 0x84 },
+};
+
+static unsigned char avrtest_check_decode(void)
+{
+    unsigned char failures = 0;
+
+    for(size_t i=0; i < (sizeof(avrtest_decode) / sizeof(avrtest_decode[0])); i++)
+    {
+        const struct AVRTEST_Decode_t *test = &avrtest_decode[i];
+        AVR_Instruction instruction = avr_decode(test->opcode, test->next);
+        char text[64];
+
+        avr_disassemble(&instruction, AVRTEST_ADDRESS, text, sizeof(text));
+
+        if(strcmp(text, test->text) || (instruction.words != test->words) || (instruction.cycles != test->cycles))
+        {
+            printf("FAIL decode 0x%04X: \"%s\" %u word(s) %u cycle(s), expected \"%s\" %u word(s) %u cycle(s)\n",
+                   test->opcode, text, instruction.words, instruction.cycles, test->text, test->words, test->cycles);
+            failures++;
+        }
+    }
+    return failures;
+}
+
+static unsigned char avrtest_check_run(void)
+{
+    static IMAGE_Firmware image;
+    static AVR avr;
+    unsigned char failures = 0;
+
+    for(size_t i=0; i < (sizeof(avrtest_run) / sizeof(avrtest_run[0])); i++)
+    {
+        const struct AVRTEST_Run_t *test = &avrtest_run[i];
+        AVR_Status status = AVR_Status_Run;
+
+        memset(image.flash, 0xFF, AVR_FLASH_SIZE);
+
+        for(unsigned char j=0; j < AVRTEST_WORDS; j++)
+        {
+            image.flash[2 * j] = (unsigned char)(test->code[j] & 0xFF);
+            image.flash[2 * j + 1] = (unsigned char)(test->code[j]>>8);
+        }
+        avr_init(&avr, &image);
+
+        for(unsigned char j=0; (j < test->steps) && (status == AVR_Status_Run); j++)
+        {
+            status = avr_step(&avr);
+        }
+
+        if((status != AVR_Status_Run) || (avr.cycles != test->cycles) || (avr.pc != test->pc) ||
+           (avr.sp != AVR_RAM_END) || (avr.r[test->reg] != test->value))
+        {
+            printf("FAIL run %s: %llu cycle(s) pc 0x%04X sp 0x%04X r%u 0x%02X status %d, expected %lu cycle(s) pc 0x%04X sp 0x%04X r%u 0x%02X\n",
+                   test->name, avr.cycles, avr.pc, avr.sp, test->reg, avr.r[test->reg], (int)status,
+                   test->cycles, test->pc, (unsigned int)AVR_RAM_END, test->reg, test->value);
+            failures++;
+        }
+    }
+    return failures;
+}
+
+int main(void)
+{
+    unsigned int failures = 0;
+
+    failures += avrtest_check_decode();
+    failures += avrtest_check_run();
+
+    printf("avrtest: %zu decoder and %zu execution cases, %u failure(s)\n",
+           sizeof(avrtest_decode) / sizeof(avrtest_decode[0]),
+           sizeof(avrtest_run) / sizeof(avrtest_run[0]),
+           failures);
+
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,366 @@
+/**
+ * @file decode.c
+ * @brief AVRxt instruction decoder and timing table.
+ *
+ * This source file decodes 16/32-bit AVR opcodes into `AVR_Instruction` records and formats them as assembler text. Instructions that do not exist on AVRxt devices with up to 64 KiB flash (`ELPM`, `EIJMP`, `EICALL`, `DES`, `XCH`, `LAS`, `LAC`, `LAT`) are decoded as `AVR_Op_Unknown`.
+ *
+ * @author g.raf
+ * @date 2026-10-17
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger embedded systems project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/rcc "RCC - RGB LED Color Cube"
+ */
+
+#include <stdio.h>
+
+#include "decode.h"
+
+/**
+ * @brief Mnemonic and AVRxt base cycles per instruction.
+ */
+static const struct
+{
+    const char *mnemonic;
+    unsigned char cycles;
+} avr_ops[AVR_Op_Count] = {
+    [AVR_Op_Unknown] = { ".word", 1 },
+    [AVR_Op_NOP]     = { "nop",   1 }, [AVR_Op_MOVW]   = { "movw",  1 },
+    [AVR_Op_MULS]    = { "muls",  2 }, [AVR_Op_MULSU]  = { "mulsu", 2 },
+    [AVR_Op_FMUL]    = { "fmul",  2 }, [AVR_Op_FMULS]  = { "fmuls", 2 }, [AVR_Op_FMULSU] = { "fmulsu", 2 },
+    [AVR_Op_CPC]     = { "cpc",   1 }, [AVR_Op_SBC]    = { "sbc",   1 }, [AVR_Op_ADD]    = { "add",   1 },
+    [AVR_Op_CPSE]    = { "cpse",  1 }, [AVR_Op_CP]     = { "cp",    1 }, [AVR_Op_SUB]    = { "sub",   1 },
+    [AVR_Op_ADC]     = { "adc",   1 }, [AVR_Op_AND]    = { "and",   1 }, [AVR_Op_EOR]    = { "eor",   1 },
+    [AVR_Op_OR]      = { "or",    1 }, [AVR_Op_MOV]    = { "mov",   1 },
+    [AVR_Op_CPI]     = { "cpi",   1 }, [AVR_Op_SBCI]   = { "sbci",  1 }, [AVR_Op_SUBI]   = { "subi",  1 },
+    [AVR_Op_ORI]     = { "ori",   1 }, [AVR_Op_ANDI]   = { "andi",  1 },
+    [AVR_Op_LDD_Y]   = { "ldd",   2 }, [AVR_Op_LDD_Z]  = { "ldd",   2 },
+    [AVR_Op_STD_Y]   = { "std",   1 }, [AVR_Op_STD_Z]  = { "std",   1 },
+    [AVR_Op_LDS]     = { "lds",   3 }, [AVR_Op_STS]    = { "sts",   2 },
+    [AVR_Op_LD_X]    = { "ld",    2 }, [AVR_Op_LD_XP]  = { "ld",    2 }, [AVR_Op_LD_MX]  = { "ld",    2 },
+    [AVR_Op_LD_YP]   = { "ld",    2 }, [AVR_Op_LD_MY]  = { "ld",    2 },
+    [AVR_Op_LD_ZP]   = { "ld",    2 }, [AVR_Op_LD_MZ]  = { "ld",    2 },
+    [AVR_Op_ST_X]    = { "st",    1 }, [AVR_Op_ST_XP]  = { "st",    1 }, [AVR_Op_ST_MX]  = { "st",    1 },
+    [AVR_Op_ST_YP]   = { "st",    1 }, [AVR_Op_ST_MY]  = { "st",    1 },
+    [AVR_Op_ST_ZP]   = { "st",    1 }, [AVR_Op_ST_MZ]  = { "st",    1 },
+    [AVR_Op_LPM]     = { "lpm",   3 }, [AVR_Op_LPM_Z]  = { "lpm",   3 }, [AVR_Op_LPM_ZP] = { "lpm",   3 },
+    [AVR_Op_POP]     = { "pop",   2 }, [AVR_Op_PUSH]   = { "push",  1 },
+    [AVR_Op_COM]     = { "com",   1 }, [AVR_Op_NEG]    = { "neg",   1 }, [AVR_Op_SWAP]   = { "swap",  1 },
+    [AVR_Op_INC]     = { "inc",   1 }, [AVR_Op_ASR]    = { "asr",   1 }, [AVR_Op_LSR]    = { "lsr",   1 },
+    [AVR_Op_ROR]     = { "ror",   1 }, [AVR_Op_DEC]    = { "dec",   1 },
+    [AVR_Op_BSET]    = { "bset",  1 }, [AVR_Op_BCLR]   = { "bclr",  1 },
+    [AVR_Op_RET]     = { "ret",   4 }, [AVR_Op_RETI]   = { "reti",  4 },
+    [AVR_Op_SLEEP]   = { "sleep", 1 }, [AVR_Op_BREAK]  = { "break", 1 }, [AVR_Op_WDR]    = { "wdr",   1 },
+    [AVR_Op_SPM]     = { "spm",   1 },
+    [AVR_Op_IJMP]    = { "ijmp",  2 }, [AVR_Op_ICALL]  = { "icall", 2 },
+    [AVR_Op_JMP]     = { "jmp",   3 }, [AVR_Op_CALL]   = { "call",  3 },
+    [AVR_Op_ADIW]    = { "adiw",  2 }, [AVR_Op_SBIW]   = { "sbiw",  2 },
+    [AVR_Op_CBI]     = { "cbi",   1 }, [AVR_Op_SBIC]   = { "sbic",  1 },
+    [AVR_Op_SBI]     = { "sbi",   1 }, [AVR_Op_SBIS]   = { "sbis",  1 },
+    [AVR_Op_MUL]     = { "mul",   2 }, [AVR_Op_IN]     = { "in",    1 }, [AVR_Op_OUT]    = { "out",   1 },
+    [AVR_Op_RJMP]    = { "rjmp",  2 }, [AVR_Op_RCALL]  = { "rcall", 2 }, [AVR_Op_LDI]    = { "ldi",   1 },
+    [AVR_Op_BRBS]    = { "brbs",  1 }, [AVR_Op_BRBC]   = { "brbc",  1 },
+    [AVR_Op_BLD]     = { "bld",   1 }, [AVR_Op_BST]    = { "bst",   1 },
+    [AVR_Op_SBRC]    = { "sbrc",  1 }, [AVR_Op_SBRS]   = { "sbrs",  1 },
+};
+
+static AVR_Instruction avr_make(AVR_Op op, unsigned char d, unsigned char r, int k)
+{
+    AVR_Instruction instruction;
+
+    instruction.op = (unsigned char)op;
+    instruction.d = d;
+    instruction.r = r;
+    instruction.k = k;
+    instruction.words = ((op == AVR_Op_LDS) || (op == AVR_Op_STS) || (op == AVR_Op_JMP) || (op == AVR_Op_CALL)) ? 2 : 1;
+    instruction.cycles = avr_ops[op].cycles;
+
+    return instruction;
+}
+
+/**
+ * @brief Decode an instruction.
+ *
+ * @param opcode Instruction word at the program counter.
+ * @param next Following word (operand of 32-bit instructions).
+ *
+ * @return Decoded instruction (`AVR_Op_Unknown` for invalid opcodes).
+ */
+AVR_Instruction avr_decode(unsigned int opcode, unsigned int next)
+{
+    unsigned char d5 = (opcode>>4) & 0x1F;
+    unsigned char r5 = (unsigned char)((opcode & 0x0F) | ((opcode>>5) & 0x10));
+    unsigned char d4 = 16 + ((opcode>>4) & 0x0F);
+    int k8 = (int)(((opcode>>4) & 0xF0) | (opcode & 0x0F));
+
+    switch(opcode>>12)
+    {
+        case 0x0:
+            switch((opcode>>10) & 0x03)
+            {
+                case 0:
+                    switch((opcode>>8) & 0x03)
+                    {
+                        case 0: return avr_make((opcode == 0x0000) ? AVR_Op_NOP : AVR_Op_Unknown, 0, 0, 0);
+                        case 1: return avr_make(AVR_Op_MOVW, ((opcode>>4) & 0x0F)<<1, (opcode & 0x0F)<<1, 0);
+                        case 2: return avr_make(AVR_Op_MULS, d4, 16 + (opcode & 0x0F), 0);
+                        default:
+                        {
+                            static const AVR_Op ops[4] = { AVR_Op_MULSU, AVR_Op_FMUL, AVR_Op_FMULS, AVR_Op_FMULSU };
+                            return avr_make(ops[((opcode>>6) & 0x02) | ((opcode>>3) & 0x01)], 16 + ((opcode>>4) & 0x07), 16 + (opcode & 0x07), 0);
+                        }
+                    }
+                case 1: return avr_make(AVR_Op_CPC, d5, r5, 0);
+                case 2: return avr_make(AVR_Op_SBC, d5, r5, 0);
+                default: return avr_make(AVR_Op_ADD, d5, r5, 0);
+            }
+        case 0x1:
+        {
+            static const AVR_Op ops[4] = { AVR_Op_CPSE, AVR_Op_CP, AVR_Op_SUB, AVR_Op_ADC };
+            return avr_make(ops[(opcode>>10) & 0x03], d5, r5, 0);
+        }
+        case 0x2:
+        {
+            static const AVR_Op ops[4] = { AVR_Op_AND, AVR_Op_EOR, AVR_Op_OR, AVR_Op_MOV };
+            return avr_make(ops[(opcode>>10) & 0x03], d5, r5, 0);
+        }
+        case 0x3: return avr_make(AVR_Op_CPI, d4, 0, k8);
+        case 0x4: return avr_make(AVR_Op_SBCI, d4, 0, k8);
+        case 0x5: return avr_make(AVR_Op_SUBI, d4, 0, k8);
+        case 0x6: return avr_make(AVR_Op_ORI, d4, 0, k8);
+        case 0x7: return avr_make(AVR_Op_ANDI, d4, 0, k8);
+        case 0x8:
+        case 0xA:
+        {
+            int q = (int)(((opcode>>8) & 0x20) | ((opcode>>7) & 0x18) | (opcode & 0x07));
+            unsigned char y = (opcode & 0x08) ? 1 : 0;
+
+            if(opcode & 0x0200)
+            {
+                return avr_make(y ? AVR_Op_STD_Y : AVR_Op_STD_Z, d5, 0, q);
+            }
+            return avr_make(y ? AVR_Op_LDD_Y : AVR_Op_LDD_Z, d5, 0, q);
+        }
+        case 0x9:
+            switch((opcode>>8) & 0x0F)
+            {
+                case 0x0:
+                case 0x1:
+                {
+                    static const AVR_Op ops[16] = {
+                        AVR_Op_LDS, AVR_Op_LD_ZP, AVR_Op_LD_MZ, AVR_Op_Unknown,
+                        AVR_Op_LPM_Z, AVR_Op_LPM_ZP, AVR_Op_Unknown, AVR_Op_Unknown,
+                        AVR_Op_Unknown, AVR_Op_LD_YP, AVR_Op_LD_MY, AVR_Op_Unknown,
+                        AVR_Op_LD_X, AVR_Op_LD_XP, AVR_Op_LD_MX, AVR_Op_POP
+                    };
+                    return avr_make(ops[opcode & 0x0F], d5, 0, (int)(next & 0xFFFF));
+                }
+                case 0x2:
+                case 0x3:
+                {
+                    static const AVR_Op ops[16] = {
+                        AVR_Op_STS, AVR_Op_ST_ZP, AVR_Op_ST_MZ, AVR_Op_Unknown,
+                        AVR_Op_Unknown, AVR_Op_Unknown, AVR_Op_Unknown, AVR_Op_Unknown,
+                        AVR_Op_Unknown, AVR_Op_ST_YP, AVR_Op_ST_MY, AVR_Op_Unknown,
+                        AVR_Op_ST_X, AVR_Op_ST_XP, AVR_Op_ST_MX, AVR_Op_PUSH
+                    };
+                    return avr_make(ops[opcode & 0x0F], d5, 0, (int)(next & 0xFFFF));
+                }
+                case 0x4:
+                case 0x5:
+                    switch(opcode & 0x0F)
+                    {
+                        case 0x0: return avr_make(AVR_Op_COM, d5, 0, 0);
+                        case 0x1: return avr_make(AVR_Op_NEG, d5, 0, 0);
+                        case 0x2: return avr_make(AVR_Op_SWAP, d5, 0, 0);
+                        case 0x3: return avr_make(AVR_Op_INC, d5, 0, 0);
+                        case 0x5: return avr_make(AVR_Op_ASR, d5, 0, 0);
+                        case 0x6: return avr_make(AVR_Op_LSR, d5, 0, 0);
+                        case 0x7: return avr_make(AVR_Op_ROR, d5, 0, 0);
+                        case 0xA: return avr_make(AVR_Op_DEC, d5, 0, 0);
+                        case 0x8:
+                            if(!(opcode & 0x0100))
+                            {
+                                return avr_make((opcode & 0x0080) ? AVR_Op_BCLR : AVR_Op_BSET, (opcode>>4) & 0x07, 0, 0);
+                            }
+
+                            switch(opcode)
+                            {
+                                case 0x9508: return avr_make(AVR_Op_RET, 0, 0, 0);
+                                case 0x9518: return avr_make(AVR_Op_RETI, 0, 0, 0);
+                                case 0x9588: return avr_make(AVR_Op_SLEEP, 0, 0, 0);
+                                case 0x9598: return avr_make(AVR_Op_BREAK, 0, 0, 0);
+                                case 0x95A8: return avr_make(AVR_Op_WDR, 0, 0, 0);
+                                case 0x95C8: return avr_make(AVR_Op_LPM, 0, 0, 0);
+                                case 0x95E8: return avr_make(AVR_Op_SPM, 0, 0, 0);
+                                default: return avr_make(AVR_Op_Unknown, 0, 0, 0);
+                            }
+                        case 0x9:
+                            switch(opcode)
+                            {
+                                case 0x9409: return avr_make(AVR_Op_IJMP, 0, 0, 0);
+                                case 0x9509: return avr_make(AVR_Op_ICALL, 0, 0, 0);
+                                default: return avr_make(AVR_Op_Unknown, 0, 0, 0);
+                            }
+                        case 0xC:
+                        case 0xD:
+                        case 0xE:
+                        case 0xF:
+                        {
+                            // 22-bit address, the upper 6 bits are 0 on devices with up to 128 KiB flash
+                            int k = (int)((((opcode>>3) & 0x3E) | (opcode & 0x01))<<16) | (int)(next & 0xFFFF);
+                            return avr_make((opcode & 0x02) ? AVR_Op_CALL : AVR_Op_JMP, 0, 0, k);
+                        }
+                        default: return avr_make(AVR_Op_Unknown, 0, 0, 0);
+                    }
+                case 0x6:
+                case 0x7:
+                    return avr_make((opcode & 0x0100) ? AVR_Op_SBIW : AVR_Op_ADIW, 24 + (((opcode>>4) & 0x03)<<1), 0, (int)(((opcode>>2) & 0x30) | (opcode & 0x0F)));
+                case 0x8: return avr_make(AVR_Op_CBI, (opcode>>3) & 0x1F, opcode & 0x07, (opcode>>3) & 0x1F);
+                case 0x9: return avr_make(AVR_Op_SBIC, (opcode>>3) & 0x1F, opcode & 0x07, (opcode>>3) & 0x1F);
+                case 0xA: return avr_make(AVR_Op_SBI, (opcode>>3) & 0x1F, opcode & 0x07, (opcode>>3) & 0x1F);
+                case 0xB: return avr_make(AVR_Op_SBIS, (opcode>>3) & 0x1F, opcode & 0x07, (opcode>>3) & 0x1F);
+                default: return avr_make(AVR_Op_MUL, d5, r5, 0);
+            }
+        case 0xB:
+            return avr_make((opcode & 0x0800) ? AVR_Op_OUT : AVR_Op_IN, d5, d5, (int)(((opcode>>5) & 0x30) | (opcode & 0x0F)));
+        case 0xC:
+        case 0xD:
+        {
+            int k = (int)(opcode & 0x0FFF);
+
+            if(k & 0x0800)
+            {
+                k -= 0x1000;
+            }
+            return avr_make((opcode & 0x1000) ? AVR_Op_RCALL : AVR_Op_RJMP, 0, 0, k);
+        }
+        case 0xE: return avr_make(AVR_Op_LDI, d4, 0, k8);
+        default:
+            switch((opcode>>9) & 0x07)
+            {
+                case 0:
+                case 1:
+                case 2:
+                case 3:
+                {
+                    int k = (int)((opcode>>3) & 0x7F);
+
+                    if(k & 0x40)
+                    {
+                        k -= 0x80;
+                    }
+                    return avr_make((opcode & 0x0400) ? AVR_Op_BRBC : AVR_Op_BRBS, 0, opcode & 0x07, k);
+                }
+                case 4: return (opcode & 0x08) ? avr_make(AVR_Op_Unknown, 0, 0, 0) : avr_make(AVR_Op_BLD, d5, opcode & 0x07, 0);
+                case 5: return (opcode & 0x08) ? avr_make(AVR_Op_Unknown, 0, 0, 0) : avr_make(AVR_Op_BST, d5, opcode & 0x07, 0);
+                case 6: return (opcode & 0x08) ? avr_make(AVR_Op_Unknown, 0, 0, 0) : avr_make(AVR_Op_SBRC, d5, opcode & 0x07, 0);
+                default: return (opcode & 0x08) ? avr_make(AVR_Op_Unknown, 0, 0, 0) : avr_make(AVR_Op_SBRS, d5, opcode & 0x07, 0);
+            }
+    }
+}
+
+/**
+ * @brief Get the mnemonic of an instruction.
+ *
+ * @param op Instruction identifier.
+ *
+ * @return Lower case mnemonic.
+ */
+const char *avr_mnemonic(AVR_Op op)
+{
+    return (op < AVR_Op_Count) ? avr_ops[op].mnemonic : avr_ops[AVR_Op_Unknown].mnemonic;
+}
+
+/**
+ * @brief Format an instruction as assembler text.
+ *
+ * @param instruction Decoded instruction.
+ * @param address Byte address of the instruction (used for relative targets).
+ * @param text Output buffer.
+ * @param size Size of the output buffer.
+ */
+void avr_disassemble(const AVR_Instruction *instruction, unsigned long address, char *text, size_t size)
+{
+    static const char *pointers[] = { "X", "X+", "-X", "Y+", "-Y", "Z+", "-Z" };
+    const char *mnemonic = avr_mnemonic((AVR_Op)instruction->op);
+    unsigned char d = instruction->d;
+    unsigned char r = instruction->r;
+    int k = instruction->k;
+
+    switch(instruction->op)
+    {
+        case AVR_Op_NOP: case AVR_Op_RET: case AVR_Op_RETI: case AVR_Op_SLEEP: case AVR_Op_BREAK:
+        case AVR_Op_WDR: case AVR_Op_LPM: case AVR_Op_SPM: case AVR_Op_IJMP: case AVR_Op_ICALL:
+            snprintf(text, size, "%s", mnemonic);
+            break;
+        case AVR_Op_MOVW:
+            snprintf(text, size, "%s r%u, r%u", mnemonic, d, r);
+            break;
+        case AVR_Op_CPI: case AVR_Op_SBCI: case AVR_Op_SUBI: case AVR_Op_ORI: case AVR_Op_ANDI: case AVR_Op_LDI:
+            snprintf(text, size, "%s r%u, 0x%02X", mnemonic, d, k);
+            break;
+        case AVR_Op_LDD_Y: case AVR_Op_LDD_Z:
+            snprintf(text, size, "%s r%u, %c+%d", mnemonic, d, (instruction->op == AVR_Op_LDD_Y) ? 'Y' : 'Z', k);
+            break;
+        case AVR_Op_STD_Y: case AVR_Op_STD_Z:
+            snprintf(text, size, "%s %c+%d, r%u", mnemonic, (instruction->op == AVR_Op_STD_Y) ? 'Y' : 'Z', k, d);
+            break;
+        case AVR_Op_LDS:
+            snprintf(text, size, "%s r%u, 0x%04X", mnemonic, d, k);
+            break;
+        case AVR_Op_STS:
+            snprintf(text, size, "%s 0x%04X, r%u", mnemonic, k, d);
+            break;
+        case AVR_Op_LD_X: case AVR_Op_LD_XP: case AVR_Op_LD_MX: case AVR_Op_LD_YP: case AVR_Op_LD_MY: case AVR_Op_LD_ZP: case AVR_Op_LD_MZ:
+            snprintf(text, size, "%s r%u, %s", mnemonic, d, pointers[instruction->op - AVR_Op_LD_X]);
+            break;
+        case AVR_Op_ST_X: case AVR_Op_ST_XP: case AVR_Op_ST_MX: case AVR_Op_ST_YP: case AVR_Op_ST_MY: case AVR_Op_ST_ZP: case AVR_Op_ST_MZ:
+            snprintf(text, size, "%s %s, r%u", mnemonic, pointers[instruction->op - AVR_Op_ST_X], d);
+            break;
+        case AVR_Op_LPM_Z: case AVR_Op_LPM_ZP:
+            snprintf(text, size, "%s r%u, %s", mnemonic, d, (instruction->op == AVR_Op_LPM_Z) ? "Z" : "Z+");
+            break;
+        case AVR_Op_POP: case AVR_Op_PUSH: case AVR_Op_COM: case AVR_Op_NEG: case AVR_Op_SWAP: case AVR_Op_INC:
+        case AVR_Op_ASR: case AVR_Op_LSR: case AVR_Op_ROR: case AVR_Op_DEC:
+            snprintf(text, size, "%s r%u", mnemonic, d);
+            break;
+        case AVR_Op_BSET: case AVR_Op_BCLR:
+            snprintf(text, size, "%s %u", mnemonic, d);
+            break;
+        case AVR_Op_JMP: case AVR_Op_CALL:
+            snprintf(text, size, "%s 0x%04X", mnemonic, (unsigned int)k<<1);
+            break;
+        case AVR_Op_ADIW: case AVR_Op_SBIW:
+            snprintf(text, size, "%s r%u, %d", mnemonic, d, k);
+            break;
+        case AVR_Op_CBI: case AVR_Op_SBIC: case AVR_Op_SBI: case AVR_Op_SBIS:
+            snprintf(text, size, "%s 0x%02X, %u", mnemonic, k, r);
+            break;
+        case AVR_Op_IN:
+            snprintf(text, size, "%s r%u, 0x%02X", mnemonic, d, k);
+            break;
+        case AVR_Op_OUT:
+            snprintf(text, size, "%s 0x%02X, r%u", mnemonic, k, d);
+            break;
+        case AVR_Op_RJMP: case AVR_Op_RCALL:
+            snprintf(text, size, "%s 0x%04lX", mnemonic, (address + 2 + (unsigned long)((long)k * 2)) & 0xFFFF);
+            break;
+        case AVR_Op_BRBS: case AVR_Op_BRBC:
+            snprintf(text, size, "%s %u, 0x%04lX", mnemonic, r, (address + 2 + (unsigned long)((long)k * 2)) & 0xFFFF);
+            break;
+        case AVR_Op_BLD: case AVR_Op_BST: case AVR_Op_SBRC: case AVR_Op_SBRS:
+            snprintf(text, size, "%s r%u, %u", mnemonic, d, r);
+            break;
+        case AVR_Op_Unknown:
+            snprintf(text, size, "%s", mnemonic);
+            break;
+        default:
+            snprintf(text, size, "%s r%u, r%u", mnemonic, d, r);
+            break;
+    }
+}
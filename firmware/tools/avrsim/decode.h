@@ -0,0 +1,85 @@
+/**
+ * @file decode.h
+ * @brief AVRxt instruction decoder and timing table.
+ *
+ * This header declares the decoded representation of AVR instructions shared by the simulator and the static analysis tools. Cycle counts follow the AVRxt column of the AVR instruction set manual (tinyAVR 0/1/2, megaAVR 0, AVR Dx) for devices with a 16-bit program counter and internal SRAM.
+ *
+ * @author g.raf
+ * @date 2026-10-17
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger embedded systems project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/rcc "RCC - RGB LED Color Cube"
+ */
+
+#ifndef DECODE_H_
+#define DECODE_H_
+
+    #include <stddef.h>
+
+    /**
+     * @enum AVR_Op_t
+     * @brief Instruction identifiers.
+     */
+    enum AVR_Op_t
+    {
+        AVR_Op_Unknown=0,
+        AVR_Op_NOP, AVR_Op_MOVW, AVR_Op_MULS, AVR_Op_MULSU, AVR_Op_FMUL, AVR_Op_FMULS, AVR_Op_FMULSU,
+        AVR_Op_CPC, AVR_Op_SBC, AVR_Op_ADD, AVR_Op_CPSE, AVR_Op_CP, AVR_Op_SUB, AVR_Op_ADC,
+        AVR_Op_AND, AVR_Op_EOR, AVR_Op_OR, AVR_Op_MOV,
+        AVR_Op_CPI, AVR_Op_SBCI, AVR_Op_SUBI, AVR_Op_ORI, AVR_Op_ANDI,
+        AVR_Op_LDD_Y, AVR_Op_LDD_Z, AVR_Op_STD_Y, AVR_Op_STD_Z,
+        AVR_Op_LDS, AVR_Op_STS,
+        AVR_Op_LD_X, AVR_Op_LD_XP, AVR_Op_LD_MX, AVR_Op_LD_YP, AVR_Op_LD_MY, AVR_Op_LD_ZP, AVR_Op_LD_MZ,
+        AVR_Op_ST_X, AVR_Op_ST_XP, AVR_Op_ST_MX, AVR_Op_ST_YP, AVR_Op_ST_MY, AVR_Op_ST_ZP, AVR_Op_ST_MZ,
+        AVR_Op_LPM, AVR_Op_LPM_Z, AVR_Op_LPM_ZP, AVR_Op_POP, AVR_Op_PUSH,
+        AVR_Op_COM, AVR_Op_NEG, AVR_Op_SWAP, AVR_Op_INC, AVR_Op_ASR, AVR_Op_LSR, AVR_Op_ROR, AVR_Op_DEC,
+        AVR_Op_BSET, AVR_Op_BCLR,
+        AVR_Op_RET, AVR_Op_RETI, AVR_Op_SLEEP, AVR_Op_BREAK, AVR_Op_WDR, AVR_Op_SPM,
+        AVR_Op_IJMP, AVR_Op_ICALL, AVR_Op_JMP, AVR_Op_CALL,
+        AVR_Op_ADIW, AVR_Op_SBIW,
+        AVR_Op_CBI, AVR_Op_SBIC, AVR_Op_SBI, AVR_Op_SBIS,
+        AVR_Op_MUL, AVR_Op_IN, AVR_Op_OUT,
+        AVR_Op_RJMP, AVR_Op_RCALL, AVR_Op_LDI,
+        AVR_Op_BRBS, AVR_Op_BRBC, AVR_Op_BLD, AVR_Op_BST, AVR_Op_SBRC, AVR_Op_SBRS,
+        AVR_Op_Count
+    };
+
+    /**
+     * @typedef AVR_Op
+     * @brief Alias for enum AVR_Op_t.
+     */
+    typedef enum AVR_Op_t AVR_Op;
+
+    /**
+     * @struct AVR_Instruction_t
+     * @brief Decoded instruction.
+     *
+     * @details
+     * Meaning of the operand fields depends on the instruction: `d`/`r` are register numbers (or the bit number for bit instructions), `k` is an immediate, an I/O or data address, a displacement or a relative jump offset in words.
+     */
+    struct AVR_Instruction_t
+    {
+        unsigned char op;           /**< Instruction identifier (`AVR_Op`) */
+        unsigned char d;            /**< Destination register / I/O bit / SREG bit */
+        unsigned char r;            /**< Source register / bit number */
+        unsigned char words;        /**< Instruction size in words (1 or 2) */
+        unsigned char cycles;       /**< Cycles (branch not taken, no skip) */
+        int k;                      /**< Immediate, address, displacement or offset */
+    };
+
+    /**
+     * @typedef AVR_Instruction
+     * @brief Alias for struct AVR_Instruction_t.
+     */
+    typedef struct AVR_Instruction_t AVR_Instruction;
+
+    AVR_Instruction avr_decode(unsigned int opcode, unsigned int next);
+    const char *avr_mnemonic(AVR_Op op);
+    void avr_disassemble(const AVR_Instruction *instruction, unsigned long address, char *text, size_t size);
+
+#endif /* DECODE_H_ */
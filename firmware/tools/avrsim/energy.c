@@ -0,0 +1,422 @@
+/**
+ * @file energy.c
+ * @brief Energy model and battery lifetime estimate of the RCC firmware on the simulated ATtiny402.
+ *
+ * This tool replays a scenario with the AVR firmware image and integrates the supply current over the simulated time. The current is composed of the CPU state (active, idle, standby, power-down at the configured clock), the enabled ADC, running SPI transfers and the LEDs, whose latched mode, global intensity and PWM values are reconstructed from the SPI byte stream.
+ *
+ * The scenario charge is split per component and converted into an estimated lifetime of a CR2032 coin cell. With `-d <hours>` the usage profile is given as the time the cube is switched on per day: the average currents of the scenario while the cube is on and while it is switched off (CPU in standby or power-down) are then weighted with the daily on/off time.
+ *
+ * With `-t` the tool prints the relative light output of a color channel per global intensity level as C header instead (`RCC_FW_1_0/led/led_flux.h`, `make ledflux`). The global intensity sets the drive current of the channels, whose luminous efficacy is assumed to drop with the current (`ENERGY_LED_DROOP`). The same light then needs less current at a low global intensity and a high PWM, `led_balance()` uses the table to pick that split.
+ *
+ * @note All current figures are typical values at 3 V and 25 °C (ATtiny402 datasheet, T3A33BRG LEDs) and can be overridden at compile time (e.g. `-DENERGY_LED_CHANNEL_UA=4000`).
+ *
+ * @author g.raf
+ * @date 2026-10-17
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger embedded systems project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/rcc "RCC - RGB LED Color Cube"
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "session.h"
+#include "../sim/ledchain.h"
+
+#ifndef ENERGY_ACTIVE_UA_PER_MHZ
+    /**
+     * @def ENERGY_ACTIVE_UA_PER_MHZ
+     * @brief CPU current in active mode per MHz of `CLK_CPU`.
+     */
+    #define ENERGY_ACTIVE_UA_PER_MHZ 190.0
+#endif
+
+#ifndef ENERGY_IDLE_UA_PER_MHZ
+    /**
+     * @def ENERGY_IDLE_UA_PER_MHZ
+     * @brief Current in idle sleep mode per MHz of `CLK_PER`.
+     */
+    #define ENERGY_IDLE_UA_PER_MHZ 70.0
+#endif
+
+#ifndef ENERGY_STANDBY_UA
+    /**
+     * @def ENERGY_STANDBY_UA
+     * @brief Current in standby sleep mode.
+     */
+    #define ENERGY_STANDBY_UA 0.7
+#endif
+
+#ifndef ENERGY_POWERDOWN_UA
+    /**
+     * @def ENERGY_POWERDOWN_UA
+     * @brief Current in power-down sleep mode.
+     */
+    #define ENERGY_POWERDOWN_UA 0.1
+#endif
+
+#ifndef ENERGY_ADC_UA
+    /**
+     * @def ENERGY_ADC_UA
+     * @brief Additional current of the enabled ADC.
+     */
+    #define ENERGY_ADC_UA 325.0
+#endif
+
+#ifndef ENERGY_SPI_UA
+    /**
+     * @def ENERGY_SPI_UA
+     * @brief Additional current during a SPI transfer (SCK/MOSI toggling into the LED inputs).
+     */
+    #define ENERGY_SPI_UA 30.0
+#endif
+
+#ifndef ENERGY_LED_IDLE_UA
+    /**
+     * @def ENERGY_LED_IDLE_UA
+     * @brief Quiescent current of an enabled LED controller.
+     */
+    #define ENERGY_LED_IDLE_UA 450.0
+#endif
+
+#ifndef ENERGY_LED_SLEEP_UA
+    /**
+     * @def ENERGY_LED_SLEEP_UA
+     * @brief Quiescent current of an LED controller in sleep mode.
+     */
+    #define ENERGY_LED_SLEEP_UA 2.0
+#endif
+
+#ifndef ENERGY_LED_CHANNEL_UA
+    /**
+     * @def ENERGY_LED_CHANNEL_UA
+     * @brief Current of a single color channel at full PWM and full global intensity.
+     */
+    #define ENERGY_LED_CHANNEL_UA 5000.0
+#endif
+
+#ifndef ENERGY_LED_DROOP
+    /**
+     * @def ENERGY_LED_DROOP
+     * @brief Relative loss of luminous efficacy of a channel at full global intensity.
+     *
+     * @details
+     * The efficacy at global intensity `g` is modeled as `1 / (1 + ENERGY_LED_DROOP * g / 31)`. `0.0` makes light and current proportional for every split.
+     *
+     * @note `0.3` is an assumed figure, neither measured on the cube nor taken from the T3A33BRG datasheet. The LED current of the estimate (`energy_led()`) is linear in PWM times global intensity, only the light output of `-t` carries the droop.
+     */
+    #define ENERGY_LED_DROOP 0.3
+#endif
+
+#ifndef ENERGY_FLUX_LEVELS
+    /**
+     * @def ENERGY_FLUX_LEVELS
+     * @brief Number of global intensity levels in the light output table (5 bit field).
+     */
+    #define ENERGY_FLUX_LEVELS 32
+#endif
+
+#ifndef ENERGY_BATTERY_MAH
+    /**
+     * @def ENERGY_BATTERY_MAH
+     * @brief Usable capacity of the CR2032 coin cell.
+     */
+    #define ENERGY_BATTERY_MAH 225.0
+#endif
+
+/**
+ * @enum ENERGY_Component_t
+ * @brief Consumers the charge is accounted to.
+ */
+enum ENERGY_Component_t
+{
+    ENERGY_Component_Active=0,
+    ENERGY_Component_Sleep,
+    ENERGY_Component_ADC,
+    ENERGY_Component_SPI,
+    ENERGY_Component_LED,
+    ENERGY_Component_Count
+};
+
+static const char *const energy_components[ENERGY_Component_Count] = { "CPU active", "CPU sleep", "ADC", "SPI", "LEDs" };
+
+static LEDCHAIN energy_chain;
+static double energy_led_ua;
+
+/**
+ * @brief Calculate the current of a latched LED.
+ */
+static double energy_led(const LEDCHAIN_Led *led)
+{
+    double pwm = (double)led->red + (double)led->green + (double)led->blue;
+
+    switch(led->header & LEDCHAIN_MODE_MASK)
+    {
+        case LEDCHAIN_MODE_ENABLE:
+            return ENERGY_LED_IDLE_UA + ENERGY_LED_CHANNEL_UA * (pwm / 255.0) * ((double)(led->header & LEDCHAIN_INTENSITY_MASK) / 31.0);
+        case LEDCHAIN_MODE_SLEEP:
+            return ENERGY_LED_SLEEP_UA;
+        default:
+            return ENERGY_LED_IDLE_UA;
+    }
+}
+
+/**
+ * @brief Calculate the relative light output of a channel at full PWM.
+ *
+ * @param level Global intensity level (`0-31`).
+ *
+ * @return Light output relative to the full global intensity.
+ */
+static double energy_flux(unsigned char level)
+{
+    double drive = (double)level / 31.0;
+
+    return drive / (1.0 + ENERGY_LED_DROOP * drive) * (1.0 + ENERGY_LED_DROOP);
+}
+
+/**
+ * @brief Print the light output table for the firmware as C header.
+ */
+static void energy_flux_table(void)
+{
+    printf("/**\n");
+    printf(" * @file led_flux.h\n");
+    printf(" * @brief Relative light output of an LED channel per global intensity level.\n");
+    printf(" *\n");
+    printf(" * Generated by `make ledflux` (`rcc_energy -t`) from the LED model of the energy estimate with `ENERGY_LED_DROOP` %.2f, do not edit. The values are scaled to `65535` at the full global intensity.\n", ENERGY_LED_DROOP);
+    printf(" *\n");
+    printf(" * @note `ENERGY_LED_DROOP` is an assumed efficacy loss, not measured on the LEDs or taken from their datasheet. The model takes the channel current as linear in PWM times global intensity and lets only the light output drop with the intensity, so the savings of `led_balance()` hold only if the real LEDs droop the same way (`ENABLE_LED_BALANCE` is not defined by default).\n");
+    printf(" *\n");
+    printf(" * @author g.raf\n");
+    printf(" * @date 2026-10-17\n");
+    printf(" * @version 1.0 Release\n");
+    printf(" * @copyright\n");
+    printf(" * Copyright (c) 2026 g.raf\n");
+    printf(" * Released under the GPLv3 License. (see LICENSE in repository)\n");
+    printf(" *\n");
+    printf(" * @note This file is part of a larger embedded systems project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.\n");
+    printf(" *\n");
+    printf(" * @see https://github.com/0x007e/rcc \"RCC - RGB LED Color Cube\"\n");
+    printf(" */\n\n");
+    printf("#ifndef LED_FLUX_H_\n");
+    printf("#define LED_FLUX_H_\n\n");
+    printf("    /**\n");
+    printf("     * @def LED_FLUX_LEVELS\n");
+    printf("     * @brief Number of global intensity levels in `LED_FLUX`.\n");
+    printf("     */\n");
+    printf("    #define LED_FLUX_LEVELS %u\n\n", ENERGY_FLUX_LEVELS);
+    printf("    /**\n");
+    printf("     * @def LED_FLUX\n");
+    printf("     * @brief Initializer of the light output table, indexed by the global intensity level.\n");
+    printf("     */\n");
+    printf("    #define LED_FLUX { \\\n");
+
+    for(unsigned char i=0; i < ENERGY_FLUX_LEVELS; i++)
+    {
+        printf("%s%5lu%s", ((i % 8) ? " " : "        "), (unsigned long)(energy_flux(i) * 65535.0 + 0.5), ((i + 1) < ENERGY_FLUX_LEVELS) ? "," : "");
+
+        if(((i % 8) == 7) || ((i + 1) == ENERGY_FLUX_LEVELS))
+        {
+            printf(" \\\n");
+        }
+    }
+    printf("    }\n\n");
+    printf("#endif /* LED_FLUX_H_ */\n");
+}
+
+static void energy_spi(AVR *avr, unsigned char data)
+{
+    if(ledchain_byte(&energy_chain, avr->time_ps / 1000ULL, data) >= 0)
+    {
+        energy_led_ua = 0.0;
+
+        for(unsigned char i=0; i < LEDCHAIN_LEDS; i++)
+        {
+            energy_led_ua += energy_led(&energy_chain.led[i]);
+        }
+    }
+}
+
+/**
+ * @brief Calculate the current per component of the simulated device state.
+ *
+ * @param avr Simulator.
+ * @param current Current per component in microampere.
+ */
+static void energy_current(const AVR *avr, double current[ENERGY_Component_Count])
+{
+    double mhz = (double)avr_clock(avr) / 1e6;
+
+    for(unsigned char i=0; i < ENERGY_Component_Count; i++)
+    {
+        current[i] = 0.0;
+    }
+
+    if(avr->status == AVR_Status_Sleep)
+    {
+        switch(avr->io[AVR_IO_SLPCTRL_CTRLA] & 0x06)
+        {
+            case 0x00: current[ENERGY_Component_Sleep] = ENERGY_IDLE_UA_PER_MHZ * mhz; break;
+            case 0x02: current[ENERGY_Component_Sleep] = ENERGY_STANDBY_UA; break;
+            default:   current[ENERGY_Component_Sleep] = ENERGY_POWERDOWN_UA; break;
+        }
+    }
+    else
+    {
+        current[ENERGY_Component_Active] = ENERGY_ACTIVE_UA_PER_MHZ * mhz;
+    }
+
+    if(avr->io[AVR_IO_ADC0_CTRLA] & 0x01)
+    {
+        current[ENERGY_Component_ADC] = ENERGY_ADC_UA;
+    }
+
+    if(avr->spi_busy)
+    {
+        current[ENERGY_Component_SPI] = ENERGY_SPI_UA;
+    }
+    current[ENERGY_Component_LED] = energy_led_ua;
+}
+
+static void energy_usage(const char *name)
+{
+    fprintf(stderr, "usage: %s [-c capacity_mAh] [-d hours_on_per_day] firmware.elf scenario\n       %s -t\n", name, name);
+}
+
+int main(int argc, char *argv[])
+{
+    static IMAGE_Firmware image;
+    static AVR avr;
+
+    SESSION session;
+    SESSION_Status status = SESSION_Status_Run;
+    double capacity = ENERGY_BATTERY_MAH;
+    double hours = -1.0;
+    double charge[ENERGY_Component_Count] = { 0.0 };
+    double on_charge = 0.0;
+    double off_charge = 0.0;
+    double on_s = 0.0;
+    double off_s = 0.0;
+    double total = 0.0;
+    double average;
+    double seconds;
+    int option;
+
+    while((option = getopt(argc, argv, "c:d:t")) != -1)
+    {
+        switch(option)
+        {
+            case 'c': capacity = strtod(optarg, NULL); break;
+            case 'd': hours = strtod(optarg, NULL); break;
+            case 't':
+                energy_flux_table();
+                return EXIT_SUCCESS;
+            default:
+                energy_usage(argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    if(((optind + 2) != argc) || (capacity <= 0.0) || (hours > 24.0))
+    {
+        energy_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if(image_load(argv[optind], &image) != 0)
+    {
+        return EXIT_FAILURE;
+    }
+    avr_init(&avr, &image);
+
+    if(session_load(&session, &avr, argv[optind + 1]) < 0)
+    {
+        image_free(&image);
+        return EXIT_FAILURE;
+    }
+    ledchain_init(&energy_chain);
+    energy_led_ua = LEDCHAIN_LEDS * ENERGY_LED_IDLE_UA;
+    avr.observer.spi = energy_spi;
+
+    while((status != SESSION_Status_End) && (status != SESSION_Status_Error))
+    {
+        double current[ENERGY_Component_Count];
+        unsigned long long time_ps = avr.time_ps;
+        double step = 0.0;
+        double dt;
+        unsigned char off = (avr.status == AVR_Status_Sleep) && (avr.io[AVR_IO_SLPCTRL_CTRLA] & 0x06);
+
+        // The state before the step is valid for the time the step takes
+        energy_current(&avr, current);
+        status = session_step(&session);
+        dt = (double)(avr.time_ps - time_ps) * 1e-12;
+
+        for(unsigned char i=0; i < ENERGY_Component_Count; i++)
+        {
+            charge[i] += current[i] * dt;
+            step += current[i] * dt;
+        }
+
+        if(off)
+        {
+            off_charge += step;
+            off_s += dt;
+        }
+        else
+        {
+            on_charge += step;
+            on_s += dt;
+        }
+    }
+
+    if(status == SESSION_Status_Error)
+    {
+        fprintf(stderr, "%s: CPU stopped at 0x%04x\n", argv[0], 2 * avr.pc);
+        image_free(&image);
+        return EXIT_FAILURE;
+    }
+    seconds = (double)avr.time_ps * 1e-12;
+
+    printf("scenario:       %s\n", argv[optind + 1]);
+    printf("virtual time:   %.3f s (%.3f s on, %.3f s off)\n", seconds, on_s, off_s);
+    printf("boots:          %u\n\n", session.boots);
+    printf("%-14s %14s %14s %8s\n", "component", "charge uAh", "average uA", "share");
+
+    for(unsigned char i=0; i < ENERGY_Component_Count; i++)
+    {
+        total += charge[i];
+    }
+
+    for(unsigned char i=0; i < ENERGY_Component_Count; i++)
+    {
+        printf("%-14s %14.4f %14.3f %7.2f%%\n", energy_components[i], charge[i] / 3600.0, charge[i] / seconds, total ? (100.0 * charge[i] / total) : 0.0);
+    }
+    printf("%-14s %14.4f %14.3f\n\n", "total", total / 3600.0, total / seconds);
+
+    printf("on current:     %.3f uA\n", on_s ? (on_charge / on_s) : 0.0);
+    printf("off current:    %.3f uA\n", off_s ? (off_charge / off_s) : 0.0);
+
+    if(hours >= 0.0)
+    {
+        // Usage profile: cube switched on for <hours> per day, off for the rest of the day
+        average = (((on_s ? (on_charge / on_s) : 0.0) * hours) + ((off_s ? (off_charge / off_s) : ENERGY_POWERDOWN_UA) * (24.0 - hours))) / 24.0;
+        printf("usage profile:  %.2f h on per day\n", hours);
+    }
+    else
+    {
+        average = total / seconds;
+        printf("usage profile:  scenario repeated continuously\n");
+    }
+    printf("average:        %.3f uA\n", average);
+    printf("CR2032 (%.0f mAh): %.0f h (%.1f days)\n", capacity, capacity * 1000.0 / average, capacity * 1000.0 / average / 24.0);
+    image_free(&image);
+
+    return EXIT_SUCCESS;
+}
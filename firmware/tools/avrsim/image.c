@@ -0,0 +1,292 @@
+/**
+ * @file image.c
+ * @brief ELF loader for avr-gcc firmware images.
+ *
+ * This source file reads 32-bit little endian ELF files produced by avr-gcc. Loadable segments are placed by their physical (load) address: flash below `IMAGE_DATA_OFFSET`, EEPROM at `IMAGE_EEPROM_OFFSET`. Fuse, lock and signature segments are ignored.
+ *
+ * @author g.raf
+ * @date 2026-10-17
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger embedded systems project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/rcc "RCC - RGB LED Color Cube"
+ */
+
+#include <elf.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "image.h"
+
+#ifndef EM_AVR
+    #define EM_AVR 83
+#endif
+
+static int image_compare(const void *a, const void *b)
+{
+    const IMAGE_Symbol *x = a;
+    const IMAGE_Symbol *y = b;
+
+    if(x->type != y->type)
+    {
+        return (int)x->type - (int)y->type;
+    }
+    return (x->address > y->address) - (x->address < y->address);
+}
+
+static int image_symbols(IMAGE_Firmware *image, const unsigned char *file, size_t length, const Elf32_Shdr *sections, unsigned int count)
+{
+    for(unsigned int i=0; i < count; i++)
+    {
+        const Elf32_Shdr *table = &sections[i];
+        const Elf32_Shdr *strings;
+        const Elf32_Sym *symbols;
+        unsigned int number;
+
+        if((table->sh_type != SHT_SYMTAB) || (table->sh_link >= count))
+        {
+            continue;
+        }
+        strings = &sections[table->sh_link];
+
+        if(((table->sh_offset + table->sh_size) > length) || ((strings->sh_offset + strings->sh_size) > length))
+        {
+            return -1;
+        }
+        symbols = (const Elf32_Sym *)&file[table->sh_offset];
+        number = table->sh_size / sizeof(Elf32_Sym);
+
+        image->symbols = calloc(number, sizeof(IMAGE_Symbol));
+
+        if(!image->symbols)
+        {
+            return -1;
+        }
+
+        for(unsigned int j=0; j < number; j++)
+        {
+            unsigned char type = ELF32_ST_TYPE(symbols[j].st_info);
+            const char *name = (const char *)&file[strings->sh_offset + symbols[j].st_name];
+            IMAGE_Symbol *symbol = &image->symbols[image->symbol_count];
+
+            if(!symbols[j].st_name || (symbols[j].st_name >= strings->sh_size) || !name[0] || (symbols[j].st_shndx == SHN_UNDEF) || (symbols[j].st_shndx >= SHN_LORESERVE))
+            {
+                continue;
+            }
+
+            if(type == STT_FUNC)
+            {
+                symbol->type = IMAGE_Symbol_Function;
+                symbol->address = symbols[j].st_value;
+            }
+            else if((type == STT_OBJECT) && (symbols[j].st_value >= IMAGE_DATA_OFFSET) && (symbols[j].st_value < IMAGE_EEPROM_OFFSET))
+            {
+                symbol->type = IMAGE_Symbol_Object;
+                symbol->address = symbols[j].st_value - IMAGE_DATA_OFFSET;
+            }
+            else
+            {
+                continue;
+            }
+            symbol->name = strdup(name);
+            symbol->size = symbols[j].st_size;
+            image->symbol_count++;
+        }
+        qsort(image->symbols, image->symbol_count, sizeof(IMAGE_Symbol), image_compare);
+
+        return 0;
+    }
+    return 0;
+}
+
+/**
+ * @brief Load an avr-gcc ELF file.
+ *
+ * @param path Path of the ELF file.
+ * @param image Image to fill (flash and EEPROM are erased to `0xFF` first).
+ *
+ * @return `0` on success, `-1` on error (a message is printed to `stderr`).
+ */
+int image_load(const char *path, IMAGE_Firmware *image)
+{
+    FILE *handle = fopen(path, "rb");
+    unsigned char *file;
+    const Elf32_Ehdr *header;
+    long length;
+    int status = -1;
+
+    memset(image, 0, sizeof(*image));
+    memset(image->flash, 0xFF, sizeof(image->flash));
+    memset(image->eeprom, 0xFF, sizeof(image->eeprom));
+
+    if(!handle)
+    {
+        perror(path);
+        return -1;
+    }
+    fseek(handle, 0, SEEK_END);
+    length = ftell(handle);
+    rewind(handle);
+
+    file = malloc((size_t)length);
+
+    if(!file || (fread(file, 1, (size_t)length, handle) != (size_t)length))
+    {
+        fprintf(stderr, "%s: read error\n", path);
+        fclose(handle);
+        free(file);
+        return -1;
+    }
+    fclose(handle);
+
+    header = (const Elf32_Ehdr *)file;
+
+    if(((size_t)length < sizeof(Elf32_Ehdr)) || memcmp(header->e_ident, ELFMAG, SELFMAG) ||
+       (header->e_ident[EI_CLASS] != ELFCLASS32) || (header->e_ident[EI_DATA] != ELFDATA2LSB) ||
+       (header->e_machine != EM_AVR))
+    {
+        fprintf(stderr, "%s: not an AVR ELF file\n", path);
+        free(file);
+        return -1;
+    }
+
+    for(unsigned int i=0; i < header->e_phnum; i++)
+    {
+        const Elf32_Phdr *segment = (const Elf32_Phdr *)&file[header->e_phoff + i * header->e_phentsize];
+
+        if((segment->p_type != PT_LOAD) || ((segment->p_offset + segment->p_filesz) > (unsigned long)length))
+        {
+            continue;
+        }
+
+        if((segment->p_paddr + segment->p_filesz) <= IMAGE_FLASH_SIZE)
+        {
+            memcpy(&image->flash[segment->p_paddr], &file[segment->p_offset], segment->p_filesz);
+
+            if((segment->p_paddr + segment->p_filesz) > image->flash_size)
+            {
+                image->flash_size = segment->p_paddr + segment->p_filesz;
+            }
+        }
+        else if((segment->p_paddr >= IMAGE_EEPROM_OFFSET) && ((segment->p_paddr + segment->p_filesz) <= (IMAGE_EEPROM_OFFSET + IMAGE_EEPROM_SIZE)))
+        {
+            memcpy(&image->eeprom[segment->p_paddr - IMAGE_EEPROM_OFFSET], &file[segment->p_offset], segment->p_filesz);
+            image->eeprom_size = segment->p_paddr - IMAGE_EEPROM_OFFSET + segment->p_filesz;
+        }
+    }
+
+    if(header->e_shoff && ((header->e_shoff + header->e_shnum * sizeof(Elf32_Shdr)) <= (unsigned long)length))
+    {
+        const Elf32_Shdr *sections = (const Elf32_Shdr *)&file[header->e_shoff];
+        const char *names = (header->e_shstrndx < header->e_shnum) ? (const char *)&file[sections[header->e_shstrndx].sh_offset] : NULL;
+
+        for(unsigned int i=0; names && (i < header->e_shnum); i++)
+        {
+            if(!strcmp(&names[sections[i].sh_name], ".data") || !strcmp(&names[sections[i].sh_name], ".bss") || !strcmp(&names[sections[i].sh_name], ".noinit"))
+            {
+                image->data_size += sections[i].sh_size;
+            }
+        }
+        status = image_symbols(image, file, (size_t)length, sections, header->e_shnum);
+    }
+    else
+    {
+        status = 0;
+    }
+    free(file);
+
+    if(status)
+    {
+        fprintf(stderr, "%s: invalid symbol table\n", path);
+    }
+    return status;
+}
+
+/**
+ * @brief Release the symbol table of an image.
+ *
+ * @param image Image loaded with `image_load()`.
+ */
+void image_free(IMAGE_Firmware *image)
+{
+    for(unsigned int i=0; i < image->symbol_count; i++)
+    {
+        free(image->symbols[i].name);
+    }
+    free(image->symbols);
+    image->symbols = NULL;
+    image->symbol_count = 0;
+}
+
+/**
+ * @brief Find a symbol by name.
+ *
+ * @param image Firmware image.
+ * @param name Symbol name (e.g. `led_color`, `__vector_8`, `systick`).
+ *
+ * @return Symbol or `NULL` if not found.
+ */
+const IMAGE_Symbol *image_symbol(const IMAGE_Firmware *image, const char *name)
+{
+    for(unsigned int i=0; i < image->symbol_count; i++)
+    {
+        if(!strcmp(image->symbols[i].name, name))
+        {
+            return &image->symbols[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Find the function containing a flash address.
+ *
+ * @param image Firmware image.
+ * @param address Byte address in flash.
+ *
+ * @return Function symbol or `NULL` if the address is not part of a known function.
+ */
+const IMAGE_Symbol *image_function(const IMAGE_Firmware *image, unsigned long address)
+{
+    unsigned int low = 0;
+    unsigned int high = image->symbol_count;
+    const IMAGE_Symbol *found;
+
+    // Functions are sorted by address in front of all objects
+    while(low < high)
+    {
+        unsigned int middle = (low + high) / 2;
+
+        if((image->symbols[middle].type == IMAGE_Symbol_Function) && (image->symbols[middle].address <= address))
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    if(!low)
+    {
+        return NULL;
+    }
+    found = &image->symbols[low - 1];
+
+    // Aliases without size (e.g. __vector_default) yield to a sized symbol at the same address
+    while((low > 1) && !found->size && (image->symbols[low - 2].address == found->address))
+    {
+        found = &image->symbols[--low - 1];
+    }
+
+    if(found->size && (address >= (found->address + found->size)))
+    {
+        return NULL;
+    }
+    return found;
+}
@@ -0,0 +1,110 @@
+/**
+ * @file image.h
+ * @brief ELF loader for avr-gcc firmware images.
+ *
+ * This header declares the firmware image used by the AVR simulator. The loader copies the loadable segments of an avr-gcc ELF file into flash and EEPROM images and reads the symbol table, so functions, interrupt service routines and variables can be addressed by name.
+ *
+ * @author g.raf
+ * @date 2026-10-17
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger embedded systems project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/rcc "RCC - RGB LED Color Cube"
+ */
+
+#ifndef IMAGE_H_
+#define IMAGE_H_
+
+    #ifndef IMAGE_FLASH_SIZE
+        /**
+         * @def IMAGE_FLASH_SIZE
+         * @brief Maximum flash image size in bytes (AVRxt devices with 16-bit program counter).
+         */
+        #define IMAGE_FLASH_SIZE 0x10000UL
+    #endif
+
+    #ifndef IMAGE_EEPROM_SIZE
+        /**
+         * @def IMAGE_EEPROM_SIZE
+         * @brief Maximum EEPROM image size in bytes.
+         */
+        #define IMAGE_EEPROM_SIZE 0x100UL
+    #endif
+
+    /**
+     * @def IMAGE_DATA_OFFSET
+     * @brief Offset of the data address space in avr-gcc ELF files.
+     */
+    #define IMAGE_DATA_OFFSET 0x800000UL
+
+    /**
+     * @def IMAGE_EEPROM_OFFSET
+     * @brief Offset of the EEPROM address space in avr-gcc ELF files.
+     */
+    #define IMAGE_EEPROM_OFFSET 0x810000UL
+
+    /**
+     * @enum IMAGE_Symbol_Type_t
+     * @brief Types of symbols kept from the ELF symbol table.
+     */
+    enum IMAGE_Symbol_Type_t
+    {
+        IMAGE_Symbol_Function=0,  /**< Code in flash (byte address) */
+        IMAGE_Symbol_Object       /**< Variable in data space (data address) */
+    };
+
+    /**
+     * @typedef IMAGE_Symbol_Type
+     * @brief Alias for enum IMAGE_Symbol_Type_t.
+     */
+    typedef enum IMAGE_Symbol_Type_t IMAGE_Symbol_Type;
+
+    /**
+     * @struct IMAGE_Symbol_t
+     * @brief Symbol of the firmware image.
+     */
+    struct IMAGE_Symbol_t
+    {
+        char *name;                 /**< Symbol name */
+        unsigned long address;      /**< Byte address in flash or data space */
+        unsigned long size;         /**< Size in bytes (0 if unknown) */
+        IMAGE_Symbol_Type type;     /**< Symbol type */
+    };
+
+    /**
+     * @typedef IMAGE_Symbol
+     * @brief Alias for struct IMAGE_Symbol_t.
+     */
+    typedef struct IMAGE_Symbol_t IMAGE_Symbol;
+
+    /**
+     * @struct IMAGE_Firmware_t
+     * @brief Firmware image loaded from an ELF file.
+     */
+    struct IMAGE_Firmware_t
+    {
+        unsigned char flash[IMAGE_FLASH_SIZE];      /**< Flash contents (program and initialized data) */
+        unsigned long flash_size;                   /**< Highest used flash address + 1 */
+        unsigned char eeprom[IMAGE_EEPROM_SIZE];    /**< EEPROM contents (`.eeprom` section) */
+        unsigned long eeprom_size;                  /**< Size of the EEPROM image */
+        unsigned long data_size;                    /**< Size of `.data` + `.bss` (RAM usage) */
+        IMAGE_Symbol *symbols;                      /**< Symbols sorted by address */
+        unsigned int symbol_count;                  /**< Number of symbols */
+    };
+
+    /**
+     * @typedef IMAGE_Firmware
+     * @brief Alias for struct IMAGE_Firmware_t.
+     */
+    typedef struct IMAGE_Firmware_t IMAGE_Firmware;
+
+    int image_load(const char *path, IMAGE_Firmware *image);
+    void image_free(IMAGE_Firmware *image);
+    const IMAGE_Symbol *image_symbol(const IMAGE_Firmware *image, const char *name);
+    const IMAGE_Symbol *image_function(const IMAGE_Firmware *image, unsigned long address);
+
+#endif /* IMAGE_H_ */
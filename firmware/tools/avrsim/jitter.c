@@ -0,0 +1,330 @@
+/**
+ * @file jitter.c
+ * @brief Readout of the systick latency instrumentation of the RCC firmware.
+ *
+ * This tool decodes the `jitter` variable of a firmware built with `ENABLE_JITTER_PROFILE` (see `RCC_FW_1_0/jitter/jitter.h`): the latency of the systick interrupt and the longest measured window with disabled interrupts per site (bodies of the interrupt service routines). The data is taken either from a scenario replayed on the simulated ATtiny402 or from a raw memory dump read over UPDI.
+ *
+ * Usage:
+ *
+ * - `rcc_jitter [-v] firmware.elf scenario` replays the scenario. The statistics of every firmware run are collected before a software reset clears them and are merged, `-v` prints every run.
+ * - `rcc_jitter [-f clock] -r dump.bin` decodes a raw dump of the variable (address from `avr-nm`, layout of `JITTER_Data` with 16-bit `int`). `-f` sets the `TCB0` clock in Hz for the conversion into microseconds (default `10 MHz`).
+ *
+ * The tool fails if the image does not contain the instrumentation.
+ *
+ * @author g.raf
+ * @date 2026-10-17
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger embedded systems project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/rcc "RCC - RGB LED Color Cube"
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "session.h"
+#include "../../RCC_FW_1_0/jitter/jitter.h"
+
+/**
+ * @def JITTER_DATA_SIZE
+ * @brief Size of the `jitter` variable on the target (16-bit `int`, packed).
+ */
+#define JITTER_DATA_SIZE (16UL + (2UL * JITTER_Window_Count) + (2UL * JITTER_BINS))
+
+#ifndef JITTER_TOOL_CLOCK
+    /**
+     * @def JITTER_TOOL_CLOCK
+     * @brief Default `TCB0` clock of a UPDI dump in Hertz (`CLK_PER` of the firmware).
+     */
+    #define JITTER_TOOL_CLOCK 10000000UL
+#endif
+
+/**
+ * @struct JITTER_Total_t
+ * @brief Statistics merged over several firmware runs.
+ */
+struct JITTER_Total_t
+{
+    unsigned int min;                               /**< Shortest latency */
+    unsigned int max;                               /**< Longest latency */
+    unsigned int period;                            /**< Counts of the last systick period */
+    unsigned long long samples;                     /**< Number of recorded interrupts */
+    unsigned long max_tick;                         /**< `systick` at the longest latency */
+    unsigned int max_run;                           /**< Firmware run of the longest latency */
+    unsigned int window[JITTER_Window_Count];       /**< Longest window with disabled interrupts per site */
+    unsigned long long histogram[JITTER_BINS];      /**< Latencies per bin */
+};
+
+/**
+ * @typedef JITTER_Total
+ * @brief Alias for struct JITTER_Total_t.
+ */
+typedef struct JITTER_Total_t JITTER_Total;
+
+static const char *const jitter_windows[JITTER_Window_Count] = { "TCA0_OVF_vect", "PORTA_PORT_vect" };
+
+static void jitter_usage(const char *name)
+{
+    fprintf(stderr, "usage: %s [-v] firmware.elf scenario\n       %s [-f clock] -r dump.bin\n", name, name);
+}
+
+static unsigned int jitter_word(const unsigned char *data)
+{
+    return (unsigned int)data[0] | ((unsigned int)data[1]<<8);
+}
+
+static unsigned long jitter_long(const unsigned char *data)
+{
+    return (unsigned long)jitter_word(data) | ((unsigned long)jitter_word(&data[2])<<16);
+}
+
+/**
+ * @brief Decode the target memory of the `jitter` variable.
+ */
+static void jitter_decode(const unsigned char *data, JITTER_Data *block)
+{
+    block->min = jitter_word(&data[0]);
+    block->max = jitter_word(&data[2]);
+    block->holdoff = jitter_word(&data[4]);
+    block->period = jitter_word(&data[6]);
+    block->samples = jitter_long(&data[8]);
+    block->max_tick = jitter_long(&data[12]);
+
+    for(unsigned char i=0; i < JITTER_Window_Count; i++)
+    {
+        block->window[i] = jitter_word(&data[16 + 2 * i]);
+    }
+
+    for(unsigned char i=0; i < JITTER_BINS; i++)
+    {
+        block->histogram[i] = jitter_word(&data[16 + 2 * JITTER_Window_Count + 2 * i]);
+    }
+}
+
+static void jitter_merge(JITTER_Total *total, const JITTER_Data *block, unsigned int run)
+{
+    if(!block->samples)
+    {
+        return;
+    }
+
+    if(block->min < total->min)
+    {
+        total->min = block->min;
+    }
+
+    if(!total->samples || (block->max > total->max))
+    {
+        total->max = block->max;
+        total->max_tick = block->max_tick;
+        total->max_run = run;
+    }
+    total->period = block->period;
+    total->samples += block->samples;
+
+    for(unsigned char i=0; i < JITTER_Window_Count; i++)
+    {
+        if(block->window[i] > total->window[i])
+        {
+            total->window[i] = block->window[i];
+        }
+    }
+
+    for(unsigned char i=0; i < JITTER_BINS; i++)
+    {
+        total->histogram[i] += block->histogram[i];
+    }
+}
+
+static void jitter_print(const JITTER_Total *total, unsigned long clock)
+{
+    double us = 1e6 / (double)clock;
+
+    if(!total->samples)
+    {
+        printf("samples:        0\n");
+        return;
+    }
+    printf("samples:        %llu\n", total->samples);
+    printf("TCB0 clock:     %lu Hz\n", clock);
+    printf("period:         %u counts (%.3f us)\n", total->period, total->period * us);
+    printf("latency min:    %u counts (%.3f us)\n", total->min, total->min * us);
+    printf("latency max:    %u counts (%.3f us) at systick %lu", total->max, total->max * us, total->max_tick);
+
+    if(total->max_run)
+    {
+        printf(" of run %u", total->max_run);
+    }
+    printf("\n");
+    printf("hold-off:       %u counts (%.3f us, longest delay of a systick beyond the shortest latency)\n\n", total->max - total->min, (total->max - total->min) * us);
+    printf("%-22s %12s %12s\n", "interrupts disabled", "max counts", "max us");
+
+    for(unsigned char i=0; i < JITTER_Window_Count; i++)
+    {
+        printf("%-22s %12u %12.3f\n", jitter_windows[i], total->window[i], total->window[i] * us);
+    }
+    printf("\n");
+    printf("%-22s %12s %8s\n", "latency us", "interrupts", "share");
+
+    for(unsigned char i=0; i < JITTER_BINS; i++)
+    {
+        char range[32];
+        unsigned long low = (unsigned long)i << JITTER_BIN_SHIFT;
+        unsigned long high = (unsigned long)(i + 1) << JITTER_BIN_SHIFT;
+
+        if(!total->histogram[i])
+        {
+            continue;
+        }
+
+        if(i == (JITTER_BINS - 1))
+        {
+            snprintf(range, sizeof(range), ">= %.3f", low * us);
+        }
+        else
+        {
+            snprintf(range, sizeof(range), "%.3f - %.3f", low * us, high * us);
+        }
+        printf("%-22s %12llu %7.3f%%\n", range, total->histogram[i], 100.0 * (double)total->histogram[i] / (double)total->samples);
+    }
+}
+
+/**
+ * @brief Decode a raw memory dump read over UPDI.
+ */
+static int jitter_dump(const char *name, const char *path, unsigned long clock)
+{
+    unsigned char data[JITTER_DATA_SIZE];
+    JITTER_Total total = { .min = 0xFFFF };
+    JITTER_Data block;
+    FILE *file = fopen(path, "rb");
+
+    if(!file || (fread(data, 1, sizeof(data), file) != sizeof(data)))
+    {
+        fprintf(stderr, "%s: can not read %lu bytes from %s\n", name, JITTER_DATA_SIZE, path);
+
+        if(file)
+        {
+            fclose(file);
+        }
+        return EXIT_FAILURE;
+    }
+    fclose(file);
+
+    jitter_decode(data, &block);
+    jitter_merge(&total, &block, 0);
+    printf("dump:           %s\n", path);
+    jitter_print(&total, clock);
+
+    return EXIT_SUCCESS;
+}
+
+int main(int argc, char *argv[])
+{
+    static IMAGE_Firmware image;
+    static AVR avr;
+
+    SESSION session;
+    SESSION_Status status = SESSION_Status_Run;
+    JITTER_Total total = { .min = 0xFFFF };
+    const IMAGE_Symbol *symbol;
+    const char *dump = NULL;
+    unsigned long clock = JITTER_TOOL_CLOCK;
+    unsigned char verbose = 0;
+    unsigned int run = 1;
+    int option;
+
+    while((option = getopt(argc, argv, "vf:r:")) != -1)
+    {
+        switch(option)
+        {
+            case 'v': verbose = 1; break;
+            case 'f': clock = strtoul(optarg, NULL, 0); break;
+            case 'r': dump = optarg; break;
+            default:
+                jitter_usage(argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    if(dump)
+    {
+        if((optind != argc) || !clock)
+        {
+            jitter_usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+        return jitter_dump(argv[0], dump, clock);
+    }
+
+    if((optind + 2) != argc)
+    {
+        jitter_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if(image_load(argv[optind], &image) != 0)
+    {
+        return EXIT_FAILURE;
+    }
+    symbol = image_symbol(&image, "jitter");
+
+    if(!symbol || (symbol->type != IMAGE_Symbol_Object) || (symbol->size != JITTER_DATA_SIZE))
+    {
+        fprintf(stderr, "%s: %s is not built with ENABLE_JITTER_PROFILE (JITTER_BINS %d)\n", argv[0], argv[optind], JITTER_BINS);
+        image_free(&image);
+        return EXIT_FAILURE;
+    }
+    avr_init(&avr, &image);
+
+    if(session_load(&session, &avr, argv[optind + 1]) < 0)
+    {
+        image_free(&image);
+        return EXIT_FAILURE;
+    }
+
+    while((status != SESSION_Status_End) && (status != SESSION_Status_Error))
+    {
+        status = session_step(&session);
+
+        if(avr.io[AVR_IO_TCB0_CTRLA] & 0x01)
+        {
+            clock = avr_clock(&avr) >> ((avr.io[AVR_IO_TCB0_CTRLA]>>1) & 0x01);
+        }
+
+        // The startup code of the next run clears the variable, the SRAM still holds the last run
+        if((status == SESSION_Status_Reset) || (status == SESSION_Status_End))
+        {
+            JITTER_Data block;
+
+            jitter_decode(&avr.io[symbol->address], &block);
+            jitter_merge(&total, &block, run);
+
+            if(verbose)
+            {
+                printf("run %-4u        %lu interrupts, latency %u - %u counts\n", run, (unsigned long)block.samples, block.samples ? block.min : 0, block.max);
+            }
+            run++;
+        }
+    }
+
+    if(status == SESSION_Status_Error)
+    {
+        fprintf(stderr, "%s: CPU stopped at 0x%04x\n", argv[0], 2 * avr.pc);
+        image_free(&image);
+        return EXIT_FAILURE;
+    }
+
+    printf("scenario:       %s\n", argv[optind + 1]);
+    printf("virtual time:   %.3f s\n", (double)avr.time_ps * 1e-12);
+    printf("boots:          %u\n", session.boots);
+    jitter_print(&total, clock);
+    image_free(&image);
+
+    return EXIT_SUCCESS;
+}
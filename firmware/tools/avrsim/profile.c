@@ -0,0 +1,457 @@
+/**
+ * @file profile.c
+ * @brief Whole-firmware cycle profiler for the RCC firmware on the simulated ATtiny402.
+ *
+ * This tool replays a scenario (boot, battery check, blinks, colour adjustment, shutdown, ...) with the AVR firmware image and accounts the CPU cycles of every executed instruction to the current call stack. The call stack is reconstructed from the calls, returns and interrupts of the simulated CPU and symbolised per function and per interrupt service routine.
+ *
+ * The result is written in the folded stack format (`frame;frame;frame cycles`) understood by `flamegraph.pl`, speedscope and similar tools, a flat profile, the interrupt statistics and the stack peak are printed to `stderr`. A stack that grows into the variables (`.data`, `.bss`, `.noinit`) fails the run.
+ *
+ * @author g.raf
+ * @date 2026-10-17
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger embedded systems project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/rcc "RCC - RGB LED Color Cube"
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "session.h"
+
+#ifndef PROFILE_DEPTH
+    /**
+     * @def PROFILE_DEPTH
+     * @brief Maximum depth of the reconstructed call stack.
+     */
+    #define PROFILE_DEPTH 64
+#endif
+
+#ifndef PROFILE_TOP
+    /**
+     * @def PROFILE_TOP
+     * @brief Default number of functions in the flat profile.
+     */
+    #define PROFILE_TOP 15
+#endif
+
+/**
+ * @struct PROFILE_Node_t
+ * @brief Frame of the call tree.
+ */
+struct PROFILE_Node_t
+{
+    const IMAGE_Symbol *symbol;     /**< Function of the frame (`NULL` outside of any symbol) */
+    unsigned int parent;            /**< Index of the calling frame */
+    unsigned int child;             /**< Index of the first called frame (0 = none) */
+    unsigned int sibling;           /**< Index of the next frame with the same parent (0 = none) */
+    unsigned long long cycles;      /**< Cycles spent in this frame itself */
+};
+
+static struct PROFILE_Node_t *profile_nodes;
+static unsigned int profile_node_count;
+static unsigned int profile_node_size;
+
+static const IMAGE_Firmware *profile_image;
+static const IMAGE_Symbol *profile_isr[AVR_VECTORS];
+static unsigned int profile_stack[PROFILE_DEPTH];
+static unsigned char profile_depth;
+static unsigned int profile_frame;
+static unsigned int profile_pc;
+static unsigned char profile_interrupted;
+
+static unsigned int profile_child(unsigned int parent, const IMAGE_Symbol *symbol)
+{
+    unsigned int node;
+
+    for(node = profile_nodes[parent].child; node; node = profile_nodes[node].sibling)
+    {
+        if(profile_nodes[node].symbol == symbol)
+        {
+            return node;
+        }
+    }
+
+    if(profile_node_count >= profile_node_size)
+    {
+        profile_node_size *= 2;
+        profile_nodes = realloc(profile_nodes, profile_node_size * sizeof(*profile_nodes));
+
+        if(!profile_nodes)
+        {
+            fprintf(stderr, "out of memory\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    node = profile_node_count++;
+    profile_nodes[node].symbol = symbol;
+    profile_nodes[node].parent = parent;
+    profile_nodes[node].child = 0;
+    profile_nodes[node].sibling = profile_nodes[parent].child;
+    profile_nodes[node].cycles = 0;
+    profile_nodes[parent].child = node;
+
+    return node;
+}
+
+/**
+ * @brief Get the function containing a program address (cached for the last function).
+ *
+ * @details
+ * Jumps in the vector table are accounted to the interrupt service routine of the vector.
+ */
+static const IMAGE_Symbol *profile_function(unsigned int pc)
+{
+    static const IMAGE_Symbol *last;
+    unsigned long address = 2UL * pc;
+
+    if((pc < AVR_VECTORS) && profile_isr[pc])
+    {
+        return profile_isr[pc];
+    }
+
+    if(last && (address >= last->address) && (address < (last->address + last->size)))
+    {
+        return last;
+    }
+    last = image_function(profile_image, address);
+
+    return last;
+}
+
+static void profile_enter(unsigned int pc)
+{
+    if(profile_depth < PROFILE_DEPTH)
+    {
+        profile_stack[profile_depth++] = profile_frame;
+        profile_frame = profile_child(profile_frame, profile_function(pc));
+    }
+    else
+    {
+        profile_depth++;
+    }
+}
+
+static void profile_leave(void)
+{
+    if(!profile_depth)
+    {
+        return;
+    }
+
+    if(profile_depth-- <= PROFILE_DEPTH)
+    {
+        profile_frame = profile_stack[profile_depth];
+    }
+}
+
+static void profile_call(AVR *avr, unsigned long from, unsigned long to)
+{
+    (void)avr;
+    (void)to;
+    profile_enter((unsigned int)(from / 2));
+}
+
+static void profile_ret(AVR *avr)
+{
+    (void)avr;
+    profile_leave();
+}
+
+static void profile_interrupt(AVR *avr, unsigned char vector)
+{
+    (void)avr;
+    (void)vector;
+    profile_enter(profile_pc);
+    profile_interrupted = 1;
+}
+
+static void profile_name(const IMAGE_Symbol *symbol, char *text, size_t size)
+{
+    unsigned int vector;
+
+    if(!symbol)
+    {
+        snprintf(text, size, "[unknown]");
+    }
+    else if((sscanf(symbol->name, "__vector_%u", &vector) == 1) && (vector < AVR_VECTORS) && avr_vector_name((unsigned char)vector))
+    {
+        snprintf(text, size, "%s_vect", avr_vector_name((unsigned char)vector));
+    }
+    else
+    {
+        snprintf(text, size, "%s", symbol->name);
+    }
+}
+
+static void profile_fold(FILE *output, unsigned int node, char *path, size_t length)
+{
+    for(unsigned int child = profile_nodes[node].child; child; child = profile_nodes[child].sibling)
+    {
+        char name[64];
+        size_t end;
+
+        profile_name(profile_nodes[child].symbol, name, sizeof(name));
+        end = length + (size_t)snprintf(&path[length], 4096 - length, "%s%s", length ? ";" : "", name);
+
+        if(end >= 4096)
+        {
+            continue;
+        }
+
+        if(profile_nodes[child].cycles)
+        {
+            fprintf(output, "%s %llu\n", path, profile_nodes[child].cycles);
+        }
+        profile_fold(output, child, path, end);
+        path[length] = '\0';
+    }
+}
+
+/**
+ * @struct PROFILE_Function_t
+ * @brief Entry of the flat profile.
+ */
+struct PROFILE_Function_t
+{
+    const IMAGE_Symbol *symbol;
+    unsigned long long self;
+    unsigned long long total;
+};
+
+static int profile_compare(const void *a, const void *b)
+{
+    const struct PROFILE_Function_t *x = a;
+    const struct PROFILE_Function_t *y = b;
+
+    return (x->self < y->self) - (x->self > y->self);
+}
+
+static unsigned long long profile_total(unsigned int node)
+{
+    unsigned long long total = profile_nodes[node].cycles;
+
+    for(unsigned int child = profile_nodes[node].child; child; child = profile_nodes[child].sibling)
+    {
+        total += profile_total(child);
+    }
+    return total;
+}
+
+static void profile_flat(unsigned int top, unsigned long long cycles)
+{
+    struct PROFILE_Function_t *functions = calloc(profile_image->symbol_count + 1, sizeof(*functions));
+    unsigned int count = 0;
+
+    if(!functions)
+    {
+        return;
+    }
+
+    for(unsigned int node = 1; node < profile_node_count; node++)
+    {
+        unsigned int entry;
+        unsigned char recursive = 0;
+
+        for(entry = 0; (entry < count) && (functions[entry].symbol != profile_nodes[node].symbol); entry++);
+
+        if(entry == count)
+        {
+            functions[count++].symbol = profile_nodes[node].symbol;
+        }
+        functions[entry].self += profile_nodes[node].cycles;
+
+        // Inclusive time is only counted for the outermost frame of a function
+        for(unsigned int parent = profile_nodes[node].parent; parent; parent = profile_nodes[parent].parent)
+        {
+            recursive |= (profile_nodes[parent].symbol == profile_nodes[node].symbol);
+        }
+
+        if(!recursive)
+        {
+            functions[entry].total += profile_total(node);
+        }
+    }
+    qsort(functions, count, sizeof(*functions), profile_compare);
+
+    fprintf(stderr, "\n%-28s %14s %7s %14s %7s\n", "function", "self", "%", "total", "%");
+
+    for(unsigned int i=0; (i < count) && (i < top); i++)
+    {
+        char name[64];
+
+        profile_name(functions[i].symbol, name, sizeof(name));
+        fprintf(stderr, "%-28s %14llu %6.2f%% %14llu %6.2f%%\n", name,
+            functions[i].self, 100.0 * (double)functions[i].self / (double)cycles,
+            functions[i].total, 100.0 * (double)functions[i].total / (double)cycles);
+    }
+    free(functions);
+}
+
+static void profile_usage(const char *name)
+{
+    fprintf(stderr, "usage: %s [-o folded] [-n top] firmware.elf scenario\n", name);
+}
+
+int main(int argc, char *argv[])
+{
+    static IMAGE_Firmware image;
+    static AVR avr;
+    static char path[4096];
+
+    SESSION session;
+    SESSION_Status status = SESSION_Status_Run;
+    FILE *output = stdout;
+    const char *folded = NULL;
+    unsigned int top = PROFILE_TOP;
+    unsigned long long instructions = 0;
+    unsigned int stack = AVR_RAM_END;
+    long stack_free;
+    struct timespec start;
+    struct timespec stop;
+    int option;
+
+    while((option = getopt(argc, argv, "o:n:")) != -1)
+    {
+        switch(option)
+        {
+            case 'o': folded = optarg; break;
+            case 'n': top = (unsigned int)strtoul(optarg, NULL, 0); break;
+            default:
+                profile_usage(argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    if((optind + 2) != argc)
+    {
+        profile_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if(image_load(argv[optind], &image) != 0)
+    {
+        return EXIT_FAILURE;
+    }
+    profile_image = &image;
+
+    for(unsigned char i=0; i < AVR_VECTORS; i++)
+    {
+        char name[16];
+
+        snprintf(name, sizeof(name), "__vector_%u", i);
+        profile_isr[i] = image_symbol(&image, name);
+    }
+    avr_init(&avr, &image);
+
+    if(session_load(&session, &avr, argv[optind + 1]) < 0)
+    {
+        image_free(&image);
+        return EXIT_FAILURE;
+    }
+    avr.observer.call = profile_call;
+    avr.observer.ret = profile_ret;
+    avr.observer.interrupt = profile_interrupt;
+    avr.observer.reti = profile_ret;
+
+    // Node 0 is the root of the call tree
+    profile_node_size = 1024;
+    profile_node_count = 1;
+    profile_nodes = calloc(profile_node_size, sizeof(*profile_nodes));
+
+    if(!profile_nodes)
+    {
+        image_free(&image);
+        return EXIT_FAILURE;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    while((status != SESSION_Status_End) && (status != SESSION_Status_Error))
+    {
+        unsigned int frame = profile_frame;
+        unsigned long long cycles = avr.cycles;
+
+        profile_pc = avr.pc;
+        profile_interrupted = 0;
+        status = session_step(&session);
+
+        if(avr.sp < stack)
+        {
+            stack = avr.sp;
+        }
+
+        if(status == SESSION_Status_Run)
+        {
+            // Interrupt entry is accounted to the vector, every other instruction to its caller frame
+            unsigned int leaf = profile_interrupted ? profile_child(profile_frame, profile_function(avr.pc)) : profile_child(frame, profile_function(profile_pc));
+
+            profile_nodes[leaf].cycles += avr.cycles - cycles;
+            instructions++;
+        }
+        else if(status == SESSION_Status_Reset)
+        {
+            profile_depth = 0;
+            profile_frame = 0;
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+
+    if(status == SESSION_Status_Error)
+    {
+        fprintf(stderr, "%s: CPU stopped at 0x%04x (%s)\n", argv[0], 2 * avr.pc, (avr.status == AVR_Status_Break) ? "break" : "invalid instruction");
+    }
+
+    if(folded && !(output = fopen(folded, "w")))
+    {
+        perror(folded);
+        image_free(&image);
+        return EXIT_FAILURE;
+    }
+    profile_fold(output, 0, path, 0);
+
+    if(output != stdout)
+    {
+        fclose(output);
+    }
+
+    fprintf(stderr, "scenario:       %s\n", argv[optind + 1]);
+    fprintf(stderr, "virtual time:   %.3f s (%.3f s asleep)\n", (double)session_time_ns(&session) / 1e9, (double)session.sleep_ps / 1e12);
+    fprintf(stderr, "awake cycles:   %llu (%llu instructions)\n", session.awake_cycles, instructions);
+    fprintf(stderr, "boots:          %u\n", session.boots);
+
+    // The stack grows down from the end of the RAM towards .data, .bss and .noinit
+    stack_free = (long)stack + 1L - (long)(AVR_RAM_START + image.data_size);
+    fprintf(stderr, "stack peak:     %u bytes (%ld bytes free above %lu bytes of variables)\n", AVR_RAM_END - stack, stack_free, image.data_size);
+    fprintf(stderr, "host time:      %.3f s\n", (double)(stop.tv_sec - start.tv_sec) + (double)(stop.tv_nsec - start.tv_nsec) / 1e9);
+
+    fprintf(stderr, "\n%-28s %14s\n", "interrupt", "count");
+
+    for(unsigned char i=0; i < AVR_VECTORS; i++)
+    {
+        if(avr.interrupts[i])
+        {
+            fprintf(stderr, "%-28s %14llu\n", avr_vector_name(i) ? avr_vector_name(i) : "?", avr.interrupts[i]);
+        }
+    }
+
+    if(session.awake_cycles)
+    {
+        profile_flat(top, session.awake_cycles);
+    }
+    free(profile_nodes);
+    image_free(&image);
+
+    if(stack_free < 0)
+    {
+        fprintf(stderr, "%s: stack overlaps the variables\n", argv[0]);
+    }
+    return ((status == SESSION_Status_Error) || (stack_free < 0)) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
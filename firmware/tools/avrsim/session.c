@@ -0,0 +1,166 @@
+/**
+ * @file session.c
+ * @brief Scenario driven execution of a firmware image on the simulated ATtiny402.
+ *
+ * This source file keeps the scenario events sorted by time and applies them to the simulator while the firmware executes. A sleeping CPU is fast-forwarded up to the next event, software resets restart the firmware with the `SWRF` reset flag.
+ *
+ * @author g.raf
+ * @date 2026-10-17
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger embedded systems project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/rcc "RCC - RGB LED Color Cube"
+ */
+
+#include <string.h>
+
+#include "../../RCC_FW_1_0/battery/battery.h"
+#include "session.h"
+
+/**
+ * @struct SESSION_Event_t
+ * @brief Scheduled change of the device environment.
+ */
+struct SESSION_Event_t
+{
+    unsigned long long time_ns;
+    HOST_Event_Type type;
+    unsigned char channel;
+    unsigned int value;
+};
+
+static struct SESSION_Event_t session_events[SESSION_EVENTS];
+static unsigned int session_event_count;
+
+/**
+ * @brief Schedule a scenario event (`SCENARIO_Handler`).
+ *
+ * @param time_ns Time of the event since power-on.
+ * @param type Event type.
+ * @param channel Pin or analog channel.
+ * @param value Pin level or ADC result.
+ *
+ * @return `0` on success, `-1` if the event list is full.
+ */
+int session_event_add(unsigned long long time_ns, HOST_Event_Type type, unsigned char channel, unsigned int value)
+{
+    unsigned int i = session_event_count;
+
+    if(session_event_count >= SESSION_EVENTS)
+    {
+        return -1;
+    }
+
+    // Keep the order of events with the same time
+    while(i && (session_events[i - 1].time_ns > time_ns))
+    {
+        session_events[i] = session_events[i - 1];
+        i--;
+    }
+    session_events[i].time_ns = time_ns;
+    session_events[i].type = type;
+    session_events[i].channel = channel;
+    session_events[i].value = value;
+    session_event_count++;
+
+    return 0;
+}
+
+/**
+ * @brief Prepare a session for a simulated device.
+ *
+ * @param session Session to initialize.
+ * @param avr Simulator with the loaded firmware (powered on with `avr_init`).
+ * @param scenario Path of the scenario file.
+ *
+ * @return Number of scenario events, `-1` on error.
+ */
+int session_load(SESSION *session, AVR *avr, const char *scenario)
+{
+    memset(session, 0, sizeof(*session));
+    session->avr = avr;
+    session->boots = 1;
+    session_event_count = 0;
+
+    avr->analog[BATTERY_CHANNEL] = SESSION_BATTERY_VALUE;
+
+    return scenario_load(scenario, &session->end_ns, session_event_add);
+}
+
+/**
+ * @brief Get the current session time.
+ *
+ * @return Time since power-on in nanoseconds.
+ */
+unsigned long long session_time_ns(const SESSION *session)
+{
+    return session->avr->time_ps / 1000ULL;
+}
+
+/**
+ * @brief Execute one simulator step and apply due scenario events.
+ *
+ * @param session Session.
+ *
+ * @return Result of the step.
+ */
+SESSION_Status session_step(SESSION *session)
+{
+    AVR *avr = session->avr;
+    AVR_Status before = avr->status;
+    unsigned long long cycles = avr->cycles;
+    unsigned long long time_ps = avr->time_ps;
+
+    while((session->next < session_event_count) && ((session_events[session->next].time_ns * 1000ULL) <= avr->time_ps))
+    {
+        const struct SESSION_Event_t *event = &session_events[session->next++];
+
+        switch(event->type)
+        {
+            case HOST_Event_Pin:
+                avr_pin(avr, event->channel, (unsigned char)event->value);
+                break;
+            case HOST_Event_Analog:
+                avr->analog[event->channel % AVR_ANALOG_CHANNELS] = event->value;
+                break;
+            default:
+                return SESSION_Status_End;
+        }
+    }
+
+    if(session->next >= session_event_count)
+    {
+        return SESSION_Status_End;
+    }
+
+    // A sleeping CPU wakes up for the next event at the latest
+    avr->horizon = avr->cycles + ((session_events[session->next].time_ns * 1000ULL - avr->time_ps + avr->period_ps - 1) / avr->period_ps);
+
+    switch(avr_step(avr))
+    {
+        case AVR_Status_Run:
+        case AVR_Status_Sleep:
+            break;
+        case AVR_Status_Reset:
+            avr_reset(avr, 0x10);
+            session->boots++;
+            return SESSION_Status_Reset;
+        case AVR_Status_Halt:
+            return SESSION_Status_End;
+        default:
+            return SESSION_Status_Error;
+    }
+
+    if((before == AVR_Status_Sleep) && (avr->status == AVR_Status_Sleep))
+    {
+        session->sleep_ps += avr->time_ps - time_ps;
+        return SESSION_Status_Sleep;
+    }
+    session->awake_cycles += avr->cycles - cycles;
+
+    return SESSION_Status_Run;
+}
@@ -0,0 +1,85 @@
+/**
+ * @file session.h
+ * @brief Scenario driven execution of a firmware image on the simulated ATtiny402.
+ *
+ * This header declares a session that replays a scenario file (see `tools/sim/scenario.h`) against the AVR simulator: button and pin levels and analog inputs are applied at their scenario time, software resets restart the firmware and the session ends with the scenario. Tools step through the session instruction by instruction and attach to the simulator through its observer callbacks.
+ *
+ * @author g.raf
+ * @date 2026-10-17
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger embedded systems project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/rcc "RCC - RGB LED Color Cube"
+ */
+
+#ifndef SESSION_H_
+#define SESSION_H_
+
+    #include "avr.h"
+    #include "../sim/scenario.h"
+
+    #ifndef SESSION_EVENTS
+        /**
+         * @def SESSION_EVENTS
+         * @brief Maximum number of scenario events of a session.
+         */
+        #define SESSION_EVENTS 4096
+    #endif
+
+    #ifndef SESSION_BATTERY_VALUE
+        /**
+         * @def SESSION_BATTERY_VALUE
+         * @brief ADC result of the battery channel at power-on (full battery).
+         */
+        #define SESSION_BATTERY_VALUE 1000
+    #endif
+
+    /**
+     * @enum SESSION_Status_t
+     * @brief Result of a session step.
+     */
+    enum SESSION_Status_t
+    {
+        SESSION_Status_Run=0,       /**< Instruction or interrupt entry executed */
+        SESSION_Status_Sleep,       /**< CPU slept */
+        SESSION_Status_Reset,       /**< Firmware restarted after a software reset */
+        SESSION_Status_End,         /**< Scenario finished */
+        SESSION_Status_Error        /**< CPU stopped (invalid instruction, `BREAK`) */
+    };
+
+    /**
+     * @typedef SESSION_Status
+     * @brief Alias for enum SESSION_Status_t.
+     */
+    typedef enum SESSION_Status_t SESSION_Status;
+
+    /**
+     * @struct SESSION_t
+     * @brief State of a scenario replay.
+     */
+    struct SESSION_t
+    {
+        AVR *avr;                           /**< Simulated device */
+        unsigned long long end_ns;          /**< End of the scenario */
+        unsigned int next;                  /**< Index of the next event */
+        unsigned int boots;                 /**< Number of firmware starts */
+        unsigned long long awake_cycles;    /**< CPU cycles executed (not sleeping) */
+        unsigned long long sleep_ps;        /**< Time spent sleeping */
+    };
+
+    /**
+     * @typedef SESSION
+     * @brief Alias for struct SESSION_t.
+     */
+    typedef struct SESSION_t SESSION;
+
+    int session_load(SESSION *session, AVR *avr, const char *scenario);
+    SESSION_Status session_step(SESSION *session);
+    unsigned long long session_time_ns(const SESSION *session);
+    int session_event_add(unsigned long long time_ns, HOST_Event_Type type, unsigned char channel, unsigned int value);
+
+#endif /* SESSION_H_ */
@@ -0,0 +1,557 @@
+/**
+ * @file sweep.c
+ * @brief Compile-time parameter sweep of the RCC firmware with latency, size and battery life trade-offs.
+ *
+ * This tool builds the firmware for every combination of the macro values of a grid file (see `tools/avrsim/sweep.txt`) and evaluates every build:
+ *
+ * - UI latency: the host build (`HOST_DEFINES`) replays the latency scenario with `rcc_latency`, the p99 button-to-LED latency is taken per press type (`wake`, `idle`, `busy`).
+ * - Flash and RAM: the ATtiny402 image (`AVR_DEFINES`) is loaded and the flash image size and `.data`/`.bss`/`.noinit` are taken.
+ * - Battery life: `rcc_energy` replays the energy scenario with the ATtiny402 image and the usage profile of `-d` hours per day.
+ *
+ * The results are printed as table followed by the Pareto front, the builds that are not worse in every metric than another build. A press type without presses is printed as `-` and rated worse than any latency, the scenario then missed the state it was timed for (e.g. the wake press of a slower clock arrives during the shutdown blinks and is rated `busy`). With `-n` only the host builds are evaluated (no avr-gcc required), the front then only refers to the latency.
+ *
+ * Usage: `rcc_sweep [-n] [-m make] [-o directory] [-l scenario] [-e scenario] [-d hours] grid`
+ *
+ * - `-m` make command including the variables of the ATtiny402 build (e.g. `"make AVR_CC=... AVR_DFP=..."`).
+ * - `-o` build directory of the sweep (default `SWEEP_BUILD`), every combination is built in `<directory>/<hash of the defines>`, so unchanged combinations are not rebuilt.
+ * - `-l` latency scenario (default `scenarios/latency.txt`), `-e` energy scenario (default `scenarios/adjust.txt`).
+ *
+ * @note The scenarios are timed for the default settings. Combinations that change the command timing (e.g. `SWITCH_COMMAND_EXECUTE_MS`) may execute other commands in the energy scenario.
+ *
+ * @author g.raf
+ * @date 2026-10-17
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger embedded systems project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/rcc "RCC - RGB LED Color Cube"
+ */
+
+#include <float.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "image.h"
+
+#ifndef SWEEP_MACROS
+    /**
+     * @def SWEEP_MACROS
+     * @brief Maximum number of macros in a grid file.
+     */
+    #define SWEEP_MACROS 8
+#endif
+
+#ifndef SWEEP_VALUES
+    /**
+     * @def SWEEP_VALUES
+     * @brief Maximum number of values per macro.
+     */
+    #define SWEEP_VALUES 8
+#endif
+
+#ifndef SWEEP_POINTS
+    /**
+     * @def SWEEP_POINTS
+     * @brief Maximum number of combinations of a sweep.
+     */
+    #define SWEEP_POINTS 1024
+#endif
+
+#ifndef SWEEP_TYPES
+    /**
+     * @def SWEEP_TYPES
+     * @brief Number of press types of `rcc_latency` (`wake`, `idle`, `busy`).
+     */
+    #define SWEEP_TYPES 3
+#endif
+
+#ifndef SWEEP_BUILD
+    /**
+     * @def SWEEP_BUILD
+     * @brief Default build directory of the sweep.
+     */
+    #define SWEEP_BUILD "build/sweep"
+#endif
+
+#ifndef SWEEP_ENERGY
+    /**
+     * @def SWEEP_ENERGY
+     * @brief Energy estimate of the default host build.
+     */
+    #define SWEEP_ENERGY "build/host/tools/avrsim/rcc_energy"
+#endif
+
+/**
+ * @struct SWEEP_Macro_t
+ * @brief Macro of the grid with its values.
+ */
+struct SWEEP_Macro_t
+{
+    char name[64];                              /**< Macro name */
+    char value[SWEEP_VALUES][64];               /**< Values */
+    unsigned char count;                        /**< Number of values */
+};
+
+/**
+ * @typedef SWEEP_Macro
+ * @brief Alias for struct SWEEP_Macro_t.
+ */
+typedef struct SWEEP_Macro_t SWEEP_Macro;
+
+/**
+ * @struct SWEEP_Result_t
+ * @brief Metrics of a build.
+ */
+struct SWEEP_Result_t
+{
+    unsigned char valid;                        /**< Build and evaluation succeeded */
+    double latency_ms[SWEEP_TYPES];             /**< p99 button-to-LED latency per press type, `-1` without presses */
+    unsigned long flash;                        /**< Flash image size in bytes */
+    unsigned long ram;                          /**< Static RAM in bytes */
+    double current_ua;                          /**< Average supply current of the usage profile */
+    double days;                                /**< Estimated CR2032 lifetime in days */
+};
+
+/**
+ * @typedef SWEEP_Result
+ * @brief Alias for struct SWEEP_Result_t.
+ */
+typedef struct SWEEP_Result_t SWEEP_Result;
+
+static const char *const sweep_types[SWEEP_TYPES] = { "wake", "idle", "busy" };
+
+static SWEEP_Macro sweep_macros[SWEEP_MACROS];
+static unsigned char sweep_macro_count;
+static SWEEP_Result sweep_results[SWEEP_POINTS];
+static unsigned char sweep_host_only;
+
+static void sweep_usage(const char *name)
+{
+    fprintf(stderr, "usage: %s [-n] [-m make] [-o directory] [-l scenario] [-e scenario] [-d hours] grid\n", name);
+    exit(EXIT_FAILURE);
+}
+
+/**
+ * @brief Load the grid file.
+ *
+ * @return Number of combinations, `-1` on errors.
+ */
+static long sweep_load(const char *path)
+{
+    char line[512];
+    unsigned int number = 0;
+    long points = 1;
+    FILE *file = fopen(path, "r");
+
+    if(!file)
+    {
+        perror(path);
+        return -1;
+    }
+
+    while(fgets(line, sizeof(line), file))
+    {
+        SWEEP_Macro *macro = &sweep_macros[sweep_macro_count];
+        char *token = strtok(line, " \t\r\n");
+
+        number++;
+
+        if(!token || (token[0] == '#'))
+        {
+            continue;
+        }
+
+        if(sweep_macro_count >= SWEEP_MACROS)
+        {
+            fprintf(stderr, "%s:%u: more than %u macros\n", path, number, SWEEP_MACROS);
+            fclose(file);
+            return -1;
+        }
+        snprintf(macro->name, sizeof(macro->name), "%s", token);
+        macro->count = 0;
+
+        while((token = strtok(NULL, " \t\r\n")) && (token[0] != '#'))
+        {
+            if(macro->count >= SWEEP_VALUES)
+            {
+                fprintf(stderr, "%s:%u: more than %u values\n", path, number, SWEEP_VALUES);
+                fclose(file);
+                return -1;
+            }
+            snprintf(macro->value[macro->count++], sizeof(macro->value[0]), "%s", token);
+        }
+
+        if(!macro->count)
+        {
+            fprintf(stderr, "%s:%u: %s without values\n", path, number, macro->name);
+            fclose(file);
+            return -1;
+        }
+        points *= macro->count;
+        sweep_macro_count++;
+    }
+    fclose(file);
+
+    if(!sweep_macro_count || (points > SWEEP_POINTS))
+    {
+        fprintf(stderr, "%s: %ld combinations (1 to %u allowed)\n", path, sweep_macro_count ? points : 0, SWEEP_POINTS);
+        return -1;
+    }
+
+    return points;
+}
+
+/**
+ * @brief Get the value index of a macro in a combination.
+ */
+static unsigned char sweep_value(long point, unsigned char macro)
+{
+    for(unsigned char i=(unsigned char)(sweep_macro_count - 1); i > macro; i--)
+    {
+        point /= sweep_macros[i].count;
+    }
+
+    return (unsigned char)(point % sweep_macros[macro].count);
+}
+
+static void sweep_defines(long point, char *defines, size_t size)
+{
+    size_t length = 0;
+
+    defines[0] = '\0';
+
+    for(unsigned char i=0; i < sweep_macro_count; i++)
+    {
+        length += (size_t)snprintf(&defines[length], size - length, "%s-D%s=%s", (i ? " " : ""), sweep_macros[i].name, sweep_macros[i].value[sweep_value(point, i)]);
+
+        if(length >= size)
+        {
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Hash of the defines of a combination (djb2) to name its build directory.
+ */
+static unsigned long sweep_hash(const char *text)
+{
+    unsigned long hash = 5381UL;
+
+    while(*text)
+    {
+        hash = ((hash << 5) + hash + (unsigned char)*text++) & 0xFFFFFFFFUL;
+    }
+
+    return hash;
+}
+
+/**
+ * @brief Run a command and parse its output line by line.
+ *
+ * @return `0` if the command succeeded.
+ */
+static int sweep_run(const char *command, void (*parse)(const char *line, SWEEP_Result *result), SWEEP_Result *result)
+{
+    char line[512];
+    FILE *pipe = popen(command, "r");
+
+    if(!pipe)
+    {
+        perror("popen");
+        return -1;
+    }
+
+    while(fgets(line, sizeof(line), pipe))
+    {
+        if(parse)
+        {
+            parse(line, result);
+        }
+    }
+
+    return pclose(pipe) ? -1 : 0;
+}
+
+static void sweep_parse_latency(const char *line, SWEEP_Result *result)
+{
+    char type[16];
+    unsigned long presses;
+    double min, median, p99, max;
+
+    // type presses min median p99 max
+    if((sscanf(line, "%15s %lu %lf %lf %lf %lf", type, &presses, &min, &median, &p99, &max) != 6) || !presses)
+    {
+        return;
+    }
+
+    for(unsigned char i=0; i < SWEEP_TYPES; i++)
+    {
+        if(!strcmp(type, sweep_types[i]))
+        {
+            result->latency_ms[i] = p99;
+        }
+    }
+}
+
+static void sweep_parse_energy(const char *line, SWEEP_Result *result)
+{
+    double hours;
+
+    if(!strncmp(line, "average:", 8))
+    {
+        sscanf(&line[8], "%lf", &result->current_ua);
+    }
+    else if(!strncmp(line, "CR2032", 6))
+    {
+        sscanf(line, "CR2032 (%*[^)]): %lf h (%lf days)", &hours, &result->days);
+    }
+}
+
+/**
+ * @brief Check if the latency scenario produced presses of any type.
+ */
+static unsigned char sweep_presses(const SWEEP_Result *result)
+{
+    for(unsigned char i=0; i < SWEEP_TYPES; i++)
+    {
+        if(result->latency_ms[i] >= 0.0)
+        {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Build and evaluate a combination.
+ */
+static void sweep_point(long point, const char *make, const char *directory, const char *latency, const char *energy, const char *hours)
+{
+    static IMAGE_Firmware image;
+
+    SWEEP_Result *result = &sweep_results[point];
+    char defines[1024];
+    char build[256];
+    char command[2048];
+
+    sweep_defines(point, defines, sizeof(defines));
+    snprintf(build, sizeof(build), "%s/%08lx", directory, sweep_hash(defines));
+    for(unsigned char i=0; i < SWEEP_TYPES; i++)
+    {
+        result->latency_ms[i] = -1.0;
+    }
+
+    fprintf(stderr, "[%ld] %s\n", point, defines);
+
+    snprintf(command, sizeof(command), "%s -s BUILD=%s/host HOST_DEFINES='%s' %s/host/tools/sim/rcc_latency >&2 && %s/host/tools/sim/rcc_latency %s", make, build, defines, build, build, latency);
+
+    if(sweep_run(command, sweep_parse_latency, result) || !sweep_presses(result))
+    {
+        fprintf(stderr, "[%ld] host build or latency scenario failed\n", point);
+        return;
+    }
+
+    if(sweep_host_only)
+    {
+        result->valid = 1;
+        return;
+    }
+
+    snprintf(command, sizeof(command), "%s -s AVR_BUILD=%s/avr AVR_DEFINES='%s' %s/avr/RCC_FW_1_0_t402.elf >&2", make, build, defines, build);
+
+    if(sweep_run(command, NULL, result))
+    {
+        fprintf(stderr, "[%ld] ATtiny402 build failed\n", point);
+        return;
+    }
+    snprintf(command, sizeof(command), "%s/avr/RCC_FW_1_0_t402.elf", build);
+
+    if(image_load(command, &image))
+    {
+        return;
+    }
+    result->flash = image.flash_size;
+    result->ram = image.data_size;
+    image_free(&image);
+
+    snprintf(command, sizeof(command), "%s -d %s %s/avr/RCC_FW_1_0_t402.elf %s", SWEEP_ENERGY, hours, build, energy);
+
+    if(sweep_run(command, sweep_parse_energy, result) || (result->days <= 0.0))
+    {
+        fprintf(stderr, "[%ld] energy scenario failed\n", point);
+        return;
+    }
+    result->valid = 1;
+}
+
+/**
+ * @brief Check if a build is at least as good as another in every metric and better in one.
+ */
+static unsigned char sweep_dominates(const SWEEP_Result *a, const SWEEP_Result *b)
+{
+    unsigned char better = 0;
+
+    for(unsigned char i=0; i < SWEEP_TYPES; i++)
+    {
+        double latency_a = (a->latency_ms[i] < 0.0) ? DBL_MAX : a->latency_ms[i];
+        double latency_b = (b->latency_ms[i] < 0.0) ? DBL_MAX : b->latency_ms[i];
+
+        if(latency_a > latency_b)
+        {
+            return 0;
+        }
+        better |= (latency_a < latency_b);
+    }
+
+    if(sweep_host_only)
+    {
+        return better;
+    }
+
+    if((a->flash > b->flash) || (a->ram > b->ram) || (a->days < b->days))
+    {
+        return 0;
+    }
+    better |= (a->flash < b->flash) || (a->ram < b->ram) || (a->days > b->days);
+
+    return better;
+}
+
+static void sweep_header(void)
+{
+    printf("%-6s", "index");
+
+    for(unsigned char i=0; i < sweep_macro_count; i++)
+    {
+        printf(" %-20.20s", sweep_macros[i].name);
+    }
+    for(unsigned char i=0; i < SWEEP_TYPES; i++)
+    {
+        printf(" %6s p99", sweep_types[i]);
+    }
+
+    if(!sweep_host_only)
+    {
+        printf(" %8s %6s %10s %8s", "flash B", "RAM B", "avg uA", "days");
+    }
+    printf("\n");
+}
+
+static void sweep_row(long point)
+{
+    const SWEEP_Result *result = &sweep_results[point];
+
+    printf("%-6ld", point);
+
+    for(unsigned char i=0; i < sweep_macro_count; i++)
+    {
+        printf(" %-20.20s", sweep_macros[i].value[sweep_value(point, i)]);
+    }
+
+    if(!result->valid)
+    {
+        printf(" %10s\n", "failed");
+        return;
+    }
+    for(unsigned char i=0; i < SWEEP_TYPES; i++)
+    {
+        if(result->latency_ms[i] < 0.0)
+        {
+            printf(" %10s", "-");
+        }
+        else
+        {
+            printf(" %10.3f", result->latency_ms[i]);
+        }
+    }
+
+    if(!sweep_host_only)
+    {
+        printf(" %8lu %6lu %10.3f %8.1f", result->flash, result->ram, result->current_ua, result->days);
+    }
+    printf("\n");
+}
+
+int main(int argc, char *argv[])
+{
+    const char *make = "make";
+    const char *directory = SWEEP_BUILD;
+    const char *latency = "scenarios/latency.txt";
+    const char *energy = "scenarios/adjust.txt";
+    const char *hours = "1";
+    unsigned long valid = 0;
+    long points;
+    int option;
+
+    while((option = getopt(argc, argv, "nm:o:l:e:d:")) != -1)
+    {
+        switch(option)
+        {
+            case 'n': sweep_host_only = 1; break;
+            case 'm': make = optarg; break;
+            case 'o': directory = optarg; break;
+            case 'l': latency = optarg; break;
+            case 'e': energy = optarg; break;
+            case 'd': hours = optarg; break;
+            default:
+                sweep_usage(argv[0]);
+        }
+    }
+
+    if(optind != (argc - 1))
+    {
+        sweep_usage(argv[0]);
+    }
+
+    if((points = sweep_load(argv[optind])) < 0)
+    {
+        return EXIT_FAILURE;
+    }
+
+    for(long i=0; i < points; i++)
+    {
+        sweep_point(i, make, directory, latency, energy, hours);
+        valid += sweep_results[i].valid;
+    }
+
+    printf("grid:           %s (%ld combinations, %lu evaluated)\n", argv[optind], points, valid);
+    printf("metrics:        %s\n\n", sweep_host_only ? "p99 button-to-LED latency per press type in ms (host build)" : "p99 button-to-LED latency per press type in ms, flash, RAM, CR2032 lifetime");
+    sweep_header();
+
+    for(long i=0; i < points; i++)
+    {
+        sweep_row(i);
+    }
+
+    printf("\nPareto front:\n");
+    sweep_header();
+
+    for(long i=0; i < points; i++)
+    {
+        unsigned char dominated = 0;
+
+        if(!sweep_results[i].valid)
+        {
+            continue;
+        }
+
+        for(long j=0; (j < points) && !dominated; j++)
+        {
+            dominated = sweep_results[j].valid && sweep_dominates(&sweep_results[j], &sweep_results[i]);
+        }
+
+        if(!dominated)
+        {
+            sweep_row(i);
+        }
+    }
+
+    return (valid == (unsigned long)points) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,763 @@
+/**
+ * @file wcet.c
+ * @brief Static worst-case execution time analysis of the interrupt service routines and interrupt-disabled regions of the RCC firmware.
+ *
+ * This tool disassembles the AVR firmware image (ELF) and computes an upper bound of the CPU cycles of every interrupt service routine, of every region between `cli` and the next `sei` (or restore of `SREG`, software reset, return) and of the resulting worst case interrupt latency. The control flow of every function is explored from its entry with the AVRxt instruction timing (taken branches and skips included), calls add the bound of the called function.
+ *
+ * A budget file configures the allowed cycles per root and the loop bounds of functions:
+ *
+ * - `<name> <cycles>` budget of an ISR (`TCA0_OVF_vect`), a function, the longest region of a function (`cli:<function>`) or of the interrupt latency (`latency`).
+ * - `bound <function> <iterations>` maximum number of loop iterations per call of a function. A function with loops is bounded by `(iterations + 1)` times its longest loop-free path.
+ *
+ * Indirect jumps and calls, recursion and loops without bound can not be bounded. The tool fails if a budgeted root exceeds its budget or is unbounded.
+ *
+ * @author g.raf
+ * @date 2026-10-17
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger embedded systems project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/rcc "RCC - RGB LED Color Cube"
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "avr.h"
+
+#ifndef WCET_CLOCK
+    /**
+     * @def WCET_CLOCK
+     * @brief Default CPU clock in Hertz (`F_CPU` divided by 2 in `system_init()`).
+     */
+    #define WCET_CLOCK 10000000UL
+#endif
+
+#ifndef WCET_BUDGETS
+    /**
+     * @def WCET_BUDGETS
+     * @brief Maximum number of entries in the budget file.
+     */
+    #define WCET_BUDGETS 64
+#endif
+
+/**
+ * @def WCET_RESPONSE_CYCLES
+ * @brief Cycles to push the program counter when an interrupt is accepted (without the jump in the vector table).
+ */
+#define WCET_RESPONSE_CYCLES 2
+
+/**
+ * @def WCET_INSTRUCTION_CYCLES
+ * @brief Longest instruction that is completed before an interrupt is accepted (`ret`).
+ */
+#define WCET_INSTRUCTION_CYCLES 4
+
+/**
+ * @def WCET_UNBOUNDED
+ * @brief Result of an analysis that can not be bounded.
+ */
+#define WCET_UNBOUNDED (-1LL)
+
+/**
+ * @def WCET_END
+ * @brief Edge target of an instruction that leaves the analyzed region.
+ */
+#define WCET_END (-1L)
+
+/**
+ * @enum WCET_Mode_t
+ * @brief End of an analyzed path.
+ */
+enum WCET_Mode_t
+{
+    WCET_Mode_Function=0,       /**< Path ends with `ret`/`reti` */
+    WCET_Mode_Region            /**< Path ends when interrupts are enabled again */
+};
+
+/**
+ * @typedef WCET_Mode
+ * @brief Alias for enum WCET_Mode_t.
+ */
+typedef enum WCET_Mode_t WCET_Mode;
+
+/**
+ * @struct WCET_Function_t
+ * @brief Analysis result of a function.
+ */
+struct WCET_Function_t
+{
+    long long cycles;           /**< Bound in cycles or `WCET_UNBOUNDED` */
+    unsigned long bound;        /**< Loop iterations per call (0 = no loops allowed) */
+    unsigned char state;        /**< 0 = not analyzed, 1 = in analysis, 2 = analyzed */
+    char reason[128];           /**< Reason why the function is unbounded */
+};
+
+/**
+ * @typedef WCET_Function
+ * @brief Alias for struct WCET_Function_t.
+ */
+typedef struct WCET_Function_t WCET_Function;
+
+/**
+ * @struct WCET_Edge_t
+ * @brief Control flow edge of an instruction.
+ */
+struct WCET_Edge_t
+{
+    long target;                /**< Word address of the successor or `WCET_END` */
+    long long cycles;           /**< Cycles of the instruction on this edge (callee included) */
+};
+
+/**
+ * @typedef WCET_Edge
+ * @brief Alias for struct WCET_Edge_t.
+ */
+typedef struct WCET_Edge_t WCET_Edge;
+
+/**
+ * @struct WCET_Budget_t
+ * @brief Entry of the budget file.
+ */
+struct WCET_Budget_t
+{
+    char name[64];              /**< Root or function name */
+    unsigned long value;        /**< Cycles or loop iterations */
+    unsigned char bound;        /**< Entry is a loop bound */
+    unsigned char used;         /**< Entry matched a root or function */
+};
+
+/**
+ * @typedef WCET_Budget
+ * @brief Alias for struct WCET_Budget_t.
+ */
+typedef struct WCET_Budget_t WCET_Budget;
+
+/**
+ * @struct WCET_Path_t
+ * @brief State of the longest path search in one function.
+ */
+struct WCET_Path_t
+{
+    unsigned long low;          /**< First word of the function */
+    unsigned long high;         /**< First word behind the function */
+    WCET_Mode mode;             /**< End of the path */
+    unsigned char *state;       /**< 0 = unvisited, 1 = on the search stack, 2 = finished */
+    long long *longest;         /**< Longest loop-free path from an instruction */
+    unsigned char loops;        /**< Back edges found */
+};
+
+/**
+ * @typedef WCET_Path
+ * @brief Alias for struct WCET_Path_t.
+ */
+typedef struct WCET_Path_t WCET_Path;
+
+static const IMAGE_Firmware *wcet_image;
+static WCET_Function *wcet_functions;
+static WCET_Budget wcet_budgets[WCET_BUDGETS];
+static unsigned int wcet_budget_count;
+static char wcet_reason[128];
+
+static long long wcet_function(unsigned long word);
+
+static AVR_Instruction wcet_decode(unsigned long word)
+{
+    const unsigned char *flash = wcet_image->flash;
+    unsigned long address = (2UL * word) % IMAGE_FLASH_SIZE;
+    unsigned int opcode = flash[address] | ((unsigned int)flash[address + 1]<<8);
+    unsigned int next = flash[(address + 2) % IMAGE_FLASH_SIZE] | ((unsigned int)flash[(address + 3) % IMAGE_FLASH_SIZE]<<8);
+
+    return avr_decode(opcode, next);
+}
+
+static long long wcet_fail(const char *reason, unsigned long word)
+{
+    const IMAGE_Symbol *symbol = image_function(wcet_image, 2UL * word);
+
+    if(!wcet_reason[0])
+    {
+        snprintf(wcet_reason, sizeof(wcet_reason), "%s at %s+0x%lx", reason, symbol ? symbol->name : "?", symbol ? (2UL * word - symbol->address) : 2UL * word);
+    }
+    return WCET_UNBOUNDED;
+}
+
+/**
+ * @brief Determine the successors of an instruction.
+ *
+ * @return Number of edges, `-1` if the instruction can not be bounded.
+ */
+static int wcet_edges(const WCET_Path *path, unsigned long word, WCET_Edge edges[2])
+{
+    AVR_Instruction instruction = wcet_decode(word);
+    unsigned long next = word + instruction.words;
+    long long cycles = instruction.cycles;
+    long target;
+    long long callee;
+
+    switch(instruction.op)
+    {
+        case AVR_Op_RET:
+        case AVR_Op_RETI:
+            edges[0].target = WCET_END;
+            edges[0].cycles = cycles;
+            return 1;
+
+        case AVR_Op_BSET:
+        case AVR_Op_OUT:
+        case AVR_Op_STS:
+            // sei, writes to SREG and the software reset end an interrupt-disabled region
+            if((path->mode == WCET_Mode_Region) &&
+               (((instruction.op == AVR_Op_BSET) && (instruction.d == 7)) ||
+                ((instruction.op == AVR_Op_OUT) && (instruction.k == AVR_IO_SREG)) ||
+                ((instruction.op == AVR_Op_STS) && ((instruction.k == AVR_IO_SREG) || (instruction.k == AVR_IO_RSTCTRL_SWRR)))))
+            {
+                edges[0].target = WCET_END;
+                edges[0].cycles = cycles;
+                return 1;
+            }
+            break;
+
+        case AVR_Op_RJMP:
+        case AVR_Op_JMP:
+            target = (instruction.op == AVR_Op_JMP) ? (long)instruction.k : ((long)word + 1L + instruction.k);
+
+            // A jump to itself stops the program (e.g. `_exit`)
+            if(target == (long)word)
+            {
+                edges[0].target = WCET_END;
+                edges[0].cycles = cycles;
+                return 1;
+            }
+
+            if((target >= (long)path->low) && (target < (long)path->high))
+            {
+                edges[0].target = target;
+                edges[0].cycles = cycles;
+                return 1;
+            }
+
+            // Tail call into another function
+            if((callee = wcet_function((unsigned long)target)) == WCET_UNBOUNDED)
+            {
+                return -1;
+            }
+            edges[0].target = WCET_END;
+            edges[0].cycles = cycles + callee;
+            return 1;
+
+        case AVR_Op_BRBS:
+        case AVR_Op_BRBC:
+            edges[0].target = (long)next;
+            edges[0].cycles = cycles;
+            edges[1].target = (long)word + 1L + instruction.k;
+            edges[1].cycles = cycles + 1;
+            return 2;
+
+        case AVR_Op_CPSE:
+        case AVR_Op_SBRC:
+        case AVR_Op_SBRS:
+        case AVR_Op_SBIC:
+        case AVR_Op_SBIS:
+        {
+            unsigned char skip = wcet_decode(next).words;
+
+            edges[0].target = (long)next;
+            edges[0].cycles = cycles;
+            edges[1].target = (long)(next + skip);
+            edges[1].cycles = cycles + skip;
+            return 2;
+        }
+
+        case AVR_Op_RCALL:
+        case AVR_Op_CALL:
+            target = (instruction.op == AVR_Op_CALL) ? (long)instruction.k : ((long)word + 1L + instruction.k);
+
+            if((callee = wcet_function((unsigned long)target)) == WCET_UNBOUNDED)
+            {
+                return -1;
+            }
+            cycles += callee;
+            break;
+
+        case AVR_Op_IJMP:
+        case AVR_Op_ICALL:
+            wcet_fail("indirect jump", word);
+            return -1;
+
+        case AVR_Op_Unknown:
+            wcet_fail("unknown instruction", word);
+            return -1;
+
+        default:
+            break;
+    }
+    edges[0].target = (long)next;
+    edges[0].cycles = cycles;
+
+    return 1;
+}
+
+/**
+ * @brief Calculate the longest loop-free path from an instruction (depth-first search).
+ *
+ * @return Cycles or `WCET_UNBOUNDED`.
+ */
+static long long wcet_search(WCET_Path *path, unsigned long word)
+{
+    unsigned long index = word - path->low;
+    WCET_Edge edges[2];
+    long long longest = 0;
+    int count;
+
+    path->state[index] = 1;
+
+    if((count = wcet_edges(path, word, edges)) < 0)
+    {
+        return WCET_UNBOUNDED;
+    }
+
+    for(int i=0; i < count; i++)
+    {
+        long long cycles = edges[i].cycles;
+
+        if(edges[i].target != WCET_END)
+        {
+            unsigned long target = (unsigned long)edges[i].target;
+
+            if((target < path->low) || (target >= path->high))
+            {
+                return wcet_fail("control flow leaves function", word);
+            }
+
+            switch(path->state[target - path->low])
+            {
+                case 0:
+                    if(wcet_search(path, target) == WCET_UNBOUNDED)
+                    {
+                        return WCET_UNBOUNDED;
+                    }
+                    cycles += path->longest[target - path->low];
+                    break;
+                case 1:
+                    // Back edge, the loop is accounted with the loop bound
+                    path->loops = 1;
+                    break;
+                default:
+                    cycles += path->longest[target - path->low];
+                    break;
+            }
+        }
+
+        if(cycles > longest)
+        {
+            longest = cycles;
+        }
+    }
+    path->state[index] = 2;
+    path->longest[index] = longest;
+
+    return longest;
+}
+
+/**
+ * @brief Bound the cycles from an instruction to the end of the path.
+ *
+ * @param low First word of the function.
+ * @param high First word behind the function.
+ * @param start Word address of the first instruction.
+ * @param mode End of the path.
+ * @param bound Loop iterations per call of the function.
+ *
+ * @return Cycles or `WCET_UNBOUNDED`.
+ */
+static long long wcet_path(unsigned long low, unsigned long high, unsigned long start, WCET_Mode mode, unsigned long bound)
+{
+    WCET_Path path;
+    long long cycles;
+
+    path.low = low;
+    path.high = high;
+    path.mode = mode;
+    path.loops = 0;
+    path.state = calloc(high - low, sizeof(*path.state));
+    path.longest = calloc(high - low, sizeof(*path.longest));
+
+    if(!path.state || !path.longest)
+    {
+        fprintf(stderr, "out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+    cycles = wcet_search(&path, start);
+
+    if((cycles != WCET_UNBOUNDED) && path.loops)
+    {
+        if(!bound)
+        {
+            cycles = wcet_fail("loop without bound", start);
+        }
+        else
+        {
+            // Every iteration is at most the longest loop-free path of the function
+            for(unsigned long i=0; i < (high - low); i++)
+            {
+                if((path.state[i] == 2) && (path.longest[i] > cycles))
+                {
+                    cycles = path.longest[i];
+                }
+            }
+            cycles *= (long long)(bound + 1);
+        }
+    }
+    free(path.state);
+    free(path.longest);
+
+    return cycles;
+}
+
+/**
+ * @brief Bound the cycles of a function call (without the call instruction).
+ *
+ * @param word Word address of the function entry.
+ *
+ * @return Cycles or `WCET_UNBOUNDED`.
+ */
+static long long wcet_function(unsigned long word)
+{
+    const IMAGE_Symbol *symbol = image_function(wcet_image, 2UL * word);
+    WCET_Function *function;
+
+    if(!symbol || !symbol->size || (symbol->address != (2UL * word)))
+    {
+        return wcet_fail("call to unknown function", word);
+    }
+    function = &wcet_functions[symbol - wcet_image->symbols];
+
+    switch(function->state)
+    {
+        case 1:
+            return wcet_fail("recursion", word);
+        case 2:
+            if((function->cycles == WCET_UNBOUNDED) && !wcet_reason[0])
+            {
+                strcpy(wcet_reason, function->reason);
+            }
+            return function->cycles;
+        default:
+            break;
+    }
+    function->state = 1;
+    function->cycles = wcet_path(word, (symbol->address + symbol->size) / 2UL, word, WCET_Mode_Function, function->bound);
+    function->state = 2;
+
+    if(function->cycles == WCET_UNBOUNDED)
+    {
+        strcpy(function->reason, wcet_reason);
+    }
+    return function->cycles;
+}
+
+static int wcet_load_budget(const char *path)
+{
+    char line[256];
+    FILE *file = fopen(path, "r");
+
+    if(!file)
+    {
+        perror(path);
+        return -1;
+    }
+
+    while(fgets(line, sizeof(line), file))
+    {
+        WCET_Budget *budget = &wcet_budgets[wcet_budget_count];
+        char name[sizeof(budget->name)];
+        unsigned long value;
+
+        if((line[0] == '#') || (sscanf(line, "%63s", name) != 1))
+        {
+            continue;
+        }
+
+        if(wcet_budget_count >= WCET_BUDGETS)
+        {
+            fprintf(stderr, "%s: too many entries\n", path);
+            fclose(file);
+            return -1;
+        }
+
+        if(!strcmp(name, "bound") ? (sscanf(line, "bound %63s %lu", budget->name, &value) != 2) : (sscanf(line, "%63s %lu", budget->name, &value) != 2))
+        {
+            fprintf(stderr, "%s: invalid line: %s", path, line);
+            fclose(file);
+            return -1;
+        }
+        budget->value = value;
+        budget->bound = !strcmp(name, "bound");
+        budget->used = 0;
+        wcet_budget_count++;
+    }
+    fclose(file);
+
+    return 0;
+}
+
+static WCET_Budget *wcet_budget(const char *name)
+{
+    for(unsigned int i=0; i < wcet_budget_count; i++)
+    {
+        if(!wcet_budgets[i].bound && !strcmp(wcet_budgets[i].name, name))
+        {
+            wcet_budgets[i].used = 1;
+            return &wcet_budgets[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Print the result of a root and check it against its budget.
+ *
+ * @return `0` if the root is within its budget (or has none), `1` otherwise.
+ */
+static int wcet_report(const char *name, long long cycles, unsigned long clock)
+{
+    WCET_Budget *budget = wcet_budget(name);
+    int failed = budget && ((cycles == WCET_UNBOUNDED) || ((unsigned long long)cycles > budget->value));
+
+    if(cycles == WCET_UNBOUNDED)
+    {
+        printf("%-28s %10s %10s", name, "unbounded", "-");
+    }
+    else
+    {
+        printf("%-28s %10lld %10.3f", name, cycles, (double)cycles * 1e6 / (double)clock);
+    }
+
+    if(budget)
+    {
+        printf(" %10lu  %s", budget->value, failed ? "EXCEEDED" : "ok");
+    }
+
+    if((cycles == WCET_UNBOUNDED) && wcet_reason[0])
+    {
+        printf("  (%s)", wcet_reason);
+    }
+    printf("\n");
+    wcet_reason[0] = '\0';
+
+    return failed;
+}
+
+static void wcet_usage(const char *name)
+{
+    fprintf(stderr, "usage: %s [-v] [-b budget] [-f clock] firmware.elf\n", name);
+}
+
+int main(int argc, char *argv[])
+{
+    static IMAGE_Firmware image;
+
+    unsigned long clock = WCET_CLOCK;
+    const char *budget = NULL;
+    unsigned char verbose = 0;
+    long long blocking = 0;
+    long long latency;
+    int failed = 0;
+    int option;
+
+    while((option = getopt(argc, argv, "vb:f:")) != -1)
+    {
+        switch(option)
+        {
+            case 'v': verbose = 1; break;
+            case 'b': budget = optarg; break;
+            case 'f': clock = strtoul(optarg, NULL, 0); break;
+            default:
+                wcet_usage(argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    if(((optind + 1) != argc) || !clock)
+    {
+        wcet_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if((budget && wcet_load_budget(budget)) || (image_load(argv[optind], &image) != 0))
+    {
+        return EXIT_FAILURE;
+    }
+    wcet_image = &image;
+    wcet_functions = calloc(image.symbol_count ? image.symbol_count : 1, sizeof(*wcet_functions));
+
+    if(!wcet_functions)
+    {
+        fprintf(stderr, "out of memory\n");
+        image_free(&image);
+        return EXIT_FAILURE;
+    }
+
+    for(unsigned int i=0; i < wcet_budget_count; i++)
+    {
+        const IMAGE_Symbol *symbol = wcet_budgets[i].bound ? image_symbol(&image, wcet_budgets[i].name) : NULL;
+
+        if(symbol)
+        {
+            wcet_functions[symbol - image.symbols].bound = wcet_budgets[i].value;
+            wcet_budgets[i].used = 1;
+        }
+    }
+
+    printf("%-28s %10s %10s %10s\n", "root", "cycles", "us", "budget");
+
+    // Interrupt service routines including the response and the jump in the vector table
+    for(unsigned char vector=1; vector < AVR_VECTORS; vector++)
+    {
+        const IMAGE_Symbol *symbol;
+        char name[64];
+        long long cycles;
+
+        snprintf(name, sizeof(name), "__vector_%u", vector);
+
+        if(!(symbol = image_symbol(&image, name)) || !avr_vector_name(vector))
+        {
+            continue;
+        }
+        cycles = wcet_function(symbol->address / 2UL);
+
+        if(cycles != WCET_UNBOUNDED)
+        {
+            cycles += WCET_RESPONSE_CYCLES + wcet_decode(vector).cycles;
+
+            if(blocking != WCET_UNBOUNDED && (cycles > blocking))
+            {
+                blocking = cycles;
+            }
+        }
+        else
+        {
+            blocking = WCET_UNBOUNDED;
+        }
+        snprintf(name, sizeof(name), "%s_vect", avr_vector_name(vector));
+        failed |= wcet_report(name, cycles, clock);
+    }
+
+    // Regions from cli to the next sei, SREG restore, software reset or return
+    for(unsigned int i=0; i < image.symbol_count; i++)
+    {
+        const IMAGE_Symbol *symbol = &image.symbols[i];
+        unsigned long low = symbol->address / 2UL;
+        unsigned long high = (symbol->address + symbol->size) / 2UL;
+        long long longest = 0;
+        unsigned char regions = 0;
+        char name[96];
+
+        if((symbol->type != IMAGE_Symbol_Function) || !symbol->size || (symbol != image_function(&image, symbol->address)))
+        {
+            continue;
+        }
+
+        for(unsigned long word = low; word < high; word += wcet_decode(word).words)
+        {
+            AVR_Instruction instruction = wcet_decode(word);
+            long long cycles;
+
+            if((instruction.op != AVR_Op_BCLR) || (instruction.d != 7) || ((word + 1) >= high))
+            {
+                continue;
+            }
+            cycles = wcet_path(low, high, word + 1, WCET_Mode_Region, wcet_functions[i].bound);
+            regions++;
+
+            if(verbose)
+            {
+                printf("  cli at %s+0x%lx: %lld cycles\n", symbol->name, 2UL * word - symbol->address, (cycles == WCET_UNBOUNDED) ? -1LL : (cycles + instruction.cycles));
+            }
+
+            if((cycles == WCET_UNBOUNDED) || (longest == WCET_UNBOUNDED))
+            {
+                longest = WCET_UNBOUNDED;
+            }
+            else if((cycles + instruction.cycles) > longest)
+            {
+                longest = cycles + instruction.cycles;
+            }
+        }
+
+        if(!regions)
+        {
+            continue;
+        }
+
+        if((longest == WCET_UNBOUNDED) || (blocking == WCET_UNBOUNDED))
+        {
+            blocking = WCET_UNBOUNDED;
+        }
+        else if(longest > blocking)
+        {
+            blocking = longest;
+        }
+        snprintf(name, sizeof(name), "cli:%s", symbol->name);
+        failed |= wcet_report(name, longest, clock);
+    }
+
+    // Other budgeted functions
+    for(unsigned int i=0; i < wcet_budget_count; i++)
+    {
+        const IMAGE_Symbol *symbol;
+
+        if(!wcet_budgets[i].bound && !wcet_budgets[i].used && strcmp(wcet_budgets[i].name, "latency") && (symbol = image_symbol(&image, wcet_budgets[i].name)) && (symbol->type == IMAGE_Symbol_Function))
+        {
+            failed |= wcet_report(symbol->name, wcet_function(symbol->address / 2UL), clock);
+        }
+    }
+
+    // An interrupt waits for the longest blocking ISR or region, the instruction in progress and its own response
+    latency = (blocking == WCET_UNBOUNDED) ? WCET_UNBOUNDED : (blocking + WCET_INSTRUCTION_CYCLES + WCET_RESPONSE_CYCLES);
+
+    if(latency == WCET_UNBOUNDED)
+    {
+        snprintf(wcet_reason, sizeof(wcet_reason), "blocking ISR or region is unbounded");
+    }
+    failed |= wcet_report("latency", latency, clock);
+
+    if(verbose)
+    {
+        printf("\n%-28s %10s %10s\n", "function", "cycles", "bound");
+
+        for(unsigned int i=0; i < image.symbol_count; i++)
+        {
+            if(wcet_functions[i].state == 2)
+            {
+                if(wcet_functions[i].cycles == WCET_UNBOUNDED)
+                {
+                    printf("%-28s %10s %10lu\n", image.symbols[i].name, "unbounded", wcet_functions[i].bound);
+                }
+                else
+                {
+                    printf("%-28s %10lld %10lu\n", image.symbols[i].name, wcet_functions[i].cycles, wcet_functions[i].bound);
+                }
+            }
+        }
+    }
+
+    for(unsigned int i=0; i < wcet_budget_count; i++)
+    {
+        if(!wcet_budgets[i].used)
+        {
+            fprintf(stderr, "%s: %s%s not found\n", argv[0], wcet_budgets[i].bound ? "bound " : "", wcet_budgets[i].name);
+            failed = 1;
+        }
+    }
+    free(wcet_functions);
+    image_free(&image);
+
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
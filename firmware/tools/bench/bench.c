@@ -0,0 +1,150 @@
+/**
+ * @file bench.c
+ * @brief Native micro-benchmarks for the RCC firmware hot paths.
+ *
+ * This tool links the firmware modules against the host backend and measures the host execution time of LED frame generation and battery measurement. Besides the host time, the virtual device time consumed on the target (SPI shifting, ADC conversions, delays) is reported for each operation.
+ *
+ * @author g.raf
+ * @date 2026-10-17
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger embedded systems project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/rcc "RCC - RGB LED Color Cube"
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../../RCC_FW_1_0/hal/host/host.h"
+#include "../../RCC_FW_1_0/hal/avr0/system/system.h"
+#include "../../RCC_FW_1_0/battery/battery.h"
+#include "../../RCC_FW_1_0/led/led.h"
+
+#ifndef BENCH_ITERATIONS
+    /**
+     * @def BENCH_ITERATIONS
+     * @brief Default number of iterations per benchmark.
+     */
+    #define BENCH_ITERATIONS 1000000UL
+#endif
+
+static unsigned long spi_bytes;
+
+static void bench_spi_observer(unsigned char data)
+{
+    (void)data;
+    spi_bytes++;
+}
+
+static LED_Data bench_color = { 0x0A, 0x12, 0x34, 0x56 };
+
+static void bench_led_data(void)
+{
+    led_data(bench_color);
+}
+
+static void bench_led_color(void)
+{
+    led_color(LED_Position_Left | LED_Position_Right, bench_color);
+}
+
+static void bench_leds_off(void)
+{
+    leds_off();
+}
+
+static void bench_led_status_color(void)
+{
+    volatile LED_Data color = led_status_color(LED_Status_Warning, LED_MIN_INTENSITY);
+    (void)color;
+}
+
+static void bench_led_balance(void)
+{
+    volatile LED_Data color = led_balance(bench_color);
+    (void)color;
+}
+
+static void bench_adc_average(void)
+{
+    volatile unsigned int value = adc_average(8);
+    (void)value;
+}
+
+static void bench_battery_status(void)
+{
+    volatile BATTERY_Status status = battery_status();
+    (void)status;
+}
+
+/**
+ * @struct BENCH_Case_t
+ * @brief Describes a single benchmark case.
+ */
+struct BENCH_Case_t
+{
+    const char *name;
+    void (*run)(void);
+};
+
+static const struct BENCH_Case_t bench_cases[] = {
+    { "led_data",         bench_led_data },
+    { "led_color",        bench_led_color },
+    { "leds_off",         bench_leds_off },
+    { "led_status_color", bench_led_status_color },
+    { "led_balance",      bench_led_balance },
+    { "adc_average(8)",   bench_adc_average },
+    { "battery_status",   bench_battery_status },
+};
+
+static double bench_now_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec * 1e9 + (double)now.tv_nsec;
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned long iterations = BENCH_ITERATIONS;
+
+    if(argc > 1)
+    {
+        iterations = strtoul(argv[1], NULL, 0);
+    }
+
+    host_init();
+    system_init();
+    led_init();
+    battery_init();
+    host->analog[BATTERY_CHANNEL] = 1000;
+    host_spi_observer = bench_spi_observer;
+
+    printf("%-18s %12s %14s %10s\n", "operation", "host ns/op", "device us/op", "SPI bytes");
+
+    for(unsigned char i=0; i < (sizeof(bench_cases)/sizeof(bench_cases[0])); i++)
+    {
+        unsigned long long device_start = host->time_ns;
+        double start;
+
+        spi_bytes = 0;
+        start = bench_now_ns();
+
+        for(unsigned long j=0; j < iterations; j++)
+        {
+            bench_cases[i].run();
+        }
+
+        printf("%-18s %12.1f %14.2f %10.1f\n",
+            bench_cases[i].name,
+            (bench_now_ns() - start) / (double)iterations,
+            (double)(host->time_ns - device_start) / 1000.0 / (double)iterations,
+            (double)spi_bytes / (double)iterations);
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,368 @@
+/**
+ * @file endurance.c
+ * @brief EEPROM endurance projection of the RCC firmware for usage profiles.
+ *
+ * This tool runs the firmware on the host backend under a usage model and counts the erase/write cycles of every EEPROM cell. The cycles per day of the most stressed cell are projected against the datasheet endurance, so different persistence strategies (`eeprom_write_block`, `eeprom_update_block`, coalesced commits, ...) can be compared by rebuilding the host library and running the same model.
+ *
+ * The usage model is generated for a number of days. Every adjustment enters a color command (2 to 5 presses, rotating through red, green, blue and intensity), selects the left or right LED alternately, ramps for a pseudo random time and stops the ramp, which commits the LED to the EEPROM. Every power cycle switches the cube off (button held) and on again. Instead of the model a scenario file can be given, which is then counted as one day of usage.
+ *
+ * With the usage model every adjustment has to commit its LED record exactly once, the commits of the left and right LED record are compared against the modelled adjustments and a mismatch (presses that fell into a blink or were counted into another command) fails the run.
+ *
+ * Usage: `rcc_endurance [-a adjustments] [-p power_cycles] [-n days] [-e endurance] [-r seed] [-s stride] [scenario]`
+ *
+ * - `-a` adjustments per day (default `5`), `-p` power cycles per day (default `2`), `-n` simulated days (default `7`).
+ * - `-e` erase/write endurance of a cell (default `ENDURANCE_CYCLES`).
+ * - `-r` seed of the ramp durations, `-s` time skipped per idle polling iteration (see `HOST_STRIDE_NS`).
+ *
+ * @author g.raf
+ * @date 2026-10-17
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger embedded systems project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/rcc "RCC - RGB LED Color Cube"
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "../../RCC_FW_1_0/hal/host/host.h"
+#include "../../RCC_FW_1_0/battery/battery.h"
+#include "../../RCC_FW_1_0/main.h"
+#include "scenario.h"
+
+#ifndef ENDURANCE_BATTERY_VALUE
+    /**
+     * @def ENDURANCE_BATTERY_VALUE
+     * @brief Battery ADC result at power-on (a fresh CR2032).
+     */
+    #define ENDURANCE_BATTERY_VALUE 1000U
+#endif
+
+#ifndef ENDURANCE_CYCLES
+    /**
+     * @def ENDURANCE_CYCLES
+     * @brief Erase/write endurance of an EEPROM cell (ATtiny402 datasheet, 100k cycles).
+     */
+    #define ENDURANCE_CYCLES 100000UL
+#endif
+
+#ifndef ENDURANCE_SHORT_NS
+    /**
+     * @def ENDURANCE_SHORT_NS
+     * @brief Duration of a short press.
+     */
+    #define ENDURANCE_SHORT_NS 100000000ULL
+#endif
+
+#ifndef ENDURANCE_BOOT_NS
+    /**
+     * @def ENDURANCE_BOOT_NS
+     * @brief Start of the usage model after the power-on.
+     *
+     * @details
+     * The boot blink (six phases of `LED_Delay_MS_200`) has to be finished, a margin of 500 ms is added.
+     */
+    #define ENDURANCE_BOOT_NS ((12ULL * UI_BLINK_UNIT_MS + 500ULL) * 1000000ULL)
+#endif
+
+#ifndef ENDURANCE_REPEAT_NS
+    /**
+     * @def ENDURANCE_REPEAT_NS
+     * @brief Distance of the presses of a command.
+     *
+     * @details
+     * Every detected press blinks both LEDs for two phases of `UI_BLINK_UNIT_MS` before the button is sampled again, the next press follows with a margin of 100 ms.
+     */
+    #define ENDURANCE_REPEAT_NS ((2ULL * UI_BLINK_UNIT_MS + 100ULL) * 1000000ULL)
+#endif
+
+#ifndef ENDURANCE_GAP_NS
+    /**
+     * @def ENDURANCE_GAP_NS
+     * @brief Pause between two interactions of the usage model.
+     *
+     * @details
+     * Must exceed `SWITCH_COMMAND_EXECUTE_MS` and the final blink of a command (six phases of `LED_Delay_MS_500`), otherwise presses are counted into the next command. A margin of 1 s is added.
+     */
+    #define ENDURANCE_GAP_NS ((((30ULL * UI_BLINK_UNIT_MS) > SWITCH_COMMAND_EXECUTE_MS ? (30ULL * UI_BLINK_UNIT_MS) : SWITCH_COMMAND_EXECUTE_MS) + 1000ULL) * 1000000ULL)
+#endif
+
+#ifndef ENDURANCE_SELECT_NS
+    /**
+     * @def ENDURANCE_SELECT_NS
+     * @brief Start of the press that selects the right LED, relative to the last press of the command.
+     *
+     * @details
+     * The selection starts `SWITCH_COMMAND_EXECUTE_MS` after the feedback blink (two phases of `UI_BLINK_UNIT_MS`) of the last press, the press falls one `UI_BLINK_UNIT_MS` into the first blink of the left LED.
+     */
+    #define ENDURANCE_SELECT_NS ((3ULL * UI_BLINK_UNIT_MS + SWITCH_COMMAND_EXECUTE_MS) * 1000000ULL)
+#endif
+
+#ifndef ENDURANCE_RAMP_LEFT_NS
+    /**
+     * @def ENDURANCE_RAMP_LEFT_NS
+     * @brief Start of the color ramp of the left LED relative to the last press of the command.
+     *
+     * @details
+     * The ramp follows the selection blink of the left LED (four phases of `LED_Delay_MS_500`) after `SWITCH_COMMAND_EXECUTE_MS` and the feedback blink, with a margin of 300 ms.
+     */
+    #define ENDURANCE_RAMP_LEFT_NS ((22ULL * UI_BLINK_UNIT_MS + SWITCH_COMMAND_EXECUTE_MS + 300ULL) * 1000000ULL)
+#endif
+
+#ifndef ENDURANCE_RAMP_RIGHT_NS
+    /**
+     * @def ENDURANCE_RAMP_RIGHT_NS
+     * @brief Start of the color ramp of the right LED relative to the last press of the command.
+     *
+     * @details
+     * The ramp follows the selection blink of the right LED (four phases of `LED_Delay_MS_500`) that starts with the selecting press, with a margin of 300 ms.
+     */
+    #define ENDURANCE_RAMP_RIGHT_NS (ENDURANCE_SELECT_NS + (20ULL * UI_BLINK_UNIT_MS + 300ULL) * 1000000ULL)
+#endif
+
+#ifndef ENDURANCE_OFF_NS
+    /**
+     * @def ENDURANCE_OFF_NS
+     * @brief Duration the button is held to switch the cube off.
+     *
+     * @details
+     * The feedback blink of the press, `SWITCH_SYSTEM_OFF_TIME_MS` and a margin of 500 ms.
+     */
+    #define ENDURANCE_OFF_NS ((2ULL * UI_BLINK_UNIT_MS + SWITCH_SYSTEM_OFF_TIME_MS + 500ULL) * 1000000ULL)
+#endif
+
+int rcc_main(void);
+
+// LED records of the firmware (main.c)
+extern LED_Data ee_led1;
+extern LED_Data ee_led2;
+
+static unsigned long endurance_seed = 1UL;
+static unsigned long endurance_left;
+static unsigned long endurance_right;
+
+static void endurance_usage(const char *name)
+{
+    fprintf(stderr, "usage: %s [-a adjustments] [-p power_cycles] [-n days] [-e endurance] [-r seed] [-s stride] [scenario]\n", name);
+    exit(EXIT_FAILURE);
+}
+
+/**
+ * @brief Pseudo random number (linear congruential generator) for reproducible usage.
+ */
+static unsigned long endurance_random(unsigned long range)
+{
+    endurance_seed = endurance_seed * 1103515245UL + 12345UL;
+    return ((endurance_seed >> 16) & 0x7FFFUL) % range;
+}
+
+static unsigned long long endurance_press(unsigned long long time_ns, unsigned long long duration_ns)
+{
+    host_event_add(time_ns, HOST_Event_Pin, SCENARIO_BUTTON_PIN, 1);
+    host_event_add(time_ns + duration_ns, HOST_Event_Pin, SCENARIO_BUTTON_PIN, 0);
+
+    return time_ns + duration_ns;
+}
+
+/**
+ * @brief Schedule a color adjustment.
+ *
+ * @return Time of the last scheduled event.
+ */
+static unsigned long long endurance_adjust(unsigned long long time_ns, unsigned long index)
+{
+    unsigned char presses = 2 + (unsigned char)(index % 4);
+    unsigned char right = (unsigned char)((index / 4) & 0x01);
+    unsigned long long ramp_ns = (500ULL + endurance_random(3500)) * 1000000ULL;
+    unsigned long long last_ns = time_ns;
+
+    for(unsigned char i=0; i < presses; i++)
+    {
+        last_ns = time_ns + i * ENDURANCE_REPEAT_NS;
+        endurance_press(last_ns, ENDURANCE_SHORT_NS);
+    }
+
+    if(right)
+    {
+        endurance_press(last_ns + ENDURANCE_SELECT_NS, ENDURANCE_SHORT_NS);
+        last_ns += ENDURANCE_RAMP_RIGHT_NS;
+        endurance_right++;
+    }
+    else
+    {
+        last_ns += ENDURANCE_RAMP_LEFT_NS;
+        endurance_left++;
+    }
+
+    return endurance_press(last_ns + ramp_ns, ENDURANCE_SHORT_NS);
+}
+
+/**
+ * @brief Schedule a power cycle (switch off and on again).
+ *
+ * @return Time of the last scheduled event.
+ */
+static unsigned long long endurance_power(unsigned long long time_ns)
+{
+    time_ns = endurance_press(time_ns, ENDURANCE_OFF_NS);
+
+    return endurance_press(time_ns + ENDURANCE_GAP_NS, ENDURANCE_SHORT_NS);
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned long long stride = HOST_STRIDE_NS;
+    unsigned long long time_ns = ENDURANCE_BOOT_NS;
+    unsigned long long end;
+    unsigned long adjustments = 5;
+    unsigned long cycles = 2;
+    unsigned long days = 7;
+    unsigned long endurance = ENDURANCE_CYCLES;
+    unsigned long total = 0;
+    unsigned long maximum = 0;
+    unsigned int worst = 0;
+    unsigned long left;
+    unsigned long right;
+    unsigned char mismatch = 0;
+    double per_day;
+    int status;
+    int option;
+
+    while((option = getopt(argc, argv, "a:p:n:e:r:s:")) != -1)
+    {
+        switch(option)
+        {
+            case 'a': adjustments = strtoul(optarg, NULL, 0); break;
+            case 'p': cycles = strtoul(optarg, NULL, 0); break;
+            case 'n': days = strtoul(optarg, NULL, 0); break;
+            case 'e': endurance = strtoul(optarg, NULL, 0); break;
+            case 'r': endurance_seed = strtoul(optarg, NULL, 0); break;
+            case 's':
+                if(scenario_time(optarg, &stride))
+                {
+                    endurance_usage(argv[0]);
+                }
+                break;
+            default:
+                endurance_usage(argv[0]);
+        }
+    }
+
+    if((optind < (argc - 1)) || !days || !endurance)
+    {
+        endurance_usage(argv[0]);
+    }
+
+    host_init();
+    host->stride_ns = stride;
+    host->analog[BATTERY_CHANNEL] = ENDURANCE_BATTERY_VALUE;
+
+    if(optind == (argc - 1))
+    {
+        if(scenario_load(argv[optind], &end, host_event_add) < 0)
+        {
+            return EXIT_FAILURE;
+        }
+        days = 1;
+    }
+    else
+    {
+        unsigned long index = 0;
+
+        // Interactions of a day are spread evenly, power cycles between the adjustments
+        for(unsigned long day=0; day < days; day++)
+        {
+            for(unsigned long i=0; i < (adjustments > cycles ? adjustments : cycles); i++)
+            {
+                if(i < adjustments)
+                {
+                    time_ns = endurance_adjust(time_ns, index++) + ENDURANCE_GAP_NS;
+                }
+
+                if(i < cycles)
+                {
+                    time_ns = endurance_power(time_ns) + ENDURANCE_GAP_NS;
+                }
+            }
+        }
+        host_event_add(time_ns, HOST_Event_End, 0, 0);
+    }
+
+    status = host_run(rcc_main);
+
+    for(unsigned int i=0; i < HOST_EEPROM_SIZE; i++)
+    {
+        total += host->eeprom_writes[i];
+
+        if(host->eeprom_writes[i] > maximum)
+        {
+            maximum = host->eeprom_writes[i];
+            worst = i;
+        }
+    }
+    per_day = (double)maximum / (double)days;
+    left = host->eeprom_commits[host_eeprom_address(&ee_led1, sizeof(LED_Data))];
+    right = host->eeprom_commits[host_eeprom_address(&ee_led2, sizeof(LED_Data))];
+
+    if(optind == (argc - 1))
+    {
+        printf("scenario:       %s (counted as 1 day)\n", argv[optind]);
+    }
+    else
+    {
+        printf("usage model:    %lu adjustments and %lu power cycles per day, %lu days\n", adjustments, cycles, days);
+        printf("adjustments:    %lu\n", adjustments * days);
+
+        // Every modelled adjustment has to end in exactly one commit of its LED record
+        mismatch = (left != endurance_left) || (right != endurance_right);
+    }
+    printf("result:         %s\n", (status == HOST_Exit_End) ? "completed" : "error");
+    printf("virtual time:   %.3f s\n", (double)host->time_ns / 1e9);
+    printf("boots:          %lu\n", host->boots);
+    printf("EEPROM commits: %lu (%.2f per day)\n", host->eeprom_operations, (double)host->eeprom_operations / (double)days);
+
+    if(optind == (argc - 1))
+    {
+        printf("LED records:    left %lu, right %lu commits\n", left, right);
+    }
+    else
+    {
+        printf("LED records:    left %lu/%lu, right %lu/%lu commits (modelled)%s\n", left, endurance_left, right, endurance_right, mismatch ? " MISMATCH" : "");
+    }
+    printf("cell cycles:    %lu (%.2f per day)\n\n", total, (double)total / (double)days);
+
+    printf("%-8s %12s %12s %12s\n", "cell", "cycles", "per day", "years");
+
+    for(unsigned int i=0; i < HOST_EEPROM_SIZE; i++)
+    {
+        double rate = (double)host->eeprom_writes[i] / (double)days;
+
+        if(!host->eeprom_writes[i])
+        {
+            continue;
+        }
+        printf("0x%04x   %12lu %12.2f %12.1f\n", i, host->eeprom_writes[i], rate, (double)endurance / rate / 365.0);
+    }
+    printf("\n");
+
+    if(maximum)
+    {
+        printf("worst cell:     0x%04x, %.2f cycles per day\n", worst, per_day);
+        printf("wear-out:       %.0f days (%.1f years at %lu cycles)\n", (double)endurance / per_day, (double)endurance / per_day / 365.0, endurance);
+    }
+    else
+    {
+        printf("wear-out:       never (no EEPROM writes)\n");
+    }
+
+    if(mismatch)
+    {
+        fprintf(stderr, "%s: the LED record commits do not match the modelled adjustments, presses of the model were lost\n", argv[0]);
+    }
+    return ((status == HOST_Exit_End) && !mismatch) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
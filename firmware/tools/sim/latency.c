@@ -0,0 +1,385 @@
+/**
+ * @file latency.c
+ * @brief Button-to-photon latency analysis of the RCC firmware on virtual time.
+ *
+ * This tool runs a scenario on the host backend, decodes the LED byte stream with the LED chain emulator and correlates every press of the button (rising edge of `PA7`) with the first latched LED frame that changes the visible output against the output shown at the press. Frames without visible effect (e.g. the black enable frame of `led_init()` after a sleeping chain) are not counted. The latencies are grouped by what the firmware did at the press:
+ *
+ * - `wake` all LEDs sleep (cube switched off), the response includes wake-up and restart.
+ * - `idle` the firmware sleeps without work: the main loop announced quiet systicks with `sleep_hint()` before its last sleep (`host->quiet`), which the user interface only does while it waits for a press, and no busy-wait delay runs.
+ * - `busy` the firmware runs a blocking sequence (boot blink, self-test, `host->waiting`) or the user interface animates (press, select, ramp, commit or shutdown blink) and has work on the next systick. The first visible change can be a frame of the running animation.
+ *
+ * The classes are taken from what the host backend observes (LED chain, busy-wait delays, sleep announcements), the firmware state itself is not accessed.
+ *
+ * Usage: `rcc_latency [-v] [-s stride] [-e class]... scenario`
+ *
+ * - `-v` prints every press with its latency.
+ * - `-s` sets the time skipped per idle polling iteration (default `0`, every polling iteration of the firmware is executed).
+ * - `-e` expects at least one answered press of a class (`wake`, `idle` or `busy`), the run fails if the scenario does not produce it (e.g. a wake-up press that arrives before the shutdown).
+ *
+ * @author g.raf
+ * @date 2026-10-17
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger embedded systems project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/rcc "RCC - RGB LED Color Cube"
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "../../RCC_FW_1_0/hal/host/host.h"
+#include "../../RCC_FW_1_0/battery/battery.h"
+#include "scenario.h"
+#include "ledchain.h"
+
+#ifndef LATENCY_BATTERY_VALUE
+    /**
+     * @def LATENCY_BATTERY_VALUE
+     * @brief Battery ADC result at power-on (a fresh CR2032).
+     */
+    #define LATENCY_BATTERY_VALUE 1000U
+#endif
+
+#ifndef LATENCY_BUTTON_PIN
+    /**
+     * @def LATENCY_BUTTON_PIN
+     * @brief `PORTA` pin of the button (`SWITCH`).
+     */
+    #define LATENCY_BUTTON_PIN 7
+#endif
+
+#ifndef LATENCY_PRESSES
+    /**
+     * @def LATENCY_PRESSES
+     * @brief Maximum number of analyzed presses per scenario.
+     */
+    #define LATENCY_PRESSES 1024
+#endif
+
+/**
+ * @enum LATENCY_Type_t
+ * @brief State of the cube when the button is pressed.
+ */
+enum LATENCY_Type_t
+{
+    LATENCY_Type_Wake=0,
+    LATENCY_Type_Idle,
+    LATENCY_Type_Busy,
+    LATENCY_Type_Count
+};
+
+/**
+ * @typedef LATENCY_Type
+ * @brief Alias for enum LATENCY_Type_t.
+ */
+typedef enum LATENCY_Type_t LATENCY_Type;
+
+/**
+ * @struct LATENCY_Press_t
+ * @brief A press of the button and the response of the LEDs.
+ */
+struct LATENCY_Press_t
+{
+    unsigned long long time_ns;         /**< Time of the rising edge */
+    unsigned long long latency_ns;      /**< Time until the first LED change */
+    LATENCY_Type type;                  /**< State of the cube at the press */
+    unsigned char answered;             /**< The visible output changed before the next press */
+    unsigned char shown[LEDCHAIN_LEDS][3];  /**< Visible output at the press */
+};
+
+/**
+ * @typedef LATENCY_Press
+ * @brief Alias for struct LATENCY_Press_t.
+ */
+typedef struct LATENCY_Press_t LATENCY_Press;
+
+/**
+ * @struct LATENCY_State_t
+ * @brief Analysis state shared between all firmware runs.
+ */
+struct LATENCY_State_t
+{
+    LEDCHAIN chain;                         /**< LED chain emulator */
+    LATENCY_Press press[LATENCY_PRESSES];   /**< Recorded presses */
+    unsigned int count;                     /**< Number of recorded presses */
+    unsigned char pending;                  /**< Last press waits for an LED change */
+    unsigned char level;                    /**< Last level of the button */
+};
+
+/**
+ * @typedef LATENCY_State
+ * @brief Alias for struct LATENCY_State_t.
+ */
+typedef struct LATENCY_State_t LATENCY_State;
+
+static const char *const latency_types[LATENCY_Type_Count] = { "wake", "idle", "busy" };
+
+static LATENCY_State *latency;
+static unsigned char latency_verbose;
+static unsigned char latency_expected;
+
+int rcc_main(void);
+
+static void latency_usage(const char *name)
+{
+    fprintf(stderr, "usage: %s [-v] [-s stride] [-e class]... scenario\n", name);
+    exit(EXIT_FAILURE);
+}
+
+static void latency_spi(unsigned char data)
+{
+    ledchain_byte(&latency->chain, host->time_ns, data);
+}
+
+/**
+ * @brief Calculate the visible output of the LEDs.
+ *
+ * @details
+ * The light of a channel is its PWM value scaled by the global intensity. A sleeping LED and an LED with intensity `0` are dark.
+ */
+static void latency_shown(const LEDCHAIN *chain, unsigned char shown[LEDCHAIN_LEDS][3])
+{
+    for(unsigned char i=0; i < LEDCHAIN_LEDS; i++)
+    {
+        const LEDCHAIN_Led *led = &chain->led[i];
+        unsigned int intensity = ((led->header & LEDCHAIN_MODE_MASK) == LEDCHAIN_MODE_SLEEP) ? 0 : (led->header & LEDCHAIN_INTENSITY_MASK);
+
+        shown[i][0] = (unsigned char)((led->red * intensity) / LEDCHAIN_INTENSITY_MASK);
+        shown[i][1] = (unsigned char)((led->green * intensity) / LEDCHAIN_INTENSITY_MASK);
+        shown[i][2] = (unsigned char)((led->blue * intensity) / LEDCHAIN_INTENSITY_MASK);
+    }
+}
+
+static void latency_change(const LEDCHAIN *chain, unsigned char led)
+{
+    unsigned char shown[LEDCHAIN_LEDS][3];
+    LATENCY_Press *press;
+
+    (void)led;
+
+    if(!latency->pending)
+    {
+        return;
+    }
+    press = &latency->press[latency->count - 1];
+    latency_shown(chain, shown);
+
+    if(memcmp(shown, press->shown, sizeof(shown)))
+    {
+        press->latency_ns = chain->time_ns - press->time_ns;
+        press->answered = 1;
+        latency->pending = 0;
+    }
+}
+
+/**
+ * @brief Classify a press by the activity of the firmware.
+ *
+ * @details
+ * Called within the firmware run that receives the press, so the LED chain, the busy-wait flag and the last sleep announcement of the host backend reflect the firmware at the time of the press.
+ */
+static LATENCY_Type latency_type(void)
+{
+    unsigned char sleeping = 1;
+
+    for(unsigned char i=0; i < LEDCHAIN_LEDS; i++)
+    {
+        if((latency->chain.led[i].header & LEDCHAIN_MODE_MASK) != LEDCHAIN_MODE_SLEEP)
+        {
+            sleeping = 0;
+        }
+    }
+
+    if(sleeping)
+    {
+        return LATENCY_Type_Wake;
+    }
+    return (host->quiet && !host->waiting) ? LATENCY_Type_Idle : LATENCY_Type_Busy;
+}
+
+static void latency_event(const HOST_Event *event)
+{
+    unsigned char level = event->value ? 1 : 0;
+
+    if((event->type != HOST_Event_Pin) || (event->channel != LATENCY_BUTTON_PIN))
+    {
+        return;
+    }
+
+    if(level && !latency->level && (latency->count < LATENCY_PRESSES))
+    {
+        LATENCY_Press *press = &latency->press[latency->count++];
+
+        press->time_ns = event->time_ns;
+        press->type = latency_type();
+        press->answered = 0;
+        latency_shown(&latency->chain, press->shown);
+        latency->pending = 1;
+    }
+    latency->level = level;
+}
+
+static int latency_compare(const void *a, const void *b)
+{
+    unsigned long long x = *(const unsigned long long *)a;
+    unsigned long long y = *(const unsigned long long *)b;
+
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Get a percentile of sorted values (nearest rank).
+ */
+static unsigned long long latency_percentile(const unsigned long long *values, unsigned int count, unsigned int percent)
+{
+    unsigned int rank = (count * percent + 99) / 100;
+
+    return values[rank ? (rank - 1) : 0];
+}
+
+int main(int argc, char *argv[])
+{
+    static unsigned long long values[LATENCY_PRESSES];
+
+    unsigned long long stride = 0;
+    unsigned long long end;
+    unsigned char failed = 0;
+    int events;
+    int status;
+    int option;
+
+    while((option = getopt(argc, argv, "vs:e:")) != -1)
+    {
+        switch(option)
+        {
+            case 'v':
+                latency_verbose = 1;
+                break;
+            case 'e':
+            {
+                unsigned char type;
+
+                for(type=0; (type < LATENCY_Type_Count) && strcmp(optarg, latency_types[type]); type++);
+
+                if(type == LATENCY_Type_Count)
+                {
+                    latency_usage(argv[0]);
+                }
+                latency_expected |= (unsigned char)(1U<<type);
+                break;
+            }
+            case 's':
+                if(scenario_time(optarg, &stride))
+                {
+                    latency_usage(argv[0]);
+                }
+                break;
+            default:
+                latency_usage(argv[0]);
+        }
+    }
+
+    if(optind != (argc - 1))
+    {
+        latency_usage(argv[0]);
+    }
+
+    host_init();
+    host->stride_ns = stride;
+    host->analog[BATTERY_CHANNEL] = LATENCY_BATTERY_VALUE;
+
+    if((events = scenario_load(argv[optind], &end, host_event_add)) < 0)
+    {
+        return EXIT_FAILURE;
+    }
+
+    // The LEDs and the recorded presses survive software resets of the firmware
+    latency = host_alloc(sizeof(*latency));
+    ledchain_init(&latency->chain);
+    latency->chain.observer.change = latency_change;
+    host_spi_observer = latency_spi;
+    host_event_observer = latency_event;
+
+    status = host_run(rcc_main);
+
+    printf("scenario:       %s (%d events)\n", argv[optind], events);
+    printf("result:         %s\n", (status == HOST_Exit_End) ? "completed" : "error");
+    printf("presses:        %u\n", latency->count);
+
+    if(latency_verbose)
+    {
+        for(unsigned int i=0; i < latency->count; i++)
+        {
+            const LATENCY_Press *press = &latency->press[i];
+
+            if(press->answered)
+            {
+                printf("%14.6f s  %-4s  %10.3f ms\n", (double)press->time_ns / 1e9, latency_types[press->type], (double)press->latency_ns / 1e6);
+            }
+            else
+            {
+                printf("%14.6f s  %-4s  %13s\n", (double)press->time_ns / 1e9, latency_types[press->type], "no response");
+            }
+        }
+    }
+    printf("\n%-6s %8s %12s %12s %12s %12s\n", "type", "presses", "min ms", "median ms", "p99 ms", "max ms");
+
+    for(unsigned char type=0; type < LATENCY_Type_Count; type++)
+    {
+        unsigned int count = 0;
+        unsigned int missed = 0;
+
+        for(unsigned int i=0; i < latency->count; i++)
+        {
+            if(latency->press[i].type != type)
+            {
+                continue;
+            }
+
+            if(latency->press[i].answered)
+            {
+                values[count++] = latency->press[i].latency_ns;
+            }
+            else
+            {
+                missed++;
+            }
+        }
+
+        if(!count)
+        {
+            if(missed)
+            {
+                printf("%-6s %8u %12s\n", latency_types[type], missed, "no response");
+            }
+
+            if(latency_expected & (1U<<type))
+            {
+                fprintf(stderr, "%s: no answered %s press, the scenario expects one\n", argv[0], latency_types[type]);
+                failed = 1;
+            }
+            continue;
+        }
+        qsort(values, count, sizeof(values[0]), latency_compare);
+
+        printf("%-6s %8u %12.3f %12.3f %12.3f %12.3f", latency_types[type], count + missed,
+            (double)values[0] / 1e6,
+            (double)latency_percentile(values, count, 50) / 1e6,
+            (double)latency_percentile(values, count, 99) / 1e6,
+            (double)values[count - 1] / 1e6);
+
+        if(missed)
+        {
+            printf("  (%u without response)", missed);
+        }
+        printf("\n");
+    }
+
+    return ((status == HOST_Exit_End) && !failed) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,271 @@
+/**
+ * @file ledchain.c
+ * @brief Model of the T3A33BRG LED chain driven by the RCC firmware over SPI.
+ *
+ * This source file decodes the SPI byte stream of the LED driver into the latched state of every LED of the chain and checks it against the protocol.
+ *
+ * @author g.raf
+ * @date 2026-10-17
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger embedded systems project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/rcc "RCC - RGB LED Color Cube"
+ */
+
+#include <string.h>
+
+#include "ledchain.h"
+
+static const char *const ledchain_violations[LEDCHAIN_Violation_Count] = {
+    "data before start frame",
+    "invalid frame header",
+    "incomplete frame",
+    "end frame too short",
+    "update gap too short"
+};
+
+/**
+ * @brief Power-on the LED chain.
+ *
+ * @param chain LED chain.
+ *
+ * @details
+ * All LEDs start enabled and dark, the decoder waits for the first start frame. The observer has to be set after the initialization.
+ */
+void ledchain_init(LEDCHAIN *chain)
+{
+    memset(chain, 0, sizeof(*chain));
+    chain->position = -1;
+    chain->changed = -1;
+
+    for(unsigned char i=0; i < LEDCHAIN_LEDS; i++)
+    {
+        chain->led[i].header = LEDCHAIN_MODE_ENABLE;
+    }
+}
+
+/**
+ * @brief Get the description of a protocol violation.
+ */
+const char *ledchain_violation(LEDCHAIN_Violation violation)
+{
+    return (violation < LEDCHAIN_Violation_Count) ? ledchain_violations[violation] : "unknown";
+}
+
+static void ledchain_report(LEDCHAIN *chain, LEDCHAIN_Violation violation)
+{
+    chain->violations[violation]++;
+
+    if(chain->observer.violation)
+    {
+        chain->observer.violation(chain, violation);
+    }
+}
+
+/**
+ * @brief Account the finished update (start frame, LED frames and end frame).
+ */
+static void ledchain_complete(LEDCHAIN *chain)
+{
+    unsigned long frames = (unsigned long)chain->position;
+
+    if(!chain->update_bytes)
+    {
+        return;
+    }
+
+    if(chain->length)
+    {
+        chain->wasted += chain->length;
+        chain->length = 0;
+        ledchain_report(chain, LEDCHAIN_Violation_Incomplete);
+    }
+
+    if(chain->changed < 0)
+    {
+        // The complete update could have been omitted
+        chain->wasted += chain->update_bytes;
+    }
+    else
+    {
+        // Unchanged LEDs behind the last change and oversized end frames
+        chain->wasted += (frames - (unsigned long)(chain->changed + 1)) * LEDCHAIN_FRAME_SIZE;
+
+        if(chain->trailer > LEDCHAIN_END_BYTES(chain->changed + 1))
+        {
+            chain->wasted += chain->trailer - LEDCHAIN_END_BYTES(chain->changed + 1);
+        }
+    }
+
+    if(frames && (chain->trailer < LEDCHAIN_END_BYTES(frames)))
+    {
+        ledchain_report(chain, LEDCHAIN_Violation_Latch);
+    }
+    chain->update_bytes = 0;
+}
+
+/**
+ * @brief Reset the chain with a start frame.
+ */
+static void ledchain_start(LEDCHAIN *chain)
+{
+    ledchain_complete(chain);
+
+    if(chain->updates && ((chain->start_ns - chain->time_ns) < LEDCHAIN_GAP_NS))
+    {
+        ledchain_report(chain, LEDCHAIN_Violation_Gap);
+    }
+    chain->position = 0;
+    chain->updates++;
+    chain->update_bytes = LEDCHAIN_FRAME_SIZE;
+    chain->trailer = 0;
+    chain->changed = -1;
+}
+
+/**
+ * @brief Pass a byte that is not part of a start frame to the LEDs.
+ */
+static int ledchain_data(LEDCHAIN *chain, unsigned long long time_ns, unsigned char data)
+{
+    LEDCHAIN_Led frame;
+    LEDCHAIN_Led *led;
+
+    if(chain->position < 0)
+    {
+        if(!chain->violations[LEDCHAIN_Violation_Unsynchronized])
+        {
+            ledchain_report(chain, LEDCHAIN_Violation_Unsynchronized);
+        }
+        chain->wasted++;
+
+        return -1;
+    }
+    chain->time_ns = time_ns;
+    chain->update_bytes++;
+
+    // All LEDs received their frame, further bytes only provide clock cycles
+    if(chain->position >= LEDCHAIN_LEDS)
+    {
+        chain->trailer++;
+        return -1;
+    }
+    chain->frame[chain->length++] = data;
+
+    if(chain->length < LEDCHAIN_FRAME_SIZE)
+    {
+        return -1;
+    }
+    chain->length = 0;
+
+    frame.header = chain->frame[0];
+    frame.blue = chain->frame[1];
+    frame.green = chain->frame[2];
+    frame.red = chain->frame[3];
+
+    if(((frame.header & LEDCHAIN_MODE_MASK) != LEDCHAIN_MODE_ENABLE) && ((frame.header & LEDCHAIN_MODE_MASK) != LEDCHAIN_MODE_SLEEP))
+    {
+        ledchain_report(chain, LEDCHAIN_Violation_Header);
+    }
+    led = &chain->led[chain->position];
+    chain->latches++;
+
+    if(!chain->known[chain->position] || memcmp(led, &frame, sizeof(frame)))
+    {
+        *led = frame;
+        chain->known[chain->position] = 1;
+        chain->changed = chain->position;
+        chain->changes++;
+
+        if(chain->observer.change)
+        {
+            chain->observer.change(chain, (unsigned char)chain->position);
+        }
+    }
+
+    return chain->position++;
+}
+
+/**
+ * @brief Shift a byte into the LED chain.
+ *
+ * @param chain LED chain.
+ * @param time_ns Time the transfer of the byte completed.
+ * @param data Byte sent by `spi_transfer`.
+ *
+ * @return Index of the LED that latched a new frame with this byte, `-1` otherwise.
+ */
+int ledchain_byte(LEDCHAIN *chain, unsigned long long time_ns, unsigned char data)
+{
+    unsigned char zeros = chain->zeros;
+    int latched = -1;
+    int led;
+
+    chain->bytes++;
+
+    // 32 zero bits at a frame boundary (re)start the chain
+    if(!chain->length && !data)
+    {
+        if(!chain->zeros)
+        {
+            chain->start_ns = time_ns;
+        }
+
+        if(++chain->zeros == LEDCHAIN_FRAME_SIZE)
+        {
+            ledchain_start(chain);
+        }
+        else if(chain->zeros > LEDCHAIN_FRAME_SIZE)
+        {
+            chain->zeros = LEDCHAIN_FRAME_SIZE;
+            chain->wasted++;
+        }
+        return -1;
+    }
+    chain->zeros = 0;
+
+    // Zero bytes of an incomplete start frame are data
+    if(zeros < LEDCHAIN_FRAME_SIZE)
+    {
+        while(zeros--)
+        {
+            if((led = ledchain_data(chain, time_ns, 0x00)) >= 0)
+            {
+                latched = led;
+            }
+        }
+    }
+
+    if((led = ledchain_data(chain, time_ns, data)) >= 0)
+    {
+        latched = led;
+    }
+    return latched;
+}
+
+/**
+ * @brief Finish the byte stream.
+ *
+ * @param chain LED chain.
+ *
+ * @details
+ * Accounts the last update as if another start frame followed. Zero bytes of an incomplete start frame are passed to the LEDs.
+ */
+void ledchain_flush(LEDCHAIN *chain)
+{
+    unsigned char zeros = chain->zeros;
+
+    chain->zeros = 0;
+
+    if(zeros < LEDCHAIN_FRAME_SIZE)
+    {
+        while(zeros--)
+        {
+            ledchain_data(chain, chain->start_ns, 0x00);
+        }
+    }
+    ledchain_complete(chain);
+}
@@ -0,0 +1,174 @@
+/**
+ * @file ledchain.h
+ * @brief Model of the T3A33BRG LED chain driven by the RCC firmware over SPI.
+ *
+ * This header declares an emulator for the APA102 style protocol of the T3A33BRG LEDs: a start frame of 32 zero bits resets the chain, every LED then takes the next 32-bit frame (`<header> <blue> <green> <red>`) and passes all further bytes to the next LED. The header consists of the mode bits (`111` enabled, `101` sleep) and the 5-bit global intensity. Because every LED forwards the data with half a clock delay, the last LED of an update needs additional clock cycles (end frame) to receive its complete frame.
+ *
+ * Besides the latched LED states the emulator checks the byte stream for protocol violations and counts the bytes that could be omitted without changing the LED states (redundant updates, unchanged trailing frames, oversized start and end frames).
+ *
+ * @author g.raf
+ * @date 2026-10-17
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger embedded systems project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/rcc "RCC - RGB LED Color Cube"
+ */
+
+#ifndef LEDCHAIN_H_
+#define LEDCHAIN_H_
+
+    #ifndef LEDCHAIN_LEDS
+        /**
+         * @def LEDCHAIN_LEDS
+         * @brief Number of LEDs in the chain (`LED_NUMBER_OF_LEDS`).
+         */
+        #define LEDCHAIN_LEDS 2
+    #endif
+
+    #ifndef LEDCHAIN_GAP_NS
+        /**
+         * @def LEDCHAIN_GAP_NS
+         * @brief Minimum time between the end of an update and the next start frame in nanoseconds.
+         *
+         * @details
+         * The firmware separates updates with the `_delay_us(10)` of `LED_EOF()`. The time is measured between the completion of the last byte of an update and the completion of the first byte of the next start frame.
+         */
+        #define LEDCHAIN_GAP_NS 10000ULL
+    #endif
+
+    /**
+     * @def LEDCHAIN_FRAME_SIZE
+     * @brief Number of bytes of a start and an LED frame.
+     */
+    #define LEDCHAIN_FRAME_SIZE 4
+
+    /**
+     * @def LEDCHAIN_MODE_MASK
+     * @brief Mode bits of the frame header.
+     */
+    #define LEDCHAIN_MODE_MASK 0xE0
+
+    /**
+     * @def LEDCHAIN_MODE_ENABLE
+     * @brief Mode bits of an enabled LED (`LED_ENABLE_FLAG`).
+     */
+    #define LEDCHAIN_MODE_ENABLE 0xE0
+
+    /**
+     * @def LEDCHAIN_MODE_SLEEP
+     * @brief Mode bits of a sleeping LED (`LED_SLEEP_FLAG`).
+     */
+    #define LEDCHAIN_MODE_SLEEP 0xA0
+
+    /**
+     * @def LEDCHAIN_INTENSITY_MASK
+     * @brief Global intensity bits of the frame header.
+     */
+    #define LEDCHAIN_INTENSITY_MASK 0x1F
+
+    /**
+     * @def LEDCHAIN_END_BYTES
+     * @brief Minimum number of end frame bytes after an update of the first `leds` LEDs (half a clock cycle per LED).
+     */
+    #define LEDCHAIN_END_BYTES(leds) (((leds) + 15) / 16)
+
+    /**
+     * @enum LEDCHAIN_Violation_t
+     * @brief Protocol violations detected in the SPI byte stream.
+     */
+    enum LEDCHAIN_Violation_t
+    {
+        LEDCHAIN_Violation_Unsynchronized=0,    /**< Data before the first start frame */
+        LEDCHAIN_Violation_Header,              /**< LED frame header with invalid mode bits */
+        LEDCHAIN_Violation_Incomplete,          /**< LED frame interrupted by the end of the stream */
+        LEDCHAIN_Violation_Latch,               /**< End frame too short, the last LED is not clocked in */
+        LEDCHAIN_Violation_Gap,                 /**< Next start frame earlier than `LEDCHAIN_GAP_NS` */
+        LEDCHAIN_Violation_Count
+    };
+
+    /**
+     * @typedef LEDCHAIN_Violation
+     * @brief Alias for enum LEDCHAIN_Violation_t.
+     */
+    typedef enum LEDCHAIN_Violation_t LEDCHAIN_Violation;
+
+    /**
+     * @struct LEDCHAIN_Led_t
+     * @brief Latched state of a single LED.
+     */
+    struct LEDCHAIN_Led_t
+    {
+        unsigned char header;       /**< Mode bits and global intensity */
+        unsigned char blue;         /**< PWM value of the blue channel */
+        unsigned char green;        /**< PWM value of the green channel */
+        unsigned char red;          /**< PWM value of the red channel */
+    };
+
+    /**
+     * @typedef LEDCHAIN_Led
+     * @brief Alias for struct LEDCHAIN_Led_t.
+     */
+    typedef struct LEDCHAIN_Led_t LEDCHAIN_Led;
+
+    /**
+     * @typedef LEDCHAIN
+     * @brief Alias for struct LEDCHAIN_t.
+     */
+    typedef struct LEDCHAIN_t LEDCHAIN;
+
+    /**
+     * @struct LEDCHAIN_Observer_t
+     * @brief Optional callbacks invoked by the emulator.
+     */
+    struct LEDCHAIN_Observer_t
+    {
+        void (*change)(const LEDCHAIN *chain, unsigned char led);                   /**< LED latched a different state */
+        void (*violation)(const LEDCHAIN *chain, LEDCHAIN_Violation violation);     /**< Protocol violation */
+    };
+
+    /**
+     * @typedef LEDCHAIN_Observer
+     * @brief Alias for struct LEDCHAIN_Observer_t.
+     */
+    typedef struct LEDCHAIN_Observer_t LEDCHAIN_Observer;
+
+    /**
+     * @struct LEDCHAIN_t
+     * @brief State of the LED chain and its protocol decoder.
+     */
+    struct LEDCHAIN_t
+    {
+        LEDCHAIN_Led led[LEDCHAIN_LEDS];                /**< Latched LED states */
+        unsigned char known[LEDCHAIN_LEDS];             /**< LED latched at least one frame */
+        unsigned char frame[LEDCHAIN_FRAME_SIZE];       /**< Frame currently received */
+        unsigned char length;                           /**< Received bytes of the current frame */
+        unsigned char zeros;                            /**< Zero bytes received at a frame boundary */
+        int position;                                   /**< LED receiving the next frame (`-1` before the first start frame) */
+
+        unsigned long long time_ns;                     /**< Time of the last byte passed to the LEDs */
+        unsigned long long start_ns;                    /**< Time of the first zero byte at the current frame boundary */
+        unsigned long update_bytes;                     /**< Bytes of the current update (start frame included) */
+        unsigned long trailer;                          /**< End frame bytes of the current update */
+        int changed;                                    /**< Last LED changed by the current update (`-1` none) */
+
+        unsigned long bytes;                            /**< Received bytes */
+        unsigned long updates;                          /**< Start frames */
+        unsigned long latches;                          /**< Latched LED frames */
+        unsigned long changes;                          /**< Latched LED frames that changed the LED state */
+        unsigned long wasted;                           /**< Bytes without effect on the LED states */
+        unsigned long violations[LEDCHAIN_Violation_Count];     /**< Protocol violations per type */
+
+        LEDCHAIN_Observer observer;                     /**< Optional callbacks */
+        void *user;                                     /**< User data of the observer */
+    };
+
+    void ledchain_init(LEDCHAIN *chain);
+    int ledchain_byte(LEDCHAIN *chain, unsigned long long time_ns, unsigned char data);
+    void ledchain_flush(LEDCHAIN *chain);
+    const char *ledchain_violation(LEDCHAIN_Violation violation);
+
+#endif /* LEDCHAIN_H_ */
@@ -0,0 +1,388 @@
+/**
+ * @file ledcheck.c
+ * @brief LED protocol checker and golden stream regression for the RCC firmware on virtual time.
+ *
+ * This tool runs the firmware on the host backend like `rcc_sim` and passes every byte of `spi_transfer` to the LED chain emulator. It reports protocol violations and the bytes that did not change any LED state, and records every change of a latched LED state as trace.
+ *
+ * Usage: `rcc_ledcheck [-v] [-s stride] [-g golden] [-w] scenario` or `rcc_ledcheck [-v] -x stream`
+ *
+ * - `-v` prints every LED change and violation.
+ * - `-s` sets the time skipped per idle polling iteration (see `HOST_STRIDE_NS`).
+ * - `-g` compares the trace with a golden file, `-w` writes the trace to the golden file instead.
+ * - `-x` replays a recorded byte stream instead of running the firmware (see `ledcheck_replay()`).
+ *
+ * The tool fails on protocol violations and on differences to the golden trace. A replayed stream fails if the violations differ from its expectation.
+ *
+ * @author g.raf
+ * @date 2026-10-17
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger embedded systems project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/rcc "RCC - RGB LED Color Cube"
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "../../RCC_FW_1_0/hal/host/host.h"
+#include "../../RCC_FW_1_0/battery/battery.h"
+#include "scenario.h"
+#include "ledchain.h"
+
+#ifndef LEDCHECK_BATTERY_VALUE
+    /**
+     * @def LEDCHECK_BATTERY_VALUE
+     * @brief Battery ADC result at power-on (a fresh CR2032).
+     */
+    #define LEDCHECK_BATTERY_VALUE 1000U
+#endif
+
+#ifndef LEDCHECK_BYTE_NS
+    /**
+     * @def LEDCHECK_BYTE_NS
+     * @brief Time between two bytes of a line of a replayed stream (SPI at `CLK_PER/4` with 10 MHz).
+     */
+    #define LEDCHECK_BYTE_NS 3200ULL
+#endif
+
+#ifndef LEDCHECK_LINE_SIZE
+    /**
+     * @def LEDCHECK_LINE_SIZE
+     * @brief Maximum length of a trace line.
+     */
+    #define LEDCHECK_LINE_SIZE 128
+#endif
+
+int rcc_main(void);
+
+static LEDCHAIN *ledcheck_chain;
+static FILE *ledcheck_trace;
+static unsigned char ledcheck_verbose;
+
+static const char *const ledcheck_expect[LEDCHAIN_Violation_Count] = {
+    "unsynchronized", "header", "incomplete", "latch", "gap"
+};
+
+static void ledcheck_usage(const char *name)
+{
+    fprintf(stderr, "usage: %s [-v] [-s stride] [-g golden] [-w] scenario\n       %s [-v] -x stream\n", name, name);
+    exit(EXIT_FAILURE);
+}
+
+static void ledcheck_spi(unsigned char data)
+{
+    ledchain_byte(ledcheck_chain, host->time_ns, data);
+}
+
+static void ledcheck_change(const LEDCHAIN *chain, unsigned char led)
+{
+    const LEDCHAIN_Led *state = &chain->led[led];
+
+    fprintf(ledcheck_trace, "%llu %u 0x%02x %u %u %u\n", chain->time_ns, led, state->header, state->red, state->green, state->blue);
+
+    if(ledcheck_verbose)
+    {
+        printf("%14.6f s  led %u  header 0x%02x  rgb %3u %3u %3u\n", (double)chain->time_ns / 1e9, led, state->header, state->red, state->green, state->blue);
+    }
+}
+
+static void ledcheck_violation(const LEDCHAIN *chain, LEDCHAIN_Violation violation)
+{
+    if(ledcheck_verbose)
+    {
+        printf("%14.6f s  violation: %s\n", (double)chain->time_ns / 1e9, ledchain_violation(violation));
+    }
+}
+
+/**
+ * @brief Replay a recorded SPI byte stream through the LED chain emulator.
+ *
+ * @param path Stream file.
+ *
+ * @return `0` if the violations match the expectation of the stream, `-1` otherwise.
+ *
+ * @details
+ * Every line of the stream holds a time (scenario units, `+` relative to the previous line) followed by hexadecimal bytes that are sent `LEDCHECK_BYTE_NS` apart. A line `expect <violation> <count>` sets the expected number of a violation (`unsynchronized`, `header`, `incomplete`, `latch` or `gap`), all other violations are expected to be absent. Lines starting with `#` are comments. The streams in `tools/sim/streams` exercise the violation paths of the emulator that the correct firmware output never reaches.
+ */
+static int ledcheck_replay(const char *path)
+{
+    unsigned long expected[LEDCHAIN_Violation_Count] = { 0 };
+    unsigned long long time_ns = 0;
+    char line[LEDCHECK_LINE_SIZE];
+    LEDCHAIN chain;
+    FILE *stream = fopen(path, "r");
+    int result = 0;
+
+    if(!stream)
+    {
+        fprintf(stderr, "%s: can not read stream\n", path);
+        return -1;
+    }
+    ledchain_init(&chain);
+    chain.observer.violation = ledcheck_violation;
+
+    while(fgets(line, sizeof(line), stream))
+    {
+        char *token = strtok(line, " \t\r\n");
+        unsigned long long value;
+
+        if(!token || (token[0] == '#'))
+        {
+            continue;
+        }
+
+        if(!strcmp(token, "expect"))
+        {
+            char *name = strtok(NULL, " \t\r\n");
+            char *count = strtok(NULL, " \t\r\n");
+            unsigned char i;
+
+            for(i=0; name && (i < LEDCHAIN_Violation_Count) && strcmp(name, ledcheck_expect[i]); i++);
+
+            if(!name || !count || (i >= LEDCHAIN_Violation_Count))
+            {
+                fprintf(stderr, "%s: invalid expectation\n", path);
+                fclose(stream);
+                return -1;
+            }
+            expected[i] = strtoul(count, NULL, 0);
+            continue;
+        }
+
+        if(scenario_time((token[0] == '+') ? &token[1] : token, &value))
+        {
+            fprintf(stderr, "%s: invalid time %s\n", path, token);
+            fclose(stream);
+            return -1;
+        }
+        time_ns = (token[0] == '+') ? (time_ns + value) : value;
+
+        for(unsigned long long at = time_ns; (token = strtok(NULL, " \t\r\n")) && (token[0] != '#'); at += LEDCHECK_BYTE_NS)
+        {
+            ledchain_byte(&chain, at, (unsigned char)strtoul(token, NULL, 16));
+        }
+    }
+    fclose(stream);
+    ledchain_flush(&chain);
+
+    printf("stream:         %s\n", path);
+    printf("SPI bytes:      %lu (%lu updates, %lu LED frames, %lu changes)\n", chain.bytes, chain.updates, chain.latches, chain.changes);
+
+    for(unsigned char i=0; i < LEDCHAIN_Violation_Count; i++)
+    {
+        int match = (chain.violations[i] == expected[i]);
+
+        if(chain.violations[i] || expected[i])
+        {
+            printf("violation:      %s (%lu, expected %lu)%s\n", ledchain_violation((LEDCHAIN_Violation)i), chain.violations[i], expected[i], match ? "" : " MISMATCH");
+        }
+
+        if(!match)
+        {
+            result = -1;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Compare the recorded trace with a golden file.
+ *
+ * @return Line of the first difference, `0` if both are identical, `-1` if the golden file can not be read.
+ */
+static long ledcheck_compare(FILE *trace, const char *path)
+{
+    char expected[LEDCHECK_LINE_SIZE];
+    char actual[LEDCHECK_LINE_SIZE];
+    FILE *golden = fopen(path, "r");
+    long line = 0;
+
+    if(!golden)
+    {
+        return -1;
+    }
+    rewind(trace);
+
+    for(;;)
+    {
+        char *a = fgets(actual, sizeof(actual), trace);
+        char *e = fgets(expected, sizeof(expected), golden);
+
+        line++;
+
+        if(!a || !e)
+        {
+            fclose(golden);
+            return (a || e) ? line : 0;
+        }
+
+        if(strcmp(actual, expected))
+        {
+            fclose(golden);
+            return line;
+        }
+    }
+}
+
+static int ledcheck_write(FILE *trace, const char *path)
+{
+    char buffer[LEDCHECK_LINE_SIZE];
+    FILE *golden = fopen(path, "w");
+
+    if(!golden)
+    {
+        return -1;
+    }
+    rewind(trace);
+
+    while(fgets(buffer, sizeof(buffer), trace))
+    {
+        fputs(buffer, golden);
+    }
+    fclose(golden);
+
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned long long stride = HOST_STRIDE_NS;
+    unsigned long long end;
+    unsigned long violations = 0;
+    const char *golden = NULL;
+    const char *stream = NULL;
+    unsigned char write = 0;
+    int result = EXIT_SUCCESS;
+    int events;
+    int status;
+    int option;
+
+    while((option = getopt(argc, argv, "vs:g:wx:")) != -1)
+    {
+        switch(option)
+        {
+            case 'v':
+                ledcheck_verbose = 1;
+                break;
+            case 's':
+                if(scenario_time(optarg, &stride))
+                {
+                    ledcheck_usage(argv[0]);
+                }
+                break;
+            case 'g':
+                golden = optarg;
+                break;
+            case 'w':
+                write = 1;
+                break;
+            case 'x':
+                stream = optarg;
+                break;
+            default:
+                ledcheck_usage(argv[0]);
+        }
+    }
+
+    if(stream)
+    {
+        if((optind != argc) || golden)
+        {
+            ledcheck_usage(argv[0]);
+        }
+        return ledcheck_replay(stream) ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
+
+    if((optind != (argc - 1)) || (write && !golden))
+    {
+        ledcheck_usage(argv[0]);
+    }
+
+    host_init();
+    host->stride_ns = stride;
+    host->analog[BATTERY_CHANNEL] = LEDCHECK_BATTERY_VALUE;
+
+    events = scenario_load(argv[optind], &end, host_event_add);
+    ledcheck_trace = tmpfile();
+
+    if((events < 0) || !ledcheck_trace)
+    {
+        return EXIT_FAILURE;
+    }
+
+    // Every firmware run writes complete lines to the trace shared by all runs
+    setvbuf(ledcheck_trace, NULL, _IOLBF, 0);
+
+    // The LEDs keep their state across software resets of the firmware
+    ledcheck_chain = host_alloc(sizeof(*ledcheck_chain));
+    ledchain_init(ledcheck_chain);
+    ledcheck_chain->observer.change = ledcheck_change;
+    ledcheck_chain->observer.violation = ledcheck_violation;
+    host_spi_observer = ledcheck_spi;
+
+    status = host_run(rcc_main);
+    ledchain_flush(ledcheck_chain);
+    fflush(ledcheck_trace);
+
+    printf("scenario:       %s (%d events)\n", argv[optind], events);
+    printf("result:         %s\n", (status == HOST_Exit_End) ? "completed" : "error");
+    printf("virtual time:   %.3f s\n", (double)host->time_ns / 1e9);
+    printf("SPI bytes:      %lu (%lu updates, %lu LED frames, %lu changes)\n", ledcheck_chain->bytes, ledcheck_chain->updates, ledcheck_chain->latches, ledcheck_chain->changes);
+    printf("wasted bytes:   %lu (%.1f%%)\n", ledcheck_chain->wasted, ledcheck_chain->bytes ? (100.0 * (double)ledcheck_chain->wasted / (double)ledcheck_chain->bytes) : 0.0);
+
+    for(unsigned char i=0; i < LEDCHAIN_Violation_Count; i++)
+    {
+        if(ledcheck_chain->violations[i])
+        {
+            printf("violation:      %s (%lu)\n", ledchain_violation((LEDCHAIN_Violation)i), ledcheck_chain->violations[i]);
+            violations += ledcheck_chain->violations[i];
+        }
+    }
+
+    if((status != HOST_Exit_End) || violations)
+    {
+        result = EXIT_FAILURE;
+    }
+
+    if(golden && write)
+    {
+        if(ledcheck_write(ledcheck_trace, golden))
+        {
+            fprintf(stderr, "%s: can not write %s\n", argv[0], golden);
+            result = EXIT_FAILURE;
+        }
+        else
+        {
+            printf("golden:         %s written\n", golden);
+        }
+    }
+    else if(golden)
+    {
+        long line = ledcheck_compare(ledcheck_trace, golden);
+
+        if(line < 0)
+        {
+            fprintf(stderr, "%s: can not read %s\n", argv[0], golden);
+            result = EXIT_FAILURE;
+        }
+        else if(line)
+        {
+            printf("golden:         %s differs at line %ld\n", golden, line);
+            result = EXIT_FAILURE;
+        }
+        else
+        {
+            printf("golden:         %s matches\n", golden);
+        }
+    }
+    fclose(ledcheck_trace);
+
+    return result;
+}
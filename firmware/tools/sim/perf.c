@@ -0,0 +1,120 @@
+/**
+ * @file perf.c
+ * @brief Readout of the on-device micro-benchmarks of the RCC firmware.
+ *
+ * This tool runs a scenario with the hidden micro-benchmark command (`PERF_COMMAND` presses) on virtual time and decodes the result block (`PERF_Data`, see `perf/perf.h`) from RAM. On the device the same block is read over UPDI from the address of `perf` in the map file.
+ *
+ * Usage: `rcc_perf [-s stride] [-b battery] scenario`
+ *
+ * - `-s` sets the time skipped per idle polling iteration (see `HOST_STRIDE_NS`), `-b` the battery ADC result at power-on.
+ *
+ * @note The host backend does not model the EEPROM programming time, the EEPROM write is reported with `0` counts.
+ *
+ * @author g.raf
+ * @date 2026-10-17
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger embedded systems project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/rcc "RCC - RGB LED Color Cube"
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "../../RCC_FW_1_0/hal/host/host.h"
+#include "../../RCC_FW_1_0/battery/battery.h"
+#include "../../RCC_FW_1_0/perf/perf.h"
+#include "scenario.h"
+
+#ifndef ENABLE_PERF_COMMAND
+    #error "rcc_perf needs the firmware built with ENABLE_PERF_COMMAND (make perf)"
+#endif
+
+#ifndef PERF_BATTERY_VALUE
+    /**
+     * @def PERF_BATTERY_VALUE
+     * @brief Battery ADC result at power-on (a fresh CR2032).
+     */
+    #define PERF_BATTERY_VALUE 1000U
+#endif
+
+int rcc_main(void);
+
+static void perf_usage(const char *name)
+{
+    fprintf(stderr, "usage: %s [-s stride] [-b battery] scenario\n", name);
+    exit(EXIT_FAILURE);
+}
+
+static void perf_print(const char *name, uint16_t counts, unsigned long budget, unsigned char exceeded)
+{
+    printf("%-12s %8u %10lu %10.1f %10lu %8s\n", name, counts, 2UL * counts, (double)counts * 2000000.0 / PERF_CLK_PER, budget, exceeded ? "exceeded" : "ok");
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned long long stride = HOST_STRIDE_NS;
+    unsigned long battery = PERF_BATTERY_VALUE;
+    unsigned long long end;
+    int status;
+    int option;
+
+    while((option = getopt(argc, argv, "s:b:")) != -1)
+    {
+        switch(option)
+        {
+            case 's':
+                if(scenario_time(optarg, &stride))
+                {
+                    perf_usage(argv[0]);
+                }
+                break;
+            case 'b':
+                battery = strtoul(optarg, NULL, 0);
+                break;
+            default:
+                perf_usage(argv[0]);
+        }
+    }
+
+    if(optind != (argc - 1))
+    {
+        perf_usage(argv[0]);
+    }
+
+    host_init();
+    host->stride_ns = stride;
+    host->analog[BATTERY_CHANNEL] = battery;
+
+    if(scenario_load(argv[optind], &end, host_event_add) < 0)
+    {
+        return EXIT_FAILURE;
+    }
+
+    status = host_run(rcc_main);
+
+    printf("scenario:       %s\n", argv[optind]);
+    printf("result:         %s\n", (status == HOST_Exit_End) ? "completed" : "error");
+    printf("virtual time:   %.3f s\n", (double)host->time_ns / 1e9);
+    printf("boots:          %lu\n", host->boots);
+    printf("block:          %zu bytes\n", sizeof(PERF_Data));
+
+    if(perf.magic != PERF_MAGIC)
+    {
+        printf("magic:          0x%04x (no valid block, expected 0x%04x)\n", perf.magic, PERF_MAGIC);
+        return EXIT_FAILURE;
+    }
+    printf("runs:           %u\n\n", perf.runs);
+
+    printf("%-12s %8s %10s %10s %10s %8s\n", "measurement", "counts", "cycles", "us", "budget us", "result");
+    perf_print("frame", perf.frame, PERF_FRAME_US, perf.exceeded & PERF_Exceeded_Frame);
+    perf_print("adc", perf.adc, PERF_ADC_US, perf.exceeded & PERF_Exceeded_ADC);
+    perf_print("eeprom", perf.eeprom, PERF_EEPROM_US, perf.exceeded & PERF_Exceeded_EEPROM);
+
+    return (status == HOST_Exit_End) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
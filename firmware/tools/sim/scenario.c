@@ -0,0 +1,233 @@
+/**
+ * @file scenario.c
+ * @brief Scenario file parser for the RCC host simulation.
+ *
+ * This source file converts a scenario text file into scheduled events of the host backend. The syntax is described in scenario.h.
+ *
+ * @author g.raf
+ * @date 2026-10-17
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger embedded systems project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/rcc "RCC - RGB LED Color Cube"
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../RCC_FW_1_0/battery/battery.h"
+#include "scenario.h"
+
+/**
+ * @brief Parse a time value with optional unit.
+ *
+ * @param text Time value (e.g. `250`, `1.5s`, `8h`), without a leading `+`.
+ * @param ns Parsed time in nanoseconds.
+ *
+ * @return `0` on success, `-1` on a syntax error.
+ */
+int scenario_time(const char *text, unsigned long long *ns)
+{
+    static const struct
+    {
+        const char *unit;
+        double scale;
+    } units[] = {
+        { "",   1e6 },
+        { "us", 1e3 },
+        { "ms", 1e6 },
+        { "s",  1e9 },
+        { "m",  60e9 },
+        { "h",  3600e9 },
+        { "d",  86400e9 },
+    };
+    char *end;
+    double value = strtod(text, &end);
+
+    if((end == text) || (value < 0.0))
+    {
+        return -1;
+    }
+
+    for(unsigned char i=0; i < (sizeof(units)/sizeof(units[0])); i++)
+    {
+        if(!strcmp(end, units[i].unit))
+        {
+            *ns = (unsigned long long)(value * units[i].scale + 0.5);
+            return 0;
+        }
+    }
+    return -1;
+}
+
+static int scenario_level(const char *text, unsigned int *level)
+{
+    if(!text || (strcmp(text, "0") && strcmp(text, "1")))
+    {
+        return -1;
+    }
+    *level = (unsigned int)(text[0] - '0');
+
+    return 0;
+}
+
+static int scenario_value(const char *text, unsigned int limit, unsigned int *value)
+{
+    char *end;
+    unsigned long parsed;
+
+    if(!text)
+    {
+        return -1;
+    }
+    parsed = strtoul(text, &end, 0);
+
+    if((end == text) || *end || (parsed > limit))
+    {
+        return -1;
+    }
+    *value = (unsigned int)parsed;
+
+    return 0;
+}
+
+/**
+ * @brief Load a scenario file and pass its events to a handler.
+ *
+ * @param path Path of the scenario file (`-` reads from standard input).
+ * @param end_ns Virtual time at which the scenario ends.
+ * @param handler Event handler (e.g. `host_event_add`).
+ *
+ * @return Number of scheduled events, `-1` on error (a message is printed to `stderr`).
+ *
+ * @note For the host backend this must be called after `host_init()`, which discards all scheduled events.
+ */
+int scenario_load(const char *path, unsigned long long *end_ns, SCENARIO_Handler handler)
+{
+    FILE *file = strcmp(path, "-") ? fopen(path, "r") : stdin;
+    char line[256];
+    unsigned int number = 0;
+    unsigned long long time = 0;
+    unsigned long long last = 0;
+    unsigned char ended = 0;
+    int count = 0;
+    int status = 0;
+
+    if(!file)
+    {
+        perror(path);
+        return -1;
+    }
+
+    while(!status && fgets(line, sizeof(line), file))
+    {
+        char *comment = strchr(line, '#');
+        char *token[4] = { NULL };
+        unsigned char tokens = 0;
+        unsigned long long at;
+        unsigned long long duration;
+        unsigned int channel;
+        unsigned int value;
+
+        number++;
+
+        if(comment)
+        {
+            *comment = '\0';
+        }
+
+        for(char *next = strtok(line, " \t\r\n"); next && (tokens < 4); next = strtok(NULL, " \t\r\n"))
+        {
+            token[tokens++] = next;
+        }
+
+        if(!tokens)
+        {
+            continue;
+        }
+
+        if((tokens < 2) || ended)
+        {
+            status = -1;
+            break;
+        }
+
+        if(token[0][0] == '+')
+        {
+            status = scenario_time(&token[0][1], &at);
+            at += time;
+        }
+        else
+        {
+            status = scenario_time(token[0], &at);
+        }
+
+        if(status || (at < last))
+        {
+            status = -1;
+            break;
+        }
+        time = at;
+
+        if(!strcmp(token[1], "button") && !scenario_level(token[2], &value))
+        {
+            status = handler(at, HOST_Event_Pin, SCENARIO_BUTTON_PIN, value);
+            count++;
+        }
+        else if(!strcmp(token[1], "pin") && !scenario_value(token[2], 7, &channel) && !scenario_level(token[3], &value))
+        {
+            status = handler(at, HOST_Event_Pin, (unsigned char)channel, value);
+            count++;
+        }
+        else if(!strcmp(token[1], "press") && token[2] && !scenario_time(token[2], &duration))
+        {
+            status = handler(at, HOST_Event_Pin, SCENARIO_BUTTON_PIN, 1) |
+                     handler(at + duration, HOST_Event_Pin, SCENARIO_BUTTON_PIN, 0);
+            time = at + duration;
+            count += 2;
+        }
+        else if(!strcmp(token[1], "battery") && !scenario_value(token[2], 0xFFFF, &value))
+        {
+            status = handler(at, HOST_Event_Analog, BATTERY_CHANNEL, value);
+            count++;
+        }
+        else if(!strcmp(token[1], "analog") && !scenario_value(token[2], HOST_ANALOG_CHANNELS - 1, &channel) && !scenario_value(token[3], 0xFFFF, &value))
+        {
+            status = handler(at, HOST_Event_Analog, (unsigned char)channel, value);
+            count++;
+        }
+        else if(!strcmp(token[1], "end"))
+        {
+            ended = 1;
+        }
+        else
+        {
+            status = -1;
+        }
+        last = at;
+    }
+
+    if(file != stdin)
+    {
+        fclose(file);
+    }
+
+    if(status)
+    {
+        fprintf(stderr, "%s:%u: invalid scenario line\n", path, number);
+        return -1;
+    }
+
+    if(!ended)
+    {
+        time += SCENARIO_END_DELAY_NS;
+    }
+    *end_ns = time;
+
+    return (handler(time, HOST_Event_End, 0, 0) < 0) ? -1 : count;
+}
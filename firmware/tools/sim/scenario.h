@@ -0,0 +1,62 @@
+/**
+ * @file scenario.h
+ * @brief Scenario file parser for the RCC host simulation.
+ *
+ * A scenario describes the environment of the device over time (button, battery voltage, analog inputs) and is converted into events for the host backend (`host_event_add`) or the AVR simulator. Each line has the form `<time> <command> [arguments]`, empty lines and text after `#` are ignored.
+ *
+ * Times are given with an optional unit (`us`, `ms`, `s`, `m`, `h`, `d`, default `ms`). A leading `+` makes the time relative to the end of the previous line (e.g. after the release of a `press`).
+ *
+ * | Command                    | Description                                            |
+ * |----------------------------|--------------------------------------------------------|
+ * | `button <0/1>`             | Release (0) or push (1) the button                     |
+ * | `press <duration>`         | Push the button and release it after `duration`        |
+ * | `battery <value>`          | Set the ADC result of the battery channel              |
+ * | `analog <channel> <value>` | Set the ADC result of an analog input                  |
+ * | `pin <pin> <0/1>`          | Set the external level of a `PORTA` pin                |
+ * | `end`                      | End the scenario                                       |
+ *
+ * Without an `end` command the scenario ends `SCENARIO_END_DELAY_NS` after the last event.
+ *
+ * @author g.raf
+ * @date 2026-10-17
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger embedded systems project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/rcc "RCC - RGB LED Color Cube"
+ */
+
+#ifndef SCENARIO_H_
+#define SCENARIO_H_
+
+    #include "../../RCC_FW_1_0/hal/host/host.h"
+
+    #ifndef SCENARIO_BUTTON_PIN
+        /**
+         * @def SCENARIO_BUTTON_PIN
+         * @brief `PORTA` pin number of the button (`SWITCH` in main.h).
+         */
+        #define SCENARIO_BUTTON_PIN 7
+    #endif
+
+    #ifndef SCENARIO_END_DELAY_NS
+        /**
+         * @def SCENARIO_END_DELAY_NS
+         * @brief Time the scenario continues after the last event if no `end` command is given.
+         */
+        #define SCENARIO_END_DELAY_NS 1000000000ULL
+    #endif
+
+    /**
+     * @typedef SCENARIO_Handler
+     * @brief Receives the events of a scenario (signature of `host_event_add`).
+     */
+    typedef int (*SCENARIO_Handler)(unsigned long long time_ns, HOST_Event_Type type, unsigned char channel, unsigned int value);
+
+    int scenario_time(const char *text, unsigned long long *ns);
+    int scenario_load(const char *path, unsigned long long *end_ns, SCENARIO_Handler handler);
+
+#endif /* SCENARIO_H_ */
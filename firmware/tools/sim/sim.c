@@ -0,0 +1,133 @@
+/**
+ * @file sim.c
+ * @brief Scenario runner executing the complete RCC firmware on virtual time.
+ *
+ * This tool runs the unmodified firmware (`main()` of RCC_FW_1_0, renamed to `rcc_main()`) on the host backend and feeds it with the button and battery timeline of a scenario file. Delays, `systick` and sleep modes are executed on the virtual clock, so hours of device operation replay within a fraction of a second.
+ *
+ * Usage: `rcc_sim [-v] [-s stride] [-b battery] scenario`
+ *
+ * - `-v` prints every applied event.
+ * - `-s` sets the time skipped per idle polling iteration (see `HOST_STRIDE_NS`), `0` disables the acceleration.
+ * - `-b` sets the battery ADC result at power-on (default `SIM_BATTERY_VALUE`).
+ *
+ * @author g.raf
+ * @date 2026-10-17
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger embedded systems project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/rcc "RCC - RGB LED Color Cube"
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "../../RCC_FW_1_0/hal/host/host.h"
+#include "../../RCC_FW_1_0/battery/battery.h"
+#include "scenario.h"
+
+#ifndef SIM_BATTERY_VALUE
+    /**
+     * @def SIM_BATTERY_VALUE
+     * @brief Battery ADC result at power-on (a fresh CR2032).
+     */
+    #define SIM_BATTERY_VALUE 1000U
+#endif
+
+int rcc_main(void);
+
+static void sim_usage(const char *name)
+{
+    fprintf(stderr, "usage: %s [-v] [-s stride] [-b battery] scenario\n", name);
+    exit(EXIT_FAILURE);
+}
+
+static void sim_event_observer(const HOST_Event *event)
+{
+    static const char *types[] = { "pin", "analog", "end" };
+
+    printf("%14.6f s  boot %-4lu %-6s %2u %5u\n",
+        (double)event->time_ns / 1e9,
+        host->boots,
+        types[event->type],
+        event->channel,
+        event->value);
+}
+
+static double sim_now_s(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned long long stride = HOST_STRIDE_NS;
+    unsigned long battery = SIM_BATTERY_VALUE;
+    unsigned long long end;
+    unsigned char verbose = 0;
+    double start;
+    int events;
+    int status;
+    int option;
+
+    while((option = getopt(argc, argv, "vs:b:")) != -1)
+    {
+        switch(option)
+        {
+            case 'v':
+                verbose = 1;
+                break;
+            case 's':
+                if(scenario_time(optarg, &stride))
+                {
+                    sim_usage(argv[0]);
+                }
+                break;
+            case 'b':
+                battery = strtoul(optarg, NULL, 0);
+                break;
+            default:
+                sim_usage(argv[0]);
+        }
+    }
+
+    if(optind != (argc - 1))
+    {
+        sim_usage(argv[0]);
+    }
+
+    host_init();
+    host->stride_ns = stride;
+    host->analog[BATTERY_CHANNEL] = (unsigned int)battery;
+
+    events = scenario_load(argv[optind], &end, host_event_add);
+
+    if(events < 0)
+    {
+        return EXIT_FAILURE;
+    }
+
+    if(verbose)
+    {
+        host_event_observer = sim_event_observer;
+    }
+
+    start = sim_now_s();
+    status = host_run(rcc_main);
+
+    printf("scenario:       %s (%d events)\n", argv[optind], events);
+    printf("result:         %s\n", (status == HOST_Exit_End) ? "completed" : "error");
+    printf("virtual time:   %.3f s (%.3f s asleep)\n", (double)host->time_ns / 1e9, (double)host->sleep_ns / 1e9);
+    printf("boots:          %lu\n", host->boots);
+    printf("interrupts:     %lu\n", host->interrupts);
+    printf("host time:      %.3f s (%.0fx real time)\n", sim_now_s() - start, ((double)host->time_ns / 1e9) / (sim_now_s() - start));
+
+    return (status == HOST_Exit_End) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,220 @@
+/**
+ * @file stats.c
+ * @brief Readout of the persistent usage statistics of the RCC firmware.
+ *
+ * This tool decodes the usage statistics record (`STATS_Data`, see `stats/stats.h`) from the EEPROM. The EEPROM is either taken from the host backend after a scenario was run on virtual time, or from a raw dump of the device EEPROM read over UPDI (e.g. `avrdude -p t402 -U eeprom:r:eeprom.bin:r`).
+ *
+ * Usage: `rcc_stats [-s stride] [-b battery] scenario` or `rcc_stats -r eeprom.bin`
+ *
+ * - `-s` sets the time skipped per idle polling iteration (see `HOST_STRIDE_NS`), `-b` the battery ADC result at power-on.
+ * - `-r` decodes a raw EEPROM dump of `EEPROM_SIZE` bytes instead of running a scenario.
+ *
+ * @note The record only contains the counters of the last write. Counters accumulated in RAM since then are not visible until the next shutdown or periodic write.
+ *
+ * @author g.raf
+ * @date 2026-10-17
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger embedded systems project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/rcc "RCC - RGB LED Color Cube"
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "../../RCC_FW_1_0/hal/host/host.h"
+#include "../../RCC_FW_1_0/battery/battery.h"
+#include "../../RCC_FW_1_0/stats/stats.h"
+#include "scenario.h"
+
+#ifndef STATS_BATTERY_VALUE
+    /**
+     * @def STATS_BATTERY_VALUE
+     * @brief Battery ADC result at power-on (a fresh CR2032).
+     */
+    #define STATS_BATTERY_VALUE 1000U
+#endif
+
+/**
+ * @def STATS_OFFSET
+ * @brief Offset of the record in the EEPROM.
+ */
+#define STATS_OFFSET ((unsigned int)(uintptr_t)STATS_EEPROM)
+
+int rcc_main(void);
+
+static void stats_usage(const char *name)
+{
+    fprintf(stderr, "usage: %s [-s stride] [-b battery] scenario\n       %s -r eeprom.bin\n", name, name);
+    exit(EXIT_FAILURE);
+}
+
+static unsigned long stats_read(const unsigned char **data, unsigned char size)
+{
+    unsigned long value = 0;
+
+    // The record is stored little endian on the target
+    for(unsigned char i=0; i < size; i++)
+    {
+        value |= (unsigned long)(*data)[i] << (8 * i);
+    }
+    *data += size;
+
+    return value;
+}
+
+/**
+ * @brief Decode and print the record.
+ *
+ * @return `0` for a valid record, `-1` otherwise.
+ */
+static int stats_print(const unsigned char *eeprom)
+{
+    static const char *commands[STATS_COMMANDS] = { "red", "green", "blue", "intensity" };
+    const unsigned char *data = &eeprom[STATS_OFFSET];
+    unsigned long version = stats_read(&data, 1);
+    unsigned long credit = stats_read(&data, 1);
+    unsigned long power_on = stats_read(&data, 2);
+    unsigned long low_battery = stats_read(&data, 2);
+    unsigned long flushes = stats_read(&data, 2);
+    unsigned long on_time = stats_read(&data, 4);
+
+    printf("record:         0x%04x, %zu bytes\n", STATS_OFFSET, sizeof(STATS_Data));
+
+    if(version != STATS_VERSION)
+    {
+        printf("version:        0x%02lx (no valid record, expected 0x%02x)\n", version, STATS_VERSION);
+        return -1;
+    }
+    printf("version:        0x%02lx\n", version);
+    printf("power-on:       %lu\n", power_on);
+    printf("low battery:    %lu\n", low_battery);
+    printf("on-time:        %lu s (%.2f h)\n", on_time, (double)on_time / 3600.0);
+    printf("writes:         %lu (budget %lu of %u left)\n\n", flushes, credit, STATS_WRITE_BUDGET);
+
+    printf("%-12s %12s\n", "command", "adjustments");
+
+    for(unsigned char i=0; i < STATS_COMMANDS; i++)
+    {
+        printf("%-12s %12lu\n", commands[i], stats_read(&data, 2));
+    }
+    printf("\n%-12s %12s\n", "intensity", "minutes");
+
+    for(unsigned char i=0; i < STATS_INTENSITY_BINS; i++)
+    {
+        unsigned int low = i << STATS_INTENSITY_SHIFT;
+        char range[16];
+
+        if(i == (STATS_INTENSITY_BINS - 1))
+        {
+            snprintf(range, sizeof(range), "%u+", low);
+        }
+        else
+        {
+            snprintf(range, sizeof(range), "%u-%u", low, ((i + 1) << STATS_INTENSITY_SHIFT) - 1);
+        }
+        printf("%-12s %12lu\n", range, stats_read(&data, 2));
+    }
+
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned long long stride = HOST_STRIDE_NS;
+    unsigned long battery = STATS_BATTERY_VALUE;
+    unsigned long long end;
+    const char *raw = NULL;
+    int status;
+    int option;
+
+    while((option = getopt(argc, argv, "s:b:r:")) != -1)
+    {
+        switch(option)
+        {
+            case 's':
+                if(scenario_time(optarg, &stride))
+                {
+                    stats_usage(argv[0]);
+                }
+                break;
+            case 'b':
+                battery = strtoul(optarg, NULL, 0);
+                break;
+            case 'r':
+                raw = optarg;
+                break;
+            default:
+                stats_usage(argv[0]);
+        }
+    }
+
+    if(raw)
+    {
+        unsigned char eeprom[EEPROM_SIZE];
+        FILE *file;
+
+        if(optind != argc)
+        {
+            stats_usage(argv[0]);
+        }
+
+        if(!(file = fopen(raw, "rb")))
+        {
+            perror(raw);
+            return EXIT_FAILURE;
+        }
+
+        if(fread(eeprom, 1, sizeof(eeprom), file) != sizeof(eeprom))
+        {
+            fprintf(stderr, "%s: expected a raw EEPROM dump of %u bytes\n", raw, EEPROM_SIZE);
+            fclose(file);
+            return EXIT_FAILURE;
+        }
+        fclose(file);
+
+        printf("dump:           %s\n", raw);
+
+        return stats_print(eeprom) ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
+
+    if(optind != (argc - 1))
+    {
+        stats_usage(argv[0]);
+    }
+
+    host_init();
+    host->stride_ns = stride;
+    host->analog[BATTERY_CHANNEL] = battery;
+
+    if(scenario_load(argv[optind], &end, host_event_add) < 0)
+    {
+        return EXIT_FAILURE;
+    }
+
+    // Catches EEMEM variables of any module, the compile time check of main.c only knows its own
+    if(host->eeprom_size > STATS_OFFSET)
+    {
+        fprintf(stderr, "%s: EEMEM image (%u bytes) overlaps the record at 0x%04x\n", argv[0], host->eeprom_size, STATS_OFFSET);
+        return EXIT_FAILURE;
+    }
+
+    status = host_run(rcc_main);
+
+    printf("scenario:       %s\n", argv[optind]);
+    printf("result:         %s\n", (status == HOST_Exit_End) ? "completed" : "error");
+    printf("virtual time:   %.3f s\n", (double)host->time_ns / 1e9);
+    printf("boots:          %lu\n", host->boots);
+
+    if(stats_print(host->eeprom) || (status != HOST_Exit_End))
+    {
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}